@@ -19,7 +19,7 @@
 #
 # pairwise_aligner has the following optional dependencies:
 #
-# <optional library dependencies>
+#   ZLIB      -- zlib compression library, required for reading gzip and BGZF compressed sequence files
 #
 # Once the search has been performed, the following variables will be set.
 #
@@ -46,6 +46,12 @@
 #                                  target_compile_options(target $PAIRWISE_ALIGNER_CXX_FLAGS)
 #                              for a target.
 #
+#   seqan::pairwise_aligner::runtime -- static library with the precompiled kernels of the runtime aligner;
+#                              only defined when running from a repository checkout.
+#
+# Additionally, the executable target pairwise_aligner_app builds the command line application `pairwise_align`
+# when running from a repository checkout.
+#
 #   [IMPORTED]: https://cmake.org/cmake/help/v3.10/prop_tgt/IMPORTED.html#prop_tgt:IMPORTED
 #
 # ============================================================================
@@ -157,6 +163,37 @@ else ()
     config_error ("The required SeqAn3 library was marked as required, but wasn't found.")
 endif ()
 
+# ----------------------------------------------------------------------------
+# ZLIB dependency
+# ----------------------------------------------------------------------------
+
+# Reading gzip and BGZF compressed sequence files requires zlib.
+find_package (ZLIB QUIET)
+
+if (ZLIB_FOUND)
+    set (PAIRWISE_ALIGNER_LIBRARIES ${PAIRWISE_ALIGNER_LIBRARIES} ${ZLIB_LIBRARIES})
+    set (PAIRWISE_ALIGNER_DEPENDENCY_INCLUDE_DIRS ${PAIRWISE_ALIGNER_DEPENDENCY_INCLUDE_DIRS} ${ZLIB_INCLUDE_DIRS})
+    set (PAIRWISE_ALIGNER_DEFINITIONS ${PAIRWISE_ALIGNER_DEFINITIONS} "PAIRWISE_ALIGNER_HAS_ZLIB=1")
+    config_print ("Optional dependency:                 ZLIB-${ZLIB_VERSION_STRING} found.")
+else ()
+    config_print ("Optional dependency:                 ZLIB not found.")
+endif ()
+
+# ----------------------------------------------------------------------------
+# Tuning profile
+# ----------------------------------------------------------------------------
+
+# A host specific tuning profile, e.g. generated by the pairwise_aligner_tune target of the benchmarks.
+if (PAIRWISE_ALIGNER_TUNING_PROFILE)
+    if (EXISTS "${PAIRWISE_ALIGNER_TUNING_PROFILE}")
+        set (PAIRWISE_ALIGNER_DEFINITIONS ${PAIRWISE_ALIGNER_DEFINITIONS}
+                                          "PAIRWISE_ALIGNER_TUNING_PROFILE=\"${PAIRWISE_ALIGNER_TUNING_PROFILE}\"")
+        config_print ("Tuning profile:                      ${PAIRWISE_ALIGNER_TUNING_PROFILE}")
+    else ()
+        config_error ("The tuning profile ${PAIRWISE_ALIGNER_TUNING_PROFILE} does not exist.")
+    endif ()
+endif ()
+
 # ----------------------------------------------------------------------------
 # Export targets
 # ----------------------------------------------------------------------------
@@ -174,6 +211,27 @@ target_include_directories (pairwise_aligner INTERFACE "${PAIRWISE_ALIGNER_INCLU
 target_include_directories (pairwise_aligner SYSTEM INTERFACE "${PAIRWISE_ALIGNER_DEPENDENCY_INCLUDE_DIRS}")
 add_library (seqan::pairwise_aligner ALIAS pairwise_aligner)
 
+# The runtime aligner dispatches to kernels which are compiled once into a static library.
+# It is only available when running from a repository checkout, which contains the sources.
+find_path (PAIRWISE_ALIGNER_SOURCE_DIR NAMES pairwise_aligner/runtime/aligner.cpp HINTS "${PAIRWISE_ALIGNER_CLONE_DIR}/src")
+
+if (PAIRWISE_ALIGNER_SOURCE_DIR AND NOT TARGET pairwise_aligner_runtime)
+    config_print ("pairwise_aligner source dir found:    ${PAIRWISE_ALIGNER_SOURCE_DIR}")
+    file (GLOB PAIRWISE_ALIGNER_RUNTIME_SOURCES "${PAIRWISE_ALIGNER_SOURCE_DIR}/pairwise_aligner/runtime/*.cpp")
+    add_library (pairwise_aligner_runtime STATIC EXCLUDE_FROM_ALL ${PAIRWISE_ALIGNER_RUNTIME_SOURCES})
+    target_link_libraries (pairwise_aligner_runtime PUBLIC pairwise_aligner)
+    add_library (seqan::pairwise_aligner::runtime ALIAS pairwise_aligner_runtime)
+endif ()
+
+# The command line application aligning the sequences of FASTA and FASTQ files with the runtime aligner.
+if (TARGET pairwise_aligner_runtime AND NOT TARGET pairwise_aligner_app)
+    find_package (Threads REQUIRED)
+    file (GLOB PAIRWISE_ALIGNER_APP_SOURCES "${PAIRWISE_ALIGNER_SOURCE_DIR}/pairwise_aligner/app/*.cpp")
+    add_executable (pairwise_aligner_app EXCLUDE_FROM_ALL ${PAIRWISE_ALIGNER_APP_SOURCES})
+    set_target_properties (pairwise_aligner_app PROPERTIES OUTPUT_NAME pairwise_align)
+    target_link_libraries (pairwise_aligner_app PRIVATE pairwise_aligner_runtime Threads::Threads)
+endif ()
+
 # propagate PAIRWISE_ALIGNER_INCLUDE_DIR into PAIRWISE_ALIGNER_INCLUDE_DIRS
 set (PAIRWISE_ALIGNER_INCLUDE_DIRS ${PAIRWISE_ALIGNER_INCLUDE_DIR} ${PAIRWISE_ALIGNER_DEPENDENCY_INCLUDE_DIRS})
 
@@ -15,7 +15,10 @@
 #include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <limits>
 #include <ranges>
+#include <type_traits>
 #include <vector>
 
 #include <seqan3/utility/container/aligned_allocator.hpp>
@@ -75,9 +78,12 @@ public:
         assert(max_rank >= min_rank);
         _min_rank_offset = simd_from_t{min_rank};
         // For example DNA5 = {A, C, G, N, T} as char only requires range of size (84(T) - 65(A)) + 1 = 20.
-        scalar_from_t const max_rank_range = max_rank - min_rank + 1;
+        // The range is computed with a wider type, since an alphabet covering all 256 values of an 8-bit type would
+        // otherwise wrap around to 0.
+        std::ptrdiff_t const max_rank_range = static_cast<std::ptrdiff_t>(max_rank) - min_rank + 1;
 
-        assert(max_rank_range <= std::numeric_limits<scalar_from_t>::max());
+        using unsigned_scalar_from_t = std::make_unsigned_t<scalar_from_t>;
+        assert(max_rank_range <= static_cast<std::ptrdiff_t>(std::numeric_limits<unsigned_scalar_from_t>::max()) + 1);
 
         // Resize the map to hold all ranks.
         size_t const rank_width = (simd_from_t::size_v + max_rank_range - 1) / simd_from_t::size_v;
@@ -85,10 +91,10 @@ public:
         ranks.resize(rank_width, simd_from_t{static_cast<scalar_from_t>(-1)});
 
         // Fill rank map.
-        for (scalar_from_t rank = 0; rank < std::ranges::ssize(valid_symbols); ++rank) {
+        for (std::ptrdiff_t rank = 0; rank < std::ranges::ssize(valid_symbols); ++rank) {
             scalar_from_t key = static_cast<scalar_from_t>(valid_symbols[rank]);
             auto [index, position] = key_offset(key);
-            ranks[index][position] = rank;
+            ranks[index][position] = static_cast<scalar_from_t>(rank);
         }
 
         _rank_map_ptr = std::make_shared<rank_map_t>(simd_rank_selector_t::initialise_rank_map(std::move(ranks)));
@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::cfg::array_of_structures and
+ *        seqan::pairwise_aligner::cfg::structure_of_arrays.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <concepts>
+
+#include <pairwise_aligner/matrix/dp_vector_single.hpp>
+#include <pairwise_aligner/matrix/dp_vector_single_soa.hpp>
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace cfg {
+
+//!\brief Stores the cells of the dp vectors interleaved; the default layout.
+struct array_of_structures
+{
+    template <typename dp_cell_t>
+    using dp_vector_type = dp_vector_single<dp_cell_t>;
+};
+
+//!\brief Stores every value of the cells of the dp vectors in a separate array.
+struct structure_of_arrays
+{
+    template <typename dp_cell_t>
+    using dp_vector_type = dp_vector_single_soa<dp_cell_t>;
+};
+
+//!\brief Selects the memory layout of the dp vectors of the simd score models.
+template <typename layout_t>
+concept dp_vector_layout = std::same_as<layout_t, array_of_structures> || std::same_as<layout_t, structure_of_arrays>;
+
+} // namespace cfg
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
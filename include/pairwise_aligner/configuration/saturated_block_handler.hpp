@@ -12,8 +12,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+#include <pairwise_aligner/utility/tuning_profile.hpp>
 
 namespace seqan::pairwise_aligner {
 inline namespace v1
@@ -33,6 +40,11 @@ public:
         return std::numeric_limits<int8_t>::lowest() - gap_open - (2 * gap_extension);
     }
 
+    // Computes the block size and the zero offset of the saturated blocks for the given scores.
+    // The larger of the block sizes for blocks with only gaps and with only mismatches is chosen together with its
+    // zero offset and then limited by the tuning profile.
+    // The size is fixed for the worst case of the scores and not adapted to the scores seen in a block, as the values
+    // of a block are only rebased before it is computed; no cell detects a saturated value in the block itself.
     template <typename score_t, typename gap_score_t>
     static constexpr auto compute_max_block_size(score_t const match,
                                                  score_t const mismatch,
@@ -51,9 +63,38 @@ public:
         size_t max_block_size = (block_size_gap < block_size_mismatch)
                               ? (zero_offset = zero_offset_mismatch, block_size_mismatch)
                               : (zero_offset = zero_offset_gap, block_size_gap);
+        // Smaller blocks stay within the value range for the same zero offset, such that the tuned limit is safe.
+        max_block_size = std::min(max_block_size, tuning::profile::saturated_block_size_limit);
         return std::pair{zero_offset, max_block_size};
     }
 
+    // Checks whether saturated blocks of at least the given size are computed for these scores.
+    // The viability is derived from the block size chosen by compute_max_block_size, such that it matches the blocks
+    // the saturated configurations actually use.
+    template <typename score_t, typename gap_score_t>
+    static constexpr bool is_viable_block_size(score_t const match,
+                                               score_t const mismatch,
+                                               gap_score_t const gap_open,
+                                               gap_score_t const gap_extension,
+                                               size_t const block_size) noexcept
+    {
+        if (match <= 0)
+            return false;
+
+        auto [zero_offset, max_block_size] = compute_max_block_size(match, mismatch, gap_open, gap_extension);
+        return block_size <= max_block_size;
+    }
+
+    // Checks whether the saturated NxN score model supports an alphabet of the given size.
+    // The offsets into the triangular score matrix, which includes the padding symbol, are addressed by 8-bit indices.
+    // Larger alphabets are only supported if the tuning profile enables to gather their scores by rank.
+    static constexpr bool is_NxN_alphabet_supported(size_t const symbol_count) noexcept
+    {
+        size_t const dimension = symbol_count + 1;
+        return (dimension * (dimension + 1)) / 2 <= std::numeric_limits<uint8_t>::max() + 1 ||
+               tuning::profile::saturated_NxN_gather_by_rank;
+    }
+
 private:
     static constexpr auto max_block_size_with_gaps(float const match,
                                                    float const gap_open,
@@ -77,9 +118,12 @@ private:
         float const block_divisor = match + gap_extension;
         float const block_scale = 2 * gap_extension / block_divisor;
 
-        int8_t const zero_offset = std::ceil((min_score + 2 * gap_open + (block_scale * upper_score_limit)) /
-                                             (1 + block_scale));
-        size_t const block_size = std::floor((upper_score_limit - zero_offset) / block_divisor);
+        int8_t const zero_offset = std::clamp(std::ceil((min_score + 2 * gap_open + (block_scale * upper_score_limit)) /
+                                                        (1 + block_scale)),
+                                              min_score,
+                                              max_score);
+        // Large gap scores admit no block at all.
+        size_t const block_size = std::max(0.0f, std::floor((upper_score_limit - zero_offset) / block_divisor));
 
         return std::pair{block_size, zero_offset};
     }
@@ -102,7 +146,7 @@ private:
         float const block_scale = mismatch / (match + mismatch);
 
         int8_t const zero_offset = std::ceil((min_score + max_score * block_scale) / (1 + block_scale));
-        size_t const block_size = std::floor((max_score - zero_offset) / (match + mismatch));
+        size_t const block_size = std::max(0.0f, std::floor((max_score - zero_offset) / (match + mismatch)));
 
         return std::pair{block_size, zero_offset};
     }
@@ -38,9 +38,11 @@
 #include <pairwise_aligner/matrix/dp_vector_single.hpp>
 
 #include <pairwise_aligner/score_model/score_model_matrix_simd_1xN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
 #include <pairwise_aligner/tracker/tracker_global_simd_fixed.hpp>
 #include <pairwise_aligner/tracker/tracker_local_simd_fixed.hpp>
 #include <pairwise_aligner/type_traits.hpp>
+#include <pairwise_aligner/utility/static_value.hpp>
 #include <pairwise_aligner/utility/type_list.hpp>
 #include <pairwise_aligner/simd/simd_score_type.hpp>
 
@@ -73,8 +75,8 @@ struct traits
     using score_type = simd_score<score_t, index_type::size_v>;
 
     substitution_matrix_t _substitution_matrix;
-    score_t _match_padding_score{1};
-    score_t _mismatch_padding_score{-1};
+    score_t _match_padding_score{pairwise_aligner::detail::default_match_padding_score};
+    score_t _mismatch_padding_score{pairwise_aligner::detail::default_mismatch_padding_score};
 
     template <bool is_local>
     using score_model_type = std::conditional_t<is_local,
@@ -95,19 +97,30 @@ struct traits
     template <typename configuration_t>
     constexpr auto configure_substitution_policy([[maybe_unused]] configuration_t const & configuration) const noexcept
     {
-        // TODO: Run this mode!
-        std::array<std::array<score_t, dimension_v>, dimension_v> tmp{};
-
-        std::ranges::for_each(std::views::iota(size_t(0), dimension_v), [&] (size_t const i)
+        auto make_score_model = [&] ()
         {
-            tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
-            // Overwrite the other values with data from the original substitution matrix.
-            if (i < (dimension_v - 1))
-                std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
-        });
-
-        // We need to select the profile!
-        return score_model_type<configuration_t::is_local>{tmp};
+            // TODO: Run this mode!
+            std::array<std::array<score_t, dimension_v>, dimension_v> tmp{};
+
+            std::ranges::for_each(std::views::iota(size_t(0), dimension_v), [&] (size_t const i)
+            {
+                tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
+                // Overwrite the other values with data from the original substitution matrix.
+                if (i < (dimension_v - 1))
+                    std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
+            });
+
+            // We need to select the profile!
+            return score_model_type<configuration_t::is_local>{tmp};
+        };
+
+        // The tables derived from the built-in substitution matrices are built only once and shared by all aligners.
+        if (pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                          _match_padding_score,
+                                                          _mismatch_padding_score))
+            return pairwise_aligner::detail::static_value(make_score_model);
+
+        return make_score_model();
     }
 
     template <typename configuration_t>
@@ -132,12 +145,23 @@ struct traits
         // TODO: Find some unused values between ranks/symbols!
         assert(static_cast<uint8_t>(_substitution_matrix.back().first) < 255);
         int8_t const padding_symbol = (static_cast<int8_t>(_substitution_matrix.back().first) + 1);
-        std::string extended_symbol_list{};
-        extended_symbol_list.resize(dimension_v, padding_symbol);
-        std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
 
-        // Initialise the scale for the column sequence map.
-        alphabet_rank_map_simd<index_type> rank_map{std::move(extended_symbol_list)};
+        auto make_rank_map = [&] ()
+        {
+            std::string extended_symbol_list{};
+            extended_symbol_list.resize(dimension_v, padding_symbol);
+            std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
+
+            // Initialise the scale for the column sequence map.
+            return alphabet_rank_map_simd<index_type>{std::move(extended_symbol_list)};
+        };
+
+        bool const builtin_tables = pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                                                 _match_padding_score,
+                                                                                 _mismatch_padding_score);
+        alphabet_rank_map_simd<index_type> rank_map = builtin_tables ?
+                                                      pairwise_aligner::detail::static_value(make_rank_map) :
+                                                      make_rank_map();
 
         return dp_vector_policy{
                     dp_vector_rank_transformation_factory(
@@ -18,6 +18,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <pairwise_aligner/configuration/dp_vector_layout.hpp>
 #include <pairwise_aligner/configuration/initial.hpp>
 #include <pairwise_aligner/configuration/rule_score_model.hpp>
 #include <pairwise_aligner/alphabet_conversion/alphabet_rank_map_simd.hpp>
@@ -35,9 +36,11 @@
 #include <pairwise_aligner/matrix/dp_vector_rank_transformation.hpp>
 #include <pairwise_aligner/matrix/dp_vector_single.hpp>
 #include <pairwise_aligner/score_model/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
 #include <pairwise_aligner/tracker/tracker_global_simd_fixed.hpp>
 #include <pairwise_aligner/tracker/tracker_local_simd_fixed.hpp>
 #include <pairwise_aligner/type_traits.hpp>
+#include <pairwise_aligner/utility/static_value.hpp>
 #include <pairwise_aligner/utility/type_list.hpp>
 #include <pairwise_aligner/simd/simd_score_type.hpp>
 
@@ -52,7 +55,7 @@ namespace _score_model_matrix_simd_NxN
 // ----------------------------------------------------------------------------
 // traits
 // ----------------------------------------------------------------------------
-template <typename substitution_matrix_t>
+template <typename substitution_matrix_t, dp_vector_layout dp_vector_layout_t = array_of_structures>
 struct traits
 {
     static constexpr cfg::detail::rule_category category = cfg::detail::rule_category::score_model;
@@ -72,11 +75,15 @@ struct traits
                   "The sizes of the index and score simd vector must not differ.");
 
     substitution_matrix_t _substitution_matrix;
-    scalar_score_t _match_padding_score{1};
-    scalar_score_t _mismatch_padding_score{-1};
+    scalar_score_t _match_padding_score{pairwise_aligner::detail::default_match_padding_score};
+    scalar_score_t _mismatch_padding_score{pairwise_aligner::detail::default_mismatch_padding_score};
 
     using score_model_type = score_model_matrix_simd_NxN<score_type, index_type, dimension>;
 
+    // The innermost dp vector, which determines the memory layout of the cells.
+    template <typename dp_cell_t>
+    using dp_vector_single_type = typename dp_vector_layout_t::template dp_vector_type<dp_cell_t>;
+
     template <typename dp_vector_t>
     using dp_vector_column_type = dp_vector_bulk<dp_vector_t, score_type>;
 
@@ -91,17 +98,28 @@ struct traits
     template <typename configuration_t>
     constexpr auto configure_substitution_policy([[maybe_unused]] configuration_t const & configuration) const noexcept
     {
-        std::array<std::array<scalar_score_t, dimension>, dimension> tmp{};
-
-        std::ranges::for_each(std::views::iota(size_t(0), dimension), [&] (size_t const i)
+        auto make_score_model = [&] ()
         {
-            tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
-            // Overwrite the other values with data from the original substitution matrix.
-            if (i < (dimension - 1))
-                std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
-        });
+            std::array<std::array<scalar_score_t, dimension>, dimension> tmp{};
+
+            std::ranges::for_each(std::views::iota(size_t(0), dimension), [&] (size_t const i)
+            {
+                tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
+                // Overwrite the other values with data from the original substitution matrix.
+                if (i < (dimension - 1))
+                    std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
+            });
+
+            return score_model_type{tmp};
+        };
 
-        return score_model_type{tmp};
+        // The tables derived from the built-in substitution matrices are built only once and shared by all aligners.
+        if (pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                          _match_padding_score,
+                                                          _mismatch_padding_score))
+            return pairwise_aligner::detail::static_value(make_score_model);
+
+        return make_score_model();
     }
 
     template <typename configuration_t>
@@ -127,25 +145,36 @@ struct traits
         using scalar_rank_t = typename index_type::value_type;
         assert(static_cast<scalar_rank_t>(_substitution_matrix.back().first) < 255);
         scalar_rank_t const padding_symbol = _substitution_matrix.back().first + 1;
-        std::vector<scalar_rank_t> extended_symbol_list{};
-        extended_symbol_list.resize(dimension, padding_symbol);
-        std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
 
-        // Initialise the scale for the column sequence map.
-        alphabet_rank_map_simd<index_type> rank_map{std::move(extended_symbol_list)};
+        auto make_rank_map = [&] ()
+        {
+            std::vector<scalar_rank_t> extended_symbol_list{};
+            extended_symbol_list.resize(dimension, padding_symbol);
+            std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
+
+            // Initialise the scale for the column sequence map.
+            return alphabet_rank_map_simd<index_type>{std::move(extended_symbol_list)};
+        };
+
+        bool const builtin_tables = pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                                                 _match_padding_score,
+                                                                                 _mismatch_padding_score);
+        alphabet_rank_map_simd<index_type> rank_map = builtin_tables ?
+                                                      pairwise_aligner::detail::static_value(make_rank_map) :
+                                                      make_rank_map();
 
         return dp_vector_policy{
                     dp_vector_bulk_factory(
                         dp_vector_rank_transformation_factory(
                             dp_vector_offset_transformation(
-                                dp_vector_chunk_factory(dp_vector_single<column_cell_t>{}),
+                                dp_vector_chunk_factory(dp_vector_single_type<column_cell_t>{}),
                                 offset_transform{dimension, matrix_size}
                             ), rank_map
                         ), index_type{padding_symbol}),
                     dp_vector_bulk_factory(
                         dp_vector_rank_transformation_factory(
                             dp_vector_offset_transformation(
-                                dp_vector_chunk_factory(dp_vector_single<row_cell_t>{}),
+                                dp_vector_chunk_factory(dp_vector_single_type<row_cell_t>{}),
                                 offset_transform{dimension, matrix_size}
                             ), rank_map
                         ), index_type{padding_symbol})
@@ -248,24 +277,33 @@ namespace _cpo
 {
 struct _fn
 {
-    template <typename predecessor_t, typename alphabet_t, typename score_t, size_t dimension>
+    template <typename predecessor_t,
+              typename alphabet_t,
+              typename score_t,
+              size_t dimension,
+              dp_vector_layout dp_vector_layout_t = array_of_structures>
     constexpr auto operator()(predecessor_t && predecessor,
                               std::array<std::pair<alphabet_t, std::array<score_t, dimension>>, dimension>
-                                    substitution_matrix) const
+                                    substitution_matrix,
+                              dp_vector_layout_t const & = {}) const
     {
         using substitution_matrix_t = std::array<std::pair<alphabet_t, std::array<score_t, dimension>>, dimension>;
 
-        using traits_t = _score_model_matrix_simd_NxN::traits<substitution_matrix_t>;
+        using traits_t = _score_model_matrix_simd_NxN::traits<substitution_matrix_t, dp_vector_layout_t>;
         using rule_t = _score_model_matrix_simd_NxN::rule<predecessor_t, traits_t>;
         return rule_t{{}, std::forward<predecessor_t>(predecessor), traits_t{std::move(substitution_matrix)}};
     }
 
-    template <typename alphabet_t, typename score_t, size_t dimension>
+    template <typename alphabet_t,
+              typename score_t,
+              size_t dimension,
+              dp_vector_layout dp_vector_layout_t = array_of_structures>
     constexpr auto operator()(std::array<std::pair<alphabet_t, std::array<score_t, dimension>>, dimension> const &
-                                substitution_matrix)
+                                substitution_matrix,
+                              dp_vector_layout_t const & layout = {})
         const
     {
-        return this->operator()(cfg::initial, substitution_matrix);
+        return this->operator()(cfg::initial, substitution_matrix, layout);
     }
 };
 
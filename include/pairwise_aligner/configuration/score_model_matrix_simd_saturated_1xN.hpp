@@ -39,9 +39,12 @@
 #include <pairwise_aligner/matrix/dp_vector_single.hpp>
 
 #include <pairwise_aligner/score_model/score_model_matrix_simd_1xN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
 #include <pairwise_aligner/tracker/tracker_global_simd_saturated.hpp>
 #include <pairwise_aligner/tracker/tracker_local_simd_saturated.hpp>
 #include <pairwise_aligner/type_traits.hpp>
+#include <pairwise_aligner/utility/static_value.hpp>
+#include <pairwise_aligner/utility/tuning_profile.hpp>
 #include <pairwise_aligner/utility/type_list.hpp>
 #include <pairwise_aligner/simd/simd_score_type.hpp>
 
@@ -64,7 +67,7 @@ struct traits
 
     // extend the dimension to handle padding symbol.
     static constexpr size_t dimension = std::tuple_size_v<substitution_matrix_t> + 1;
-    static constexpr size_t lane_width = 8;
+    static constexpr size_t lane_width = tuning::profile::lane_width;
 
     using matrix_row_t = typename substitution_matrix_t::value_type;
     using symbol_t = std::tuple_element_t<0, matrix_row_t>;
@@ -78,10 +81,10 @@ struct traits
     using original_score_type = simd_score<score_t, score_type::size_v>;
 
     substitution_matrix_t _substitution_matrix;
-    score_t _match_padding_score{1};
-    score_t _mismatch_padding_score{-1};
+    score_t _match_padding_score{pairwise_aligner::detail::default_match_padding_score};
+    score_t _mismatch_padding_score{pairwise_aligner::detail::default_mismatch_padding_score};
 
-    using score_model_type = score_model_matrix_simd_1xN<score_type, dimension>;
+    using score_model_type = seqan::pairwise_aligner::score_model_matrix_simd_1xN<score_type, dimension>;
 
     template <typename cell_t>
     using buffer_t = std::vector<cell_t, seqan3::aligned_allocator<cell_t, alignof(cell_t)>>;
@@ -95,48 +98,46 @@ struct traits
     template <typename configuration_t>
     constexpr auto configure_substitution_policy([[maybe_unused]] configuration_t const & configuration) const noexcept
     {
-        // TODO: Run this mode!
-        std::array<std::array<score_t, dimension>, dimension> tmp{};
-
-        std::ranges::for_each(std::views::iota(size_t(0), dimension), [&] (size_t const i)
+        auto make_score_model = [&] ()
         {
-            tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
-            // Overwrite the other values with data from the original substitution matrix.
-            if (i < (dimension - 1))
-                std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
-        });
+            // TODO: Run this mode!
+            std::array<std::array<score_t, dimension>, dimension> tmp{};
+
+            std::ranges::for_each(std::views::iota(size_t(0), dimension), [&] (size_t const i)
+            {
+                tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
+                // Overwrite the other values with data from the original substitution matrix.
+                if (i < (dimension - 1))
+                    std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
+            });
+
+            return score_model_type{tmp};
+        };
 
         // We need to select the profile!
+        // The zero depends on the gap scores and is set on a copy of the shared score model.
         int8_t local_zero = block_handler_t::lowest_viable_local_score(configuration._gap_open_score,
                                                                        configuration._gap_extension_score);
-        return score_model_type{tmp, static_cast<score_type>(local_zero)};
+        // The tables derived from the built-in substitution matrices are built only once and shared by all aligners.
+        if (pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                          _match_padding_score,
+                                                          _mismatch_padding_score))
+            return score_model_type{pairwise_aligner::detail::static_value(make_score_model),
+                                    static_cast<score_type>(local_zero)};
+
+        return score_model_type{make_score_model(), static_cast<score_type>(local_zero)};
     }
 
     template <typename configuration_t>
     constexpr auto configure_result_factory_policy([[maybe_unused]] configuration_t const & configuration)
         const noexcept
     {
-        score_t max_match_score = std::numeric_limits<score_t>::lowest();
-        score_t min_mismatch_score = std::numeric_limits<score_t>::max();
-        std::ranges::for_each(_substitution_matrix | std::views::elements<1>, [&] (auto const & matrix_row) {
-            auto [local_min, local_max] = std::ranges::minmax(matrix_row);
-            min_mismatch_score = std::min(local_min, min_mismatch_score);
-            max_match_score = std::max(local_max, max_match_score);
-        });
-
-        auto [global_zero, max_block_size] =
-            block_handler_t::compute_max_block_size(max_match_score,
-                                                    min_mismatch_score,
-                                                    configuration._gap_open_score,
-                                                    configuration._gap_extension_score);
-
         if constexpr (configuration_t::is_local) {
             return tracker::local_simd_saturated::factory<score_type, original_score_type>{};
         } else {
             return tracker::global_simd_saturated::factory<original_score_type>{
                 static_cast<original_score_type>(_match_padding_score),
-                configuration.trailing_gap_setting(),
-                max_block_size
+                configuration.trailing_gap_setting()
             };
         }
     }
@@ -168,12 +169,23 @@ struct traits
         // TODO: Find some unused values between ranks/symbols!
         assert(static_cast<uint8_t>(_substitution_matrix.back().first) < 255);
         int8_t const padding_symbol = (static_cast<int8_t>(_substitution_matrix.back().first) + 1);
-        std::string extended_symbol_list{};
-        extended_symbol_list.resize(dimension, padding_symbol);
-        std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
 
-        // Initialise the scale for the column sequence map.
-        alphabet_rank_map_simd<index_type> rank_map{std::move(extended_symbol_list)};
+        auto make_rank_map = [&] ()
+        {
+            std::string extended_symbol_list{};
+            extended_symbol_list.resize(dimension, padding_symbol);
+            std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
+
+            // Initialise the scale for the column sequence map.
+            return alphabet_rank_map_simd<index_type>{std::move(extended_symbol_list)};
+        };
+
+        bool const builtin_tables = pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                                                 _match_padding_score,
+                                                                                 _mismatch_padding_score);
+        alphabet_rank_map_simd<index_type> rank_map = builtin_tables ?
+                                                      pairwise_aligner::detail::static_value(make_rank_map) :
+                                                      make_rank_map();
 
         auto saturated_vector = [&] (auto original_cell_type, auto && base_vector)
         {
@@ -255,12 +267,12 @@ struct traits
 
         using algorithm_t = typename configuration_t::algorithm_type<dp_algorithm_template_standard,
                                                                      dp_matrix_policy_t,
-                                                                     lane_width_policy<>,
+                                                                     lane_width_policy<lane_width>,
                                                                      std::remove_cvref_t<policies_t>...>;
 
         return interface_one_to_many_bulk<algorithm_t, score_type::size_v>{
                 algorithm_t{dp_matrix_policy_t{make_dp_matrix_policy()},
-                                               lane_width_policy<>{},
+                                               lane_width_policy<lane_width>{},
                                                std::move(policies)...}};
     }
 };
@@ -13,11 +13,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <limits>
 #include <ranges>
 #include <type_traits>
 #include <utility>
 
+#include <pairwise_aligner/configuration/dp_vector_layout.hpp>
 #include <pairwise_aligner/configuration/initial.hpp>
 #include <pairwise_aligner/configuration/rule_score_model.hpp>
 #include <pairwise_aligner/configuration/saturated_block_handler.hpp>
@@ -41,10 +44,14 @@
 #include <pairwise_aligner/matrix/dp_vector_saturated.hpp>
 #include <pairwise_aligner/matrix/dp_vector_single.hpp>
 
+#include <pairwise_aligner/score_model/score_model_matrix_simd_gather_NxN.hpp>
 #include <pairwise_aligner/score_model/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
 #include <pairwise_aligner/tracker/tracker_global_simd_saturated.hpp>
 #include <pairwise_aligner/tracker/tracker_local_simd_saturated.hpp>
 #include <pairwise_aligner/type_traits.hpp>
+#include <pairwise_aligner/utility/static_value.hpp>
+#include <pairwise_aligner/utility/tuning_profile.hpp>
 #include <pairwise_aligner/utility/type_list.hpp>
 #include <pairwise_aligner/simd/simd_score_type.hpp>
 
@@ -60,7 +67,7 @@ namespace _score_model_matrix_simd_saturated_NxN
 // traits
 // ----------------------------------------------------------------------------
 
-template <typename substitution_matrix_t>
+template <typename substitution_matrix_t, dp_vector_layout dp_vector_layout_t = array_of_structures>
 struct traits
 {
     static constexpr cfg::detail::rule_category category = cfg::detail::rule_category::score_model;
@@ -68,7 +75,7 @@ struct traits
     // extend the dimension to handle padding symbol.
     static constexpr size_t dimension = std::tuple_size_v<substitution_matrix_t> + 1;
     static constexpr size_t matrix_size = (dimension * (dimension + 1)) / 2;
-    static constexpr size_t lane_width = 8;
+    static constexpr size_t lane_width = tuning::profile::saturated_NxN_lane_width;
 
     using matrix_row_t = typename substitution_matrix_t::value_type;
     using symbol_t = std::tuple_element_t<0, matrix_row_t>;
@@ -82,14 +89,32 @@ struct traits
     using original_score_type = simd_score<score_t, score_type::size_v>;
 
     substitution_matrix_t _substitution_matrix;
-    score_t _match_padding_score{1};
-    score_t _mismatch_padding_score{-1};
+    score_t _match_padding_score{pairwise_aligner::detail::default_match_padding_score};
+    score_t _mismatch_padding_score{pairwise_aligner::detail::default_mismatch_padding_score};
 
-    using score_model_type = score_model_matrix_simd_NxN<score_type, index_type, dimension>;
+    static_assert(dimension <= std::numeric_limits<uint8_t>::max() + 1,
+                  "The alphabet including the padding symbol must not exceed 256 symbols.");
+
+    // The offsets into the triangular matrix can not be addressed with 8-bit indices anymore.
+    // In this case the scores are gathered by the ranks from the full matrix.
+    static constexpr bool gather_by_rank = matrix_size > std::numeric_limits<uint8_t>::max() + 1;
+
+    static_assert(block_handler_t::is_NxN_alphabet_supported(dimension - 1),
+                  "Gathering the scores of large alphabets must be enabled by the tuning profile, as it is not native "
+                  "on this target. Use the score_model_matrix_simd_NxN instead.");
+
+    using score_model_type =
+        std::conditional_t<gather_by_rank,
+                           seqan::pairwise_aligner::score_model_matrix_simd_gather_NxN<score_type, index_type, dimension>,
+                           seqan::pairwise_aligner::score_model_matrix_simd_NxN<score_type, index_type, dimension>>;
 
     template <typename cell_t>
     using buffer_t = std::vector<cell_t, seqan3::aligned_allocator<cell_t, alignof(cell_t)>>;
 
+    // The innermost dp vector, which determines the memory layout of the cells.
+    template <typename dp_cell_t>
+    using dp_vector_single_type = typename dp_vector_layout_t::template dp_vector_type<dp_cell_t>;
+
     template <typename dp_vector_t>
     using dp_vector_column_type = dp_vector_bulk<dp_vector_t, score_type>;
 
@@ -99,44 +124,41 @@ struct traits
     template <typename configuration_t>
     constexpr auto configure_substitution_policy([[maybe_unused]] configuration_t const & configuration) const noexcept
     {
-        // TODO: Run this mode!
-        std::array<std::array<score_t, dimension>, dimension> tmp{};
-
-        std::ranges::for_each(std::views::iota(size_t(0), dimension), [&] (size_t const i)
+        auto make_score_model = [&] ()
         {
-            tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
-            // Overwrite the other values with data from the original substitution matrix.
-            if (i < (dimension - 1))
-                std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
-        });
+            // TODO: Run this mode!
+            std::array<std::array<score_t, dimension>, dimension> tmp{};
+
+            std::ranges::for_each(std::views::iota(size_t(0), dimension), [&] (size_t const i)
+            {
+                tmp[i].fill((configuration_t::is_local ? _mismatch_padding_score : _match_padding_score));
+                // Overwrite the other values with data from the original substitution matrix.
+                if (i < (dimension - 1))
+                    std::ranges::copy(_substitution_matrix[i].second, tmp[i].data());
+            });
+
+            return score_model_type{tmp};
+        };
+
+        // The tables derived from the built-in substitution matrices are built only once and shared by all aligners.
+        if (pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                          _match_padding_score,
+                                                          _mismatch_padding_score))
+            return pairwise_aligner::detail::static_value(make_score_model);
 
-        return score_model_type{tmp};
+        return make_score_model();
     }
 
     template <typename configuration_t>
     constexpr auto configure_result_factory_policy([[maybe_unused]] configuration_t const & configuration)
         const noexcept
     {
-        score_t max_match_score = std::numeric_limits<score_t>::lowest();
-        score_t min_mismatch_score = std::numeric_limits<score_t>::max();
-        std::ranges::for_each(_substitution_matrix | std::views::elements<1>, [&] (auto const & matrix_row) {
-            auto [local_min, local_max] = std::ranges::minmax(matrix_row);
-            min_mismatch_score = std::min(local_min, min_mismatch_score);
-            max_match_score = std::max(local_max, max_match_score);
-        });
-
-        auto [global_zero, max_block_size] =
-            block_handler_t::compute_max_block_size(max_match_score,
-                                                    min_mismatch_score,
-                                                    configuration._gap_open_score,
-                                                    configuration._gap_extension_score);
         if constexpr (configuration_t::is_local) {
             return tracker::local_simd_saturated::factory<score_type, original_score_type>{};
         } else {
             return tracker::global_simd_saturated::factory<original_score_type>{
                 static_cast<original_score_type>(_match_padding_score),
-                configuration.trailing_gap_setting(),
-                max_block_size
+                configuration.trailing_gap_setting()
             };
         }
     }
@@ -163,19 +185,25 @@ struct traits
                                                     min_mismatch_score,
                                                     configuration._gap_open_score,
                                                     configuration._gap_extension_score);
-        // Add padding symbol: Assuming the symbols are sorted lexicographically, take the last symbol plus one
-        // (only char?).
-        // TODO: Find some unused values between ranks/symbols!
-        assert(static_cast<uint8_t>(_substitution_matrix.back().first) < 255);
         using scalar_rank_t = typename index_type::value_type;
-        assert(static_cast<scalar_rank_t>(_substitution_matrix.back().first) < 255);
-        scalar_rank_t const padding_symbol = _substitution_matrix.back().first + 1;
-        std::vector<scalar_rank_t> extended_symbol_list{};
-        extended_symbol_list.resize(dimension, padding_symbol);
-        std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
+        scalar_rank_t const padding_symbol = select_padding_symbol();
+
+        auto make_rank_map = [&] ()
+        {
+            std::vector<scalar_rank_t> extended_symbol_list{};
+            extended_symbol_list.resize(dimension, padding_symbol);
+            std::ranges::copy(_substitution_matrix | std::views::elements<0>, extended_symbol_list.begin());
+
+            // Initialise the scale for the column sequence map.
+            return alphabet_rank_map_simd<index_type>{std::move(extended_symbol_list)};
+        };
 
-        // Initialise the scale for the column sequence map.
-        alphabet_rank_map_simd<index_type> rank_map{std::move(extended_symbol_list)};
+        bool const builtin_tables = pairwise_aligner::detail::uses_builtin_tables(_substitution_matrix,
+                                                                                 _match_padding_score,
+                                                                                 _mismatch_padding_score);
+        alphabet_rank_map_simd<index_type> rank_map = builtin_tables ?
+                                                      pairwise_aligner::detail::static_value(make_rank_map) :
+                                                      make_rank_map();
 
         auto saturated_vector = [&] (auto original_cell_type, auto && base_vector)
         {
@@ -195,30 +223,58 @@ struct traits
             }
         };
 
+        auto offset_vector = [&] (auto && base_vector)
+        {
+            using base_vector_t = decltype(base_vector);
+            if constexpr (gather_by_rank)
+                return std::forward<base_vector_t>(base_vector);
+            else
+                return dp_vector_offset_transformation(std::forward<base_vector_t>(base_vector),
+                                                       offset_transform{dimension, matrix_size});
+        };
+
         return dp_vector_policy{
                     dp_vector_bulk_factory(
                         dp_vector_rank_transformation_factory(
-                            dp_vector_offset_transformation(
+                            offset_vector(
                                 dp_vector_chunk_factory(
                                     saturated_vector(std::type_identity<original_column_cell_t>{},
-                                                     dp_vector_single<column_cell_t>{}),
-                                    max_block_size),
-                                offset_transform{dimension, matrix_size}),
+                                                     dp_vector_single_type<column_cell_t>{}),
+                                    max_block_size)),
                             rank_map),
                         index_type{padding_symbol}),
                     dp_vector_bulk_factory(
                         dp_vector_rank_transformation_factory(
-                            dp_vector_offset_transformation(
+                            offset_vector(
                                 dp_vector_chunk_factory(
                                     saturated_vector(std::type_identity<original_row_cell_t>{},
-                                                     dp_vector_single<row_cell_t>{}),
-                                    max_block_size),
-                                offset_transform{dimension, matrix_size}),
+                                                     dp_vector_single_type<row_cell_t>{}),
+                                    max_block_size)),
                             rank_map),
                         index_type{padding_symbol})
         };
     }
 
+    // Selects a symbol that is not part of the alphabet to pad the sequences, preferably the one following the last
+    // symbol, which keeps the value range of the rank map as small as possible.
+    constexpr auto select_padding_symbol() const noexcept
+    {
+        using scalar_rank_t = typename index_type::value_type;
+        constexpr size_t symbol_count = std::numeric_limits<scalar_rank_t>::max() + 1;
+
+        std::array<bool, symbol_count> is_used{};
+        std::ranges::for_each(_substitution_matrix | std::views::elements<0>, [&] (auto const & symbol) {
+            is_used[static_cast<scalar_rank_t>(symbol)] = true;
+        });
+
+        size_t padding_symbol = static_cast<scalar_rank_t>(_substitution_matrix.back().first);
+        do {
+            padding_symbol = (padding_symbol + 1) % symbol_count;
+        } while (is_used[padding_symbol]);
+
+        return static_cast<scalar_rank_t>(padding_symbol);
+    }
+
     template <typename configuration_t, typename ...policies_t>
     constexpr auto configure_algorithm(configuration_t const &, policies_t && ...policies) const noexcept
     {
@@ -238,12 +294,12 @@ struct traits
         using dp_matrix_policy_t = dp_matrix_policies<std::invoke_result_t<decltype(make_dp_matrix_policy)>>;
         using algorithm_t = typename configuration_t::algorithm_type<dp_algorithm_template_standard,
                                                                      dp_matrix_policy_t,
-                                                                     lane_width_policy<4>,
+                                                                     lane_width_policy<lane_width>,
                                                                      std::remove_cvref_t<policies_t>...>;
 
         return interface_one_to_one_bulk<algorithm_t, score_type::size_v>{
                 algorithm_t{dp_matrix_policy_t{make_dp_matrix_policy()},
-                            lane_width_policy<4>{},
+                            lane_width_policy<lane_width>{},
                             std::move(policies)...}};
     }
 };
@@ -318,24 +374,33 @@ namespace _cpo
 {
 struct _fn
 {
-    template <typename predecessor_t, typename alphabet_t, typename score_t, size_t dimension>
+    template <typename predecessor_t,
+              typename alphabet_t,
+              typename score_t,
+              size_t dimension,
+              dp_vector_layout dp_vector_layout_t = array_of_structures>
     constexpr auto operator()(predecessor_t && predecessor,
                               std::array<std::pair<alphabet_t, std::array<score_t, dimension>>, dimension>
-                                    substitution_matrix) const
+                                    substitution_matrix,
+                              dp_vector_layout_t const & = {}) const
     {
         using substitution_matrix_t = std::array<std::pair<alphabet_t, std::array<score_t, dimension>>, dimension>;
 
-        using traits_t = _score_model_matrix_simd_saturated_NxN::traits<substitution_matrix_t>;
+        using traits_t = _score_model_matrix_simd_saturated_NxN::traits<substitution_matrix_t, dp_vector_layout_t>;
         using rule_t = _score_model_matrix_simd_saturated_NxN::rule<predecessor_t, traits_t>;
         return rule_t{{}, std::forward<predecessor_t>(predecessor), traits_t{std::move(substitution_matrix)}};
     }
 
-    template <typename alphabet_t, typename score_t, size_t dimension>
+    template <typename alphabet_t,
+              typename score_t,
+              size_t dimension,
+              dp_vector_layout dp_vector_layout_t = array_of_structures>
     constexpr auto operator()(std::array<std::pair<alphabet_t, std::array<score_t, dimension>>, dimension> const &
-                                substitution_matrix)
+                                substitution_matrix,
+                              dp_vector_layout_t const & layout = {})
         const
     {
-        return this->operator()(cfg::initial, substitution_matrix);
+        return this->operator()(cfg::initial, substitution_matrix, layout);
     }
 };
 
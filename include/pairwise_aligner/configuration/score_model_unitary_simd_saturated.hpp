@@ -90,16 +90,9 @@ struct traits
             using _score_type = score_type_sat_t<configuration_t::is_local>;
             return tracker::local_simd_saturated::factory<_score_type, _original_score_type>{};
         } else {
-            auto [global_zero, max_block_size] =
-            block_handler_t::compute_max_block_size(_match_score,
-                                                    _mismatch_score,
-                                                    configuration._gap_open_score,
-                                                    configuration._gap_extension_score);
-
             return tracker::global_simd_saturated::factory<_original_score_type>{
                 static_cast<_original_score_type>(_match_score),
-                configuration.trailing_gap_setting(),
-                max_block_size
+                configuration.trailing_gap_setting()
             };
         }
     }
@@ -14,10 +14,14 @@
 
 #include <algorithm>
 #include <ranges>
+#include <type_traits>
+#include <utility>
 
 #include <pairwise_aligner/dp_algorithm_template/dp_algorithm_attorney.hpp>
 #include <pairwise_aligner/result/aligner_result.hpp>
 #include <pairwise_aligner/matrix/dp_matrix_cpo.hpp>
+#include <pairwise_aligner/score_model/score_model_profiled.hpp>
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
 #include <pairwise_aligner/simd/simd_base.hpp>
 
 namespace seqan::pairwise_aligner
@@ -40,6 +44,11 @@ class _dp_algorithm_template_base<algorithm_impl_t>::type
 private:
     using algorithm_attorney_t = dp_algorithm_attorney<algorithm_impl_t>;
 
+    // The column cell is cached by value, as the dp vector might return a proxy, e.g. in structure-of-arrays layout.
+    template <typename dp_lane_t>
+    using dp_column_value_t =
+        typename std::remove_cvref_t<decltype(dp_matrix::dp_column(std::declval<dp_lane_t &>()))>::value_type;
+
 protected:
 
     auto initialise_substitution_scheme() const noexcept
@@ -64,12 +73,32 @@ protected:
         return algorithm_attorney_t::initialise_row_vector(as_algorithm(), sequence2, dp_row);
     }
 
-    template <typename ...args_t>
-    auto initialise_dp_matrix(args_t && ...args) const noexcept
+    template <typename dp_column_t, typename dp_row_t, typename sequence1_t, typename sequence2_t>
+    auto initialise_dp_matrix(dp_column_t && dp_column,
+                              dp_row_t && dp_row,
+                              sequence1_t && sequence1,
+                              sequence2_t && sequence2) const noexcept
     {
+        // The profiles of a profiled row sequence are built once and only sliced by the dp matrix.
+        auto initialise_scheme = [&] () {
+            if constexpr (is_profiled_sequence_v<std::remove_cvref_t<sequence2_t>>)
+            {
+                using symbol_t = std::ranges::range_value_t<sequence2_t>;
+                using scheme_t = decltype(initialise_substitution_scheme());
+                return score_model_profiled<scheme_t, symbol_t>{initialise_substitution_scheme(), sequence2};
+            }
+            else
+            {
+                return initialise_substitution_scheme();
+            }
+        };
+
         return algorithm_attorney_t::initialise_policies(as_algorithm(),
-                                                         std::forward<args_t>(args)...,
-                                                         initialise_substitution_scheme(),
+                                                         std::forward<dp_column_t>(dp_column),
+                                                         std::forward<dp_row_t>(dp_row),
+                                                         std::forward<sequence1_t>(sequence1),
+                                                         std::forward<sequence2_t>(sequence2),
+                                                         initialise_scheme(),
                                                          initialise_tracker());
     }
 
@@ -98,7 +127,7 @@ protected:
 
             // compute cache many cells in one row for one horizontal value.
             for (std::ptrdiff_t i = 0; i < dp_matrix::row_count(dp_lane); ++i) {
-                auto cacheH = dp_matrix::dp_column(dp_lane)[i+1];
+                dp_column_value_t<decltype(dp_lane)> cacheH = dp_matrix::dp_column(dp_lane)[i+1];
                 unroll_loop(dp_matrix::dp_row(dp_lane),
                             cacheH,
                             scorer,
@@ -117,7 +146,7 @@ protected:
 
         // compute cache many cells in one row for one horizontal value.
         for (std::ptrdiff_t i = 0; i < dp_matrix::row_count(final_dp_lane); ++i) {
-            auto cacheH = dp_matrix::dp_column(final_dp_lane)[i+1];
+            dp_column_value_t<decltype(final_dp_lane)> cacheH = dp_matrix::dp_column(final_dp_lane)[i+1];
             unroll_loop(dp_matrix::dp_row(final_dp_lane),
                         cacheH,
                         scorer,
@@ -128,6 +157,45 @@ protected:
         }
     }
 
+    // Trackers recording the end cells of the lanes during the recursion locate them before the first block.
+    template <typename tracker_t, typename ...args_t>
+    void initialise_end_cells(tracker_t & tracker, args_t && ...args) const noexcept
+    {
+        if constexpr (requires { tracker.initialise(args...); })
+            tracker.initialise(args...);
+    }
+
+    // Returns the number of leading blocks of the column that the tracker needs, e.g. only those containing cells of
+    // any lane. The blocks below are skipped. Only the saturated global tracker bounds the blocks; the fixed engines
+    // compute the dp matrix as a single block, which always holds the cells of every lane.
+    template <typename tracker_t>
+    std::ptrdiff_t active_row_count(tracker_t const & tracker,
+                                    std::ptrdiff_t const column_index,
+                                    std::ptrdiff_t const row_count) const noexcept
+    {
+        if constexpr (requires { tracker.active_row_count(column_index, row_count); })
+            return tracker.active_row_count(column_index, row_count);
+        else
+            return row_count;
+    }
+
+    // Passes the chunk of the last column to the tracker as soon as no following block writes to it.
+    template <typename tracker_t, typename dp_column_t>
+    void track_last_column(tracker_t & tracker, dp_column_t const & dp_column, std::ptrdiff_t const index)
+        const noexcept
+    {
+        if constexpr (requires { tracker.track_last_column(dp_column, index); })
+            tracker.track_last_column(dp_column, index);
+    }
+
+    // Passes the chunk of the last row to the tracker as soon as no following block writes to it.
+    template <typename tracker_t, typename dp_row_t>
+    void track_last_row(tracker_t & tracker, dp_row_t const & dp_row, std::ptrdiff_t const index) const noexcept
+    {
+        if constexpr (requires { tracker.track_last_row(dp_row, index); })
+            tracker.track_last_row(dp_row, index);
+    }
+
     template <typename tracker_t, typename ...args_t>
     auto make_result(tracker_t const & tracker, args_t && ...args) const noexcept
     {
@@ -41,7 +41,7 @@ protected:
     using base_t = dp_algorithm_template_base<algorithm_impl_t>;
 
     template <typename sequence1_t, typename sequence2_t, typename dp_column_t, typename dp_row_t>
-    auto run(sequence1_t && sequence1, sequence2_t && sequence2, dp_column_t dp_column, dp_row_t dp_row) const
+    auto run(sequence1_t && sequence1, sequence2_t && sequence2, dp_column_t && dp_column, dp_row_t && dp_row) const
     {
         // ----------------------------------------------------------------------------
         // Initialisation
@@ -71,20 +71,31 @@ protected:
         // Recursion
         // ----------------------------------------------------------------------------
 
-        for (std::ptrdiff_t column_idx = 0; column_idx < dp_matrix::column_count(matrix); ++column_idx) {
+        base_t::initialise_end_cells(dp_matrix::tracker(matrix), sequence1, sequence2, dp_column, dp_row);
+
+        std::ptrdiff_t const column_count = dp_matrix::column_count(matrix);
+        for (std::ptrdiff_t column_idx = 0; column_idx < column_count; ++column_idx) {
             // size_t const row_size = dp_row[column_idx].size() - 1;
             // auto block_sequence2 = seqan3::views::slice(transformed_seq2, row_offset, row_offset + row_size);
-            auto current_column = dp_matrix::column_at(matrix, column_idx);
-            // dp_column,
-            //                                        dp_row[column_idx],
-            //                                        base_t::initialise_substitution_scheme(),
-            //                                        tracker,
-            //                                        std::move(block_sequence2),
-            //                                        base_t::lane_width());
-            for (std::ptrdiff_t row_idx = 0; row_idx < dp_matrix::row_count(current_column); ++row_idx) {
-                auto dp_block = dp_matrix::row_at(current_column, row_idx);
-                base_t::compute_block(dp_block);
+            { // The scores of the row are only restored when the current column is destroyed.
+                auto current_column = dp_matrix::column_at(matrix, column_idx);
+                // dp_column,
+                //                                        dp_row[column_idx],
+                //                                        base_t::initialise_substitution_scheme(),
+                //                                        tracker,
+                //                                        std::move(block_sequence2),
+                //                                        base_t::lane_width());
+                std::ptrdiff_t const row_count = base_t::active_row_count(dp_matrix::tracker(matrix),
+                                                                          column_idx,
+                                                                          dp_matrix::row_count(current_column));
+                for (std::ptrdiff_t row_idx = 0; row_idx < row_count; ++row_idx) {
+                    base_t::compute_block(dp_matrix::row_at(current_column, row_idx));
+
+                    if (column_idx == column_count - 1)
+                        base_t::track_last_column(dp_matrix::tracker(matrix), dp_column, row_idx);
+                }
             }
+            base_t::track_last_row(dp_matrix::tracker(matrix), dp_row, column_idx);
             // row_offset += row_size;
         }
 
@@ -95,8 +106,8 @@ protected:
         return base_t::make_result(std::move(dp_matrix::tracker(matrix)),
                                    std::forward<sequence1_t>(sequence1),
                                    std::forward<sequence2_t>(sequence2),
-                                   std::move(dp_column),
-                                   std::move(dp_row));
+                                   std::forward<dp_column_t>(dp_column),
+                                   std::forward<dp_row_t>(dp_row));
     }
 };
 
@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::aligner_workspace.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <utility>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief Owns the dp vectors of an aligner across several calls to compute.
+ *
+ * @tparam dp_column_t The type of the first dp column of the aligner.
+ * @tparam dp_row_t The type of the first dp row of the aligner.
+ *
+ * A workspace is created by the `make_workspace()` member of a configured aligner and passed to its compute
+ * function. The dp vectors and the transformed sequences are then initialised in the memory of the workspace, such
+ * that the computation does not allocate once the workspace has seen sequences of the same size.
+ * The result returned by compute refers to the dp vectors of the workspace and is invalidated by the next call with
+ * the same workspace. A workspace must not be shared between threads.
+ */
+template <typename dp_column_t, typename dp_row_t>
+class aligner_workspace
+{
+private:
+    dp_column_t _dp_column;
+    dp_row_t _dp_row;
+
+public:
+    aligner_workspace() = delete;
+    explicit aligner_workspace(dp_column_t dp_column, dp_row_t dp_row) noexcept :
+        _dp_column{std::move(dp_column)},
+        _dp_row{std::move(dp_row)}
+    {}
+
+    dp_column_t & dp_column() noexcept
+    {
+        return _dp_column;
+    }
+
+    dp_column_t const & dp_column() const noexcept
+    {
+        return _dp_column;
+    }
+
+    dp_row_t & dp_row() noexcept
+    {
+        return _dp_row;
+    }
+
+    dp_row_t const & dp_row() const noexcept
+    {
+        return _dp_row;
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
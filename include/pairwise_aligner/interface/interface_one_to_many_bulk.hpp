@@ -14,12 +14,15 @@
 
 #include <algorithm>
 #include <cassert>
-#include <array>
-#include <memory>
-#include <optional>
+#include <iterator>
 #include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
 
-#include <pairwise_aligner/result/aligner_result_bulk.hpp>
+#include <pairwise_aligner/interface/aligner_workspace.hpp>
+#include <pairwise_aligner/result/aligner_result_batch.hpp>
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
 
 namespace seqan::pairwise_aligner
 {
@@ -35,6 +38,13 @@ struct _interface_one_to_many_bulk
 template <typename dp_algorithm_t, size_t max_bulk_size>
 using interface_one_to_many_bulk = typename _interface_one_to_many_bulk<dp_algorithm_t, max_bulk_size>::type;
 
+/**
+ * @brief Computes one first sequence against bulks of up to `max_bulk_size` second sequences, one per simd lane.
+ *
+ * The first sequence is broadcast to all lanes and aligned as a whole; there is no mode packing several first
+ * sequences end to end into one column sequence. Many short first sequences are aligned one per call against the
+ * same bulk instead, which is prepared and profiled only once with make_profiled_sequence_batch2.
+ */
 template <typename dp_algorithm_t, size_t max_bulk_size>
 struct _interface_one_to_many_bulk<dp_algorithm_t, max_bulk_size>::type : protected dp_algorithm_t
 {
@@ -44,6 +54,68 @@ struct _interface_one_to_many_bulk<dp_algorithm_t, max_bulk_size>::type : protec
     using dp_algorithm_t::column_vector;
     using dp_algorithm_t::row_vector;
 
+    //!\brief Returns the maximal number of sequences computed in one bulk.
+    static constexpr size_t bulk_size() noexcept
+    {
+        return max_bulk_size;
+    }
+
+    //!\brief Creates a workspace, which can be reused by subsequent calls to compute.
+    auto make_workspace() const
+    {
+        return aligner_workspace<decltype(column_vector()), decltype(row_vector())>{column_vector(), row_vector()};
+    }
+
+    /**
+     * @brief Prepares the given sequences for repeated use as second sequences of compute.
+     *
+     * Returns a seqan::pairwise_aligner::sequence_batch, whose sequences are transposed and transformed only once.
+     * The batch can be passed instead of the second sequence bulk to compute, e.g. to align many queries against
+     * the same database sequences.
+     */
+    template <std::ranges::forward_range sequence_bulk_t>
+    auto make_sequence_batch2(sequence_bulk_t && sequence_bulk) const
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk)) <= max_bulk_size);
+        return row_vector().prepare(std::forward<sequence_bulk_t>(sequence_bulk));
+    }
+
+    /**
+     * @brief Prepares the given sequences and builds their substitution profile for repeated use in compute.
+     *
+     * Returns a seqan::pairwise_aligner::profiled_sequence_batch, which can be passed instead of the second sequence
+     * bulk to compute. Besides transposing and transforming the sequences only once, the profile of the
+     * substitution scores is built once over all symbols, such that compute only reads it. This saves building the
+     * profile on every call, which takes a considerable part of the time if the first sequences are short.
+     * The profile needs about `dimension` times the memory of the symbols, where `dimension` is the size of the
+     * substitution matrix. If a seqan::pairwise_aligner::sequence_batch is given, the profiled batch refers to its
+     * symbols, which must outlive the profiled batch.
+     */
+    template <std::ranges::forward_range sequence_bulk_t>
+    auto make_profiled_sequence_batch2(sequence_bulk_t && sequence_bulk) const
+    {
+        auto make_profiled_batch = [&] (auto batch) {
+            auto profile = dp_algorithm_t::initialise_substitution_scheme().initialise_profile(batch.symbols());
+            return profiled_sequence_batch<decltype(batch), decltype(profile)>{std::move(batch), std::move(profile)};
+        };
+
+        if constexpr (sequence_batch_range<sequence_bulk_t>)
+        {
+            using symbol_t = typename std::remove_cvref_t<sequence_bulk_t>::symbol_type;
+            auto sequence_sizes = sequence_bulk | std::views::transform([] (auto const & sequence) {
+                return static_cast<size_t>(std::ranges::distance(sequence));
+            });
+            return make_profiled_batch(sequence_batch<symbol_t, std::span<symbol_t const>>{
+                std::span<symbol_t const>{sequence_bulk.symbols()},
+                sequence_sizes
+            });
+        }
+        else
+        {
+            return make_profiled_batch(make_sequence_batch2(std::forward<sequence_bulk_t>(sequence_bulk)));
+        }
+    }
+
     template <std::ranges::forward_range sequence1_t,
               std::ranges::forward_range sequence_bulk2_t>
         requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>> &&
@@ -58,6 +130,12 @@ struct _interface_one_to_many_bulk<dp_algorithm_t, max_bulk_size>::type : protec
                        row_vector());
     }
 
+    /**
+     * @brief Computes the bulk in the memory of the given workspace.
+     *
+     * Returns a seqan::pairwise_aligner::aligner_result_batch with the results of all pairs.
+     * The batch refers to the dp vectors of the workspace and is valid until the workspace is used again.
+     */
     template <std::ranges::forward_range sequence1_t,
               std::ranges::forward_range sequence_bulk2_t,
               typename dp_column_t,
@@ -66,29 +144,84 @@ struct _interface_one_to_many_bulk<dp_algorithm_t, max_bulk_size>::type : protec
                   std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
     auto compute(sequence1_t && sequence1,
                  sequence_bulk2_t && sequence_bulk2,
-                 dp_column_t first_dp_column,
-                 dp_row_t first_dp_row)
+                 aligner_workspace<dp_column_t, dp_row_t> & workspace)
     {
         assert(static_cast<size_t>(std::ranges::distance(sequence_bulk2)) <= max_bulk_size);
 
+        size_t const bulk_size = std::ranges::distance(sequence_bulk2);
         auto result = dp_algorithm_t::run(std::forward<sequence1_t>(sequence1),
                                           std::forward<sequence_bulk2_t>(sequence_bulk2),
-                                          std::move(first_dp_column),
-                                          std::move(first_dp_row));
+                                          workspace.dp_column(),
+                                          workspace.dp_row());
+        return aligner_result_batch<decltype(result)>{std::move(result), bulk_size};
+    }
 
-        // Transfrom bulk result to single results.
-        using result_t = decltype(result);
+    /**
+     * @brief Computes the bulk in the memory of the given workspace and writes the scores to the given output.
+     *
+     * Writes the score of every pair in the order of the bulk to `score_out` and returns the iterator past the last
+     * written score.
+     */
+    template <std::ranges::forward_range sequence1_t,
+              std::ranges::forward_range sequence_bulk2_t,
+              typename dp_column_t,
+              typename dp_row_t,
+              std::weakly_incrementable score_out_t>
+        requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>> &&
+                  std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
+    score_out_t compute(sequence1_t && sequence1,
+                        sequence_bulk2_t && sequence_bulk2,
+                        aligner_workspace<dp_column_t, dp_row_t> & workspace,
+                        score_out_t score_out)
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk2)) <= max_bulk_size);
 
         size_t const bulk_size = std::ranges::distance(sequence_bulk2);
-        std::vector<aligner_result_bulk<result_t>> results{};
-        results.reserve(bulk_size);
+        auto result = dp_algorithm_t::run(std::forward<sequence1_t>(sequence1),
+                                          std::forward<sequence_bulk2_t>(sequence_bulk2),
+                                          workspace.dp_column(),
+                                          workspace.dp_row());
 
-        auto shared_result = std::make_shared<result_t>(std::move(result));
+        for (size_t result_idx = 0; result_idx < bulk_size; ++result_idx, ++score_out)
+            *score_out = result.score()[result_idx];
 
-        for (size_t result_idx = 0; result_idx < bulk_size; ++result_idx)
-            results.emplace_back(shared_result, result_idx);
+        return score_out;
+    }
+
+    //!\brief Computes the bulk and writes the scores to the given output; see the overload with workspace.
+    template <std::ranges::forward_range sequence1_t,
+              std::ranges::forward_range sequence_bulk2_t,
+              std::weakly_incrementable score_out_t>
+        requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>> &&
+                  std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
+    score_out_t compute(sequence1_t && sequence1, sequence_bulk2_t && sequence_bulk2, score_out_t score_out)
+    {
+        auto workspace = make_workspace();
+        return compute(std::forward<sequence1_t>(sequence1),
+                       std::forward<sequence_bulk2_t>(sequence_bulk2),
+                       workspace,
+                       std::move(score_out));
+    }
+
+    template <std::ranges::forward_range sequence1_t,
+              std::ranges::forward_range sequence_bulk2_t,
+              typename dp_column_t,
+              typename dp_row_t>
+        requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>> &&
+                  std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
+    auto compute(sequence1_t && sequence1,
+                 sequence_bulk2_t && sequence_bulk2,
+                 dp_column_t first_dp_column,
+                 dp_row_t first_dp_row)
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk2)) <= max_bulk_size);
 
-        return results;
+        size_t const bulk_size = std::ranges::distance(sequence_bulk2);
+        auto result = dp_algorithm_t::run(std::forward<sequence1_t>(sequence1),
+                                          std::forward<sequence_bulk2_t>(sequence_bulk2),
+                                          std::move(first_dp_column),
+                                          std::move(first_dp_row));
+        return aligner_result_batch<decltype(result)>{std::move(result), bulk_size};
     }
 };
 
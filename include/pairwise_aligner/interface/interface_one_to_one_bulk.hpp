@@ -13,13 +13,13 @@
 #pragma once
 
 #include <algorithm>
-#include <array>
 #include <cassert>
-#include <memory>
-#include <optional>
+#include <iterator>
 #include <ranges>
+#include <utility>
 
-#include <pairwise_aligner/result/aligner_result_bulk.hpp>
+#include <pairwise_aligner/interface/aligner_workspace.hpp>
+#include <pairwise_aligner/result/aligner_result_batch.hpp>
 
 namespace seqan::pairwise_aligner
 {
@@ -35,6 +35,17 @@ struct _interface_one_to_one_bulk
 template <typename dp_algorithm_t, size_t max_bulk_size>
 using interface_one_to_one_bulk = typename _interface_one_to_one_bulk<dp_algorithm_t, max_bulk_size>::type;
 
+/**
+ * @brief Computes bulks of up to `max_bulk_size` independent pairs, one pair per simd lane.
+ *
+ * All lanes of a bulk share the iteration over the dp matrix of the longest pair; the shorter pairs are padded.
+ * Hence, a lane holds exactly one pair and there is no mode packing several pairs end to end into one lane: it would
+ * compute the full matrix over the concatenated sequences, which grows quadratically with the number of pairs per
+ * lane, while only the blocks on its diagonal belong to the pairs.
+ * For many short pairs the fixed costs of a call are amortised instead by sorting the pairs by length, preparing
+ * the bulks once with make_sequence_batch1 and make_sequence_batch2 and computing them with one workspace into a
+ * score output, which creates no result objects.
+ */
 template <typename dp_algorithm_t, size_t max_bulk_size>
 struct _interface_one_to_one_bulk<dp_algorithm_t, max_bulk_size>::type : protected dp_algorithm_t
 {
@@ -44,6 +55,39 @@ struct _interface_one_to_one_bulk<dp_algorithm_t, max_bulk_size>::type : protect
     using dp_algorithm_t::column_vector;
     using dp_algorithm_t::row_vector;
 
+    //!\brief Returns the maximal number of sequences computed in one bulk.
+    static constexpr size_t bulk_size() noexcept
+    {
+        return max_bulk_size;
+    }
+
+    //!\brief Creates a workspace, which can be reused by subsequent calls to compute.
+    auto make_workspace() const
+    {
+        return aligner_workspace<decltype(column_vector()), decltype(row_vector())>{column_vector(), row_vector()};
+    }
+
+    /**
+     * @brief Prepares the given sequences for repeated use as first sequences of compute.
+     *
+     * Returns a seqan::pairwise_aligner::sequence_batch, whose sequences are transposed and transformed only once.
+     * The batch can be passed instead of the first sequence bulk to compute.
+     */
+    template <std::ranges::forward_range sequence_bulk_t>
+    auto make_sequence_batch1(sequence_bulk_t && sequence_bulk) const
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk)) <= max_bulk_size);
+        return column_vector().prepare(std::forward<sequence_bulk_t>(sequence_bulk));
+    }
+
+    //!\brief Prepares the given sequences for repeated use as second sequences of compute; see make_sequence_batch1.
+    template <std::ranges::forward_range sequence_bulk_t>
+    auto make_sequence_batch2(sequence_bulk_t && sequence_bulk) const
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk)) <= max_bulk_size);
+        return row_vector().prepare(std::forward<sequence_bulk_t>(sequence_bulk));
+    }
+
     template <std::ranges::forward_range sequence_bulk1_t,
               std::ranges::forward_range sequence_bulk2_t>
         requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
@@ -62,6 +106,12 @@ struct _interface_one_to_one_bulk<dp_algorithm_t, max_bulk_size>::type : protect
                        row_vector());
     }
 
+    /**
+     * @brief Computes the bulk in the memory of the given workspace.
+     *
+     * Returns a seqan::pairwise_aligner::aligner_result_batch with the results of all pairs.
+     * The batch refers to the dp vectors of the workspace and is valid until the workspace is used again.
+     */
     template <std::ranges::forward_range sequence_bulk1_t,
               std::ranges::forward_range sequence_bulk2_t,
               typename dp_column_t,
@@ -72,31 +122,96 @@ struct _interface_one_to_one_bulk<dp_algorithm_t, max_bulk_size>::type : protect
                   std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
     auto compute(sequence_bulk1_t && sequence_bulk1,
                  sequence_bulk2_t && sequence_bulk2,
-                 dp_column_t first_dp_column,
-                 dp_row_t first_dp_row)
+                 aligner_workspace<dp_column_t, dp_row_t> & workspace)
     {
         assert(static_cast<size_t>(std::ranges::distance(sequence_bulk1)) <= max_bulk_size);
         assert(static_cast<size_t>(std::ranges::distance(sequence_bulk2)) <= max_bulk_size);
         assert(std::ranges::distance(sequence_bulk1) == std::ranges::distance(sequence_bulk2));
 
+        size_t const bulk_size = std::ranges::distance(sequence_bulk1);
         auto result = dp_algorithm_t::run(std::forward<sequence_bulk1_t>(sequence_bulk1),
                                           std::forward<sequence_bulk2_t>(sequence_bulk2),
-                                          std::move(first_dp_column),
-                                          std::move(first_dp_row));
+                                          workspace.dp_column(),
+                                          workspace.dp_row());
+        return aligner_result_batch<decltype(result)>{std::move(result), bulk_size};
+    }
 
-        // Transfrom bulk result to single results.
-        using result_t = decltype(result);
+    /**
+     * @brief Computes the bulk in the memory of the given workspace and writes the scores to the given output.
+     *
+     * Writes the score of every pair in the order of the bulk to `score_out` and returns the iterator past the last
+     * written score.
+     */
+    template <std::ranges::forward_range sequence_bulk1_t,
+              std::ranges::forward_range sequence_bulk2_t,
+              typename dp_column_t,
+              typename dp_row_t,
+              std::weakly_incrementable score_out_t>
+        requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
+                  std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>>) &&
+                 (std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
+                  std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
+    score_out_t compute(sequence_bulk1_t && sequence_bulk1,
+                        sequence_bulk2_t && sequence_bulk2,
+                        aligner_workspace<dp_column_t, dp_row_t> & workspace,
+                        score_out_t score_out)
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk1)) <= max_bulk_size);
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk2)) <= max_bulk_size);
+        assert(std::ranges::distance(sequence_bulk1) == std::ranges::distance(sequence_bulk2));
 
         size_t const bulk_size = std::ranges::distance(sequence_bulk1);
-        std::vector<aligner_result_bulk<result_t>> results{};
-        results.reserve(bulk_size);
+        auto result = dp_algorithm_t::run(std::forward<sequence_bulk1_t>(sequence_bulk1),
+                                          std::forward<sequence_bulk2_t>(sequence_bulk2),
+                                          workspace.dp_column(),
+                                          workspace.dp_row());
+
+        for (size_t result_idx = 0; result_idx < bulk_size; ++result_idx, ++score_out)
+            *score_out = result.score()[result_idx];
 
-        auto shared_result = std::make_shared<result_t>(std::move(result));
+        return score_out;
+    }
 
-        for (size_t result_idx = 0; result_idx < bulk_size; ++result_idx)
-            results.emplace_back(shared_result, result_idx);
+    //!\brief Computes the bulk and writes the scores to the given output; see the overload with workspace.
+    template <std::ranges::forward_range sequence_bulk1_t,
+              std::ranges::forward_range sequence_bulk2_t,
+              std::weakly_incrementable score_out_t>
+        requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
+                  std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>>) &&
+                 (std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
+                  std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
+    score_out_t compute(sequence_bulk1_t && sequence_bulk1, sequence_bulk2_t && sequence_bulk2, score_out_t score_out)
+    {
+        auto workspace = make_workspace();
+        return compute(std::forward<sequence_bulk1_t>(sequence_bulk1),
+                       std::forward<sequence_bulk2_t>(sequence_bulk2),
+                       workspace,
+                       std::move(score_out));
+    }
 
-        return results;
+    template <std::ranges::forward_range sequence_bulk1_t,
+              std::ranges::forward_range sequence_bulk2_t,
+              typename dp_column_t,
+              typename dp_row_t>
+        requires (std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
+                  std::ranges::forward_range<std::ranges::range_reference_t<sequence_bulk2_t>>) &&
+                 (std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk1_t>> &&
+                  std::ranges::viewable_range<std::ranges::range_reference_t<sequence_bulk2_t>>)
+    auto compute(sequence_bulk1_t && sequence_bulk1,
+                 sequence_bulk2_t && sequence_bulk2,
+                 dp_column_t first_dp_column,
+                 dp_row_t first_dp_row)
+    {
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk1)) <= max_bulk_size);
+        assert(static_cast<size_t>(std::ranges::distance(sequence_bulk2)) <= max_bulk_size);
+        assert(std::ranges::distance(sequence_bulk1) == std::ranges::distance(sequence_bulk2));
+
+        size_t const bulk_size = std::ranges::distance(sequence_bulk1);
+        auto result = dp_algorithm_t::run(std::forward<sequence_bulk1_t>(sequence_bulk1),
+                                          std::forward<sequence_bulk2_t>(sequence_bulk2),
+                                          std::move(first_dp_column),
+                                          std::move(first_dp_row));
+        return aligner_result_batch<decltype(result)>{std::move(result), bulk_size};
     }
 };
 
@@ -14,6 +14,8 @@
 
 #include <ranges>
 
+#include <pairwise_aligner/interface/aligner_workspace.hpp>
+
 namespace seqan::pairwise_aligner
 {
 inline namespace v1
@@ -37,6 +39,12 @@ struct _interface_one_to_one_single<dp_algorithm_t>::type : protected dp_algorit
     using dp_algorithm_t::column_vector;
     using dp_algorithm_t::row_vector;
 
+    //!\brief Creates a workspace, which can be reused by subsequent calls to compute.
+    auto make_workspace() const
+    {
+        return aligner_workspace<decltype(column_vector()), decltype(row_vector())>{column_vector(), row_vector()};
+    }
+
     template <std::ranges::forward_range sequence1_t,
               std::ranges::forward_range sequence2_t>
         requires (std::ranges::viewable_range<sequence1_t> &&
@@ -65,6 +73,27 @@ struct _interface_one_to_one_single<dp_algorithm_t>::type : protected dp_algorit
                                    std::move(first_dp_column),
                                    std::move(first_dp_row));
     }
+
+    /**
+     * @brief Computes the alignment in the memory of the given workspace.
+     *
+     * The returned result refers to the dp vectors of the workspace and is valid until the workspace is used again.
+     */
+    template <std::ranges::forward_range sequence1_t,
+              std::ranges::forward_range sequence2_t,
+              typename column_vector_t,
+              typename row_vector_t>
+        requires (std::ranges::viewable_range<sequence1_t> &&
+                  std::ranges::viewable_range<sequence2_t>)
+    auto compute(sequence1_t && sequence1,
+                 sequence2_t && sequence2,
+                 aligner_workspace<column_vector_t, row_vector_t> & workspace)
+    {
+        return dp_algorithm_t::run(std::forward<sequence1_t>(sequence1),
+                                   std::forward<sequence2_t>(sequence2),
+                                   workspace.dp_column(),
+                                   workspace.dp_row());
+    }
 };
 
 } // inline namespace v1
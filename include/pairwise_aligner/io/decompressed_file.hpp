@@ -0,0 +1,570 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::decompressed_file.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <pairwise_aligner/io/mapped_file.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/*
+ * A contiguous range of virtual memory, which is reserved without being backed by memory and committed piecewise.
+ * The decompressed data is written to its final position, such that views into it stay valid while the data grows.
+ */
+class reserved_memory
+{
+private:
+    char * _data{};
+    size_t _capacity{};
+    size_t _committed{};
+
+public:
+
+    reserved_memory() = default;
+    reserved_memory(reserved_memory const &) = delete;
+    reserved_memory(reserved_memory && other) noexcept :
+        _data{std::exchange(other._data, nullptr)},
+        _capacity{std::exchange(other._capacity, 0)},
+        _committed{std::exchange(other._committed, 0)}
+    {}
+
+    reserved_memory & operator=(reserved_memory const &) = delete;
+    reserved_memory & operator=(reserved_memory && other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_capacity, other._capacity);
+        std::swap(_committed, other._committed);
+        return *this;
+    }
+
+    explicit reserved_memory(size_t const capacity) : _capacity{page_ceil(std::max<size_t>(capacity, 1))}
+    {
+        void * data = ::mmap(nullptr, _capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (data == MAP_FAILED)
+            throw std::runtime_error{"Could not reserve memory for the decompressed file."};
+
+        _data = static_cast<char *>(data);
+    }
+
+    ~reserved_memory()
+    {
+        if (_data != nullptr)
+            ::munmap(_data, _capacity);
+    }
+
+    char * data() const noexcept
+    {
+        return _data;
+    }
+
+    size_t capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    // Makes the first bytes writable; only called by the thread writing to the end of the committed memory.
+    void commit(size_t const size)
+    {
+        if (size <= _committed)
+            return;
+
+        if (size > _capacity)
+            throw std::runtime_error{"The decompressed file exceeds the reserved memory of " +
+                                     std::to_string(_capacity) + " bytes."};
+
+        size_t const committed = page_ceil(size);
+        if (::mprotect(_data + _committed, committed - _committed, PROT_READ | PROT_WRITE) != 0)
+            throw std::runtime_error{"Could not commit memory for the decompressed file."};
+
+        _committed = committed;
+    }
+
+    // Returns the whole pages in the range to the operating system; the range must have been written before.
+    void release(size_t const begin, size_t const end) const noexcept
+    {
+        size_t const page_size = ::sysconf(_SC_PAGESIZE);
+        size_t const release_begin = page_ceil(begin);
+        size_t const release_end = (end / page_size) * page_size;
+        if (release_begin < release_end)
+            ::madvise(_data + release_begin, release_end - release_begin, MADV_DONTNEED);
+    }
+
+private:
+
+    static size_t page_ceil(size_t const size) noexcept
+    {
+        size_t const page_size = ::sysconf(_SC_PAGESIZE);
+        return (size + page_size - 1) / page_size * page_size;
+    }
+};
+
+// The decompressed data shared by the file, its decompressing threads and the leases of the batches.
+struct decompression_state
+{
+    mapped_file compressed{};
+    reserved_memory memory{};
+
+    std::mutex mutex{};
+    std::condition_variable data_available{}; // Notified when data was decompressed or the decompression ended.
+    std::condition_variable data_requested{}; // Notified when the reader moved on or the file was closed.
+    size_t available{}; // The size of the decompressed prefix.
+    size_t requested{}; // The size up to which the data is decompressed ahead of the reader.
+    bool finished{false};
+    bool stopped{false};
+    std::exception_ptr error{};
+
+    // The beginnings of the data viewed by the batches and whether they are still viewed.
+    std::deque<std::pair<size_t, bool>> leases{};
+    size_t expired_lease_count{}; // The number of leases removed from the front.
+    size_t consumed{}; // The size of the data passed by the reader.
+    size_t released{}; // The size of the data returned to the operating system.
+
+    // Releases the data before the first live lease and before the position of the reader; requires the lock.
+    void release_unused() noexcept
+    {
+        for (; !leases.empty() && !leases.front().second; ++expired_lease_count)
+            leases.pop_front();
+
+        size_t const release_end = leases.empty() ? consumed : std::min(consumed, leases.front().first);
+        if (release_end > released)
+        {
+            memory.release(released, release_end);
+            released = release_end;
+        }
+    }
+};
+
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+// Wraps a zlib stream, which is reused for multiple members or blocks.
+class inflate_stream
+{
+private:
+    z_stream _stream{};
+
+public:
+
+    explicit inflate_stream(int const window_bits)
+    {
+        if (::inflateInit2(&_stream, window_bits) != Z_OK)
+            throw std::runtime_error{"Could not initialise the zlib decompression."};
+    }
+
+    inflate_stream(inflate_stream const &) = delete;
+    inflate_stream & operator=(inflate_stream const &) = delete;
+
+    ~inflate_stream()
+    {
+        ::inflateEnd(&_stream);
+    }
+
+    z_stream & get() noexcept
+    {
+        return _stream;
+    }
+
+    void reset() noexcept
+    {
+        ::inflateReset(&_stream);
+    }
+};
+#endif // PAIRWISE_ALIGNER_HAS_ZLIB
+
+} // namespace detail
+
+/**
+ * @brief A gzip or BGZF compressed file, which is decompressed ahead of the reader by background threads.
+ *
+ * The data is decompressed into one contiguous range of virtual memory, which is only backed by memory where data
+ * was written. Hence, the decompressed data is accessed like a seqan::pairwise_aligner::mapped_file and views into it
+ * stay valid while more data is decompressed. The decompression runs at most a fixed amount of data ahead of the
+ * position requested by the reader, and the data passed by the reader is returned to the operating system unless
+ * it is still viewed through a lease, such that the resident memory is bounded regardless of the file size.
+ *
+ * BGZF files, i.e. a series of gzip members with their compressed size in the header, are decompressed by multiple
+ * threads, each decompressing whole blocks directly to their final position. Other gzip files can only be
+ * decompressed sequentially and are decompressed by a single thread.
+ *
+ * Requires zlib, i.e. the definition `PAIRWISE_ALIGNER_HAS_ZLIB`; otherwise opening a compressed file throws.
+ */
+class decompressed_file
+{
+private:
+    // The part of a BGZF file decompressed at once.
+    struct bgzf_block
+    {
+        size_t compressed_offset{};
+        size_t compressed_size{};
+        size_t offset{};
+        size_t size{};
+        uint32_t crc{};
+    };
+
+    // The blocks of a BGZF file and the progress of their decompression; guarded by the mutex of the state.
+    struct bgzf_index
+    {
+        std::vector<bgzf_block> blocks{};
+        std::vector<bool> completed{};
+        size_t next_block{}; // The next block to decompress.
+        size_t published_block_count{}; // The number of blocks in the decompressed prefix.
+    };
+
+    //!\brief The amount of data decompressed ahead of the reader.
+    static constexpr size_t read_ahead = size_t{16} << 20;
+    //!\brief The maximal ratio of the decompressed and the compressed size of deflate data.
+    static constexpr size_t max_deflate_ratio = 1032;
+    //!\brief The amount of data decompressed and published at once from a gzip file.
+    static constexpr size_t gzip_chunk_size = size_t{1} << 20;
+
+    std::shared_ptr<detail::decompression_state> _state{};
+    std::vector<std::jthread> _threads{};
+
+public:
+
+    decompressed_file() = default;
+    decompressed_file(decompressed_file &&) = default;
+    decompressed_file & operator=(decompressed_file && other) noexcept
+    {
+        // Swapping stops the threads of this file in the destructor of the other one.
+        std::swap(_state, other._state);
+        std::swap(_threads, other._threads);
+        return *this;
+    }
+
+    ~decompressed_file()
+    {
+        if (_state != nullptr)
+        {
+            {
+                std::lock_guard lock{_state->mutex};
+                _state->stopped = true;
+            }
+            _state->data_requested.notify_all();
+        }
+    } // The threads are joined afterwards.
+
+    /**
+     * @brief Starts decompressing the given gzip or BGZF file.
+     *
+     * @param compressed The mapped compressed file.
+     * @param thread_count The number of threads decompressing a BGZF file; other files use a single thread.
+     *
+     * @throws std::runtime_error if zlib is not available or the BGZF blocks are malformed.
+     */
+    decompressed_file(mapped_file compressed, size_t const thread_count) :
+        _state{std::make_shared<detail::decompression_state>()}
+    {
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+        _state->compressed = std::move(compressed);
+        _state->compressed.advise_sequential();
+        _state->requested = read_ahead;
+
+        if (is_bgzf(_state->compressed.view()))
+        {
+            auto index = std::make_shared<bgzf_index>();
+            index->blocks = index_bgzf_blocks();
+            index->completed.resize(index->blocks.size(), false);
+
+            size_t const size = index->blocks.empty() ? 0 : index->blocks.back().offset + index->blocks.back().size;
+            _state->memory = detail::reserved_memory{size};
+            _state->memory.commit(size);
+            _state->finished = index->blocks.empty();
+
+            for (size_t thread_idx = 0; thread_idx < std::max<size_t>(thread_count, 1); ++thread_idx)
+            {
+                _threads.emplace_back([state = _state, index] () {
+                    run_guarded(*state, [&] () { decompress_bgzf(*state, *index); });
+                });
+            }
+        }
+        else
+        {
+            // The decompressed size is not known in advance, hence the maximal size is reserved as address space.
+            _state->memory = detail::reserved_memory{_state->compressed.size() * max_deflate_ratio + gzip_chunk_size};
+            _threads.emplace_back([state = _state] () {
+                run_guarded(*state, [&] () { decompress_gzip(*state); });
+            });
+        }
+#else
+        (void) compressed;
+        (void) thread_count;
+        throw std::runtime_error{"Reading compressed files requires zlib."};
+#endif
+    }
+
+    //!\brief Whether the data starts with the magic bytes of gzip, which are also used by BGZF.
+    static bool is_compressed(std::string_view const data) noexcept
+    {
+        return data.size() >= 2 && static_cast<uint8_t>(data[0]) == 0x1f && static_cast<uint8_t>(data[1]) == 0x8b;
+    }
+
+    /**
+     * @brief Waits until at least the given number of bytes was decompressed or the file ended.
+     *
+     * @returns The decompressed data, which is shorter than the requested size only at the end of the file.
+     * @throws std::runtime_error if the file cannot be decompressed.
+     */
+    std::string_view wait_for(size_t const size)
+    {
+        std::unique_lock lock{_state->mutex};
+        if (size + read_ahead > _state->requested)
+        {
+            _state->requested = size + read_ahead;
+            _state->data_requested.notify_all();
+        }
+
+        _state->data_available.wait(lock, [&] () { return _state->available >= size || _state->finished; });
+        if (_state->error)
+            std::rethrow_exception(_state->error);
+
+        return std::string_view{_state->memory.data(), _state->available};
+    }
+
+    /**
+     * @brief Keeps the data from the given offset on until the returned lease is destroyed.
+     *
+     * The lease also keeps the decompressed data alive after this file was destroyed.
+     */
+    std::shared_ptr<void const> lease(size_t const offset)
+    {
+        std::lock_guard lock{_state->mutex};
+        _state->leases.emplace_back(offset, true);
+        size_t const lease_idx = _state->expired_lease_count + _state->leases.size() - 1;
+        return std::shared_ptr<void const>{_state->memory.data() + offset, [state = _state, lease_idx] (void const *) {
+            std::lock_guard lock{state->mutex};
+            state->leases[lease_idx - state->expired_lease_count].second = false;
+            state->release_unused();
+        }};
+    }
+
+    //!\brief Releases the data before the offset, which was passed by the reader, unless it is leased.
+    void release(size_t const offset) noexcept
+    {
+        std::lock_guard lock{_state->mutex};
+        _state->consumed = std::max(_state->consumed, offset);
+        _state->release_unused();
+    }
+
+private:
+
+    static bool is_bgzf(std::string_view const data) noexcept
+    {
+        // A gzip header with the extra field flag and the BGZF subfield "BC" of size 2.
+        return is_compressed(data) && data.size() >= 18 && (static_cast<uint8_t>(data[3]) & 4) != 0 &&
+               data[12] == 'B' && data[13] == 'C';
+    }
+
+    template <typename value_t>
+    static value_t read_little_endian(char const * data) noexcept
+    {
+        value_t value{};
+        for (size_t byte_idx = 0; byte_idx < sizeof(value_t); ++byte_idx)
+            value |= static_cast<value_t>(static_cast<uint8_t>(data[byte_idx])) << (8 * byte_idx);
+        return value;
+    }
+
+    // Reads the headers of all blocks, which give the compressed and the decompressed size of every block.
+    std::vector<bgzf_block> index_bgzf_blocks() const
+    {
+        std::string_view const data = _state->compressed.view();
+        std::vector<bgzf_block> blocks{};
+        size_t offset = 0;
+        for (size_t compressed_offset = 0; compressed_offset < data.size();)
+        {
+            std::string_view const header = data.substr(compressed_offset);
+            if (!is_bgzf(header))
+                throw std::runtime_error{"The BGZF block at byte " + std::to_string(compressed_offset) +
+                                         " is malformed."};
+
+            size_t const extra_size = read_little_endian<uint16_t>(header.data() + 10);
+            size_t const block_size = read_little_endian<uint16_t>(header.data() + 16) + size_t{1};
+            if (block_size > header.size() || block_size < 12 + extra_size + 8)
+                throw std::runtime_error{"The BGZF block at byte " + std::to_string(compressed_offset) +
+                                         " is truncated."};
+
+            bgzf_block & block = blocks.emplace_back();
+            block.compressed_offset = compressed_offset + 12 + extra_size;
+            block.compressed_size = block_size - 12 - extra_size - 8;
+            block.offset = offset;
+            block.crc = read_little_endian<uint32_t>(header.data() + block_size - 8);
+            block.size = read_little_endian<uint32_t>(header.data() + block_size - 4);
+
+            offset += block.size;
+            compressed_offset += block_size;
+        }
+        return blocks;
+    }
+
+    // Runs the decompression and ends it with the error thrown by it.
+    template <typename decompress_t>
+    static void run_guarded(detail::decompression_state & state, decompress_t && decompress) noexcept
+    {
+        try
+        {
+            decompress();
+        }
+        catch (...)
+        {
+            std::lock_guard lock{state.mutex};
+            if (!state.error)
+                state.error = std::current_exception();
+            state.finished = true;
+            state.stopped = true;
+        }
+        state.data_available.notify_all();
+        state.data_requested.notify_all();
+    }
+
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+    // Every thread takes the next block and decompresses it; the decompressed prefix grows by the completed blocks.
+    static void decompress_bgzf(detail::decompression_state & state, bgzf_index & index)
+    {
+        std::vector<bgzf_block> const & blocks = index.blocks;
+        detail::inflate_stream stream{-MAX_WBITS}; // The raw deflate data without the gzip header.
+        for (;;)
+        {
+            size_t block_idx{};
+            {
+                std::unique_lock lock{state.mutex};
+                state.data_requested.wait(lock, [&] () {
+                    return state.stopped || index.next_block == blocks.size() ||
+                           blocks[index.next_block].offset < state.requested;
+                });
+                if (state.stopped || index.next_block == blocks.size())
+                    return;
+
+                block_idx = index.next_block++;
+            }
+
+            bgzf_block const & block = blocks[block_idx];
+            char * const output = state.memory.data() + block.offset;
+            z_stream & zstream = stream.get();
+            stream.reset();
+            zstream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(state.compressed.data()) +
+                                                        block.compressed_offset);
+            zstream.avail_in = block.compressed_size;
+            zstream.next_out = reinterpret_cast<Bytef *>(output);
+            zstream.avail_out = block.size;
+
+            if (::inflate(&zstream, Z_FINISH) != Z_STREAM_END || zstream.total_out != block.size ||
+                ::crc32(0, reinterpret_cast<Bytef const *>(output), block.size) != block.crc)
+            {
+                throw std::runtime_error{"The BGZF block at byte " + std::to_string(block.compressed_offset) +
+                                         " is corrupted."};
+            }
+
+            {
+                std::lock_guard lock{state.mutex};
+                index.completed[block_idx] = true;
+                for (; index.published_block_count < blocks.size() && index.completed[index.published_block_count];
+                     ++index.published_block_count)
+                {
+                    state.available += blocks[index.published_block_count].size;
+                }
+                state.finished = (index.published_block_count == blocks.size());
+            }
+            state.data_available.notify_all();
+        }
+    }
+
+    // Inflates the concatenated gzip members in chunks, each of which is published after it was decompressed.
+    static void decompress_gzip(detail::decompression_state & state)
+    {
+        std::string_view const input = state.compressed.view();
+        detail::inflate_stream stream{MAX_WBITS + 16}; // Expects the gzip header and trailer.
+        z_stream & zstream = stream.get();
+
+        size_t input_offset = 0;
+        size_t available = 0;
+        bool member_ended = false;
+        while (input_offset < input.size())
+        {
+            {
+                std::unique_lock lock{state.mutex};
+                state.data_requested.wait(lock, [&] () { return state.stopped || available < state.requested; });
+                if (state.stopped)
+                    return;
+            }
+
+            // Only the thread writing the data commits the memory.
+            state.memory.commit(available + gzip_chunk_size);
+            zstream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()) + input_offset);
+            zstream.avail_in = static_cast<uInt>(std::min<size_t>(input.size() - input_offset, UINT_MAX));
+            zstream.next_out = reinterpret_cast<Bytef *>(state.memory.data() + available);
+            zstream.avail_out = gzip_chunk_size;
+
+            int const status = ::inflate(&zstream, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END)
+                throw std::runtime_error{"The gzip file is corrupted at byte " + std::to_string(input_offset) + "."};
+
+            input_offset = reinterpret_cast<char const *>(zstream.next_in) - input.data();
+            available = reinterpret_cast<char *>(zstream.next_out) - state.memory.data();
+            member_ended = (status == Z_STREAM_END);
+            state.compressed.release(input_offset);
+
+            if (member_ended)
+            {
+                // Another member might follow; other trailing data, e.g. padding, is ignored like gzip does.
+                if (!is_compressed(input.substr(input_offset)))
+                    input_offset = input.size();
+                stream.reset();
+            }
+
+            {
+                std::lock_guard lock{state.mutex};
+                state.available = available;
+            }
+            state.data_available.notify_all();
+        }
+
+        if (!member_ended)
+            throw std::runtime_error{"The gzip file is truncated."};
+
+        {
+            std::lock_guard lock{state.mutex};
+            state.finished = true;
+        }
+        state.data_available.notify_all();
+    }
+#endif // PAIRWISE_ALIGNER_HAS_ZLIB
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -0,0 +1,251 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::indexed_sequence_file.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <pairwise_aligner/io/mapped_file.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+//!\brief A sequence of a seqan::pairwise_aligner::indexed_sequence_file together with the owner of its memory.
+struct indexed_sequence
+{
+    std::string_view sequence{}; //!< The symbols of the sequence.
+    //!\brief Keeps a sequence alive that was joined from multiple lines; `nullptr` if it is viewed in the file.
+    std::shared_ptr<void const> owner{};
+};
+
+/**
+ * @brief Provides random access to the sequences of a FASTA file by their name.
+ *
+ * The file is mapped into memory and the sequences are located with the FASTA index `<file>.fai` written by
+ * `samtools faidx`. If the index does not exist, it is built by scanning the file once. A sequence stored in a single
+ * line is viewed directly in the mapped file. A sequence spanning multiple lines is joined once and shared by all
+ * callers until the last of them dropped it, such that a sequence referenced by many pairs is held in memory only once.
+ */
+class indexed_sequence_file
+{
+private:
+    // The location of a sequence in the file.
+    struct entry
+    {
+        std::string_view name{};
+        size_t length{}; // The number of symbols.
+        size_t offset{}; // The offset of the first symbol in the file.
+        size_t byte_size{}; // The number of bytes from the first to the last symbol including the line breaks.
+    };
+
+    mapped_file _file{};
+    std::string _index_content{}; // The content of the index file, which is viewed by the names.
+    std::vector<entry> _entries{};
+    std::unordered_map<std::string_view, size_t> _name_to_index{};
+    std::vector<std::weak_ptr<std::string const>> _joined_sequences{};
+    std::mutex _joined_sequences_mutex{};
+
+public:
+
+    /**
+     * @brief Opens the FASTA file and reads or builds its index.
+     *
+     * @throws std::runtime_error if the file cannot be mapped, the file is not a FASTA file or the index is malformed
+     *                            or does not match the file.
+     */
+    explicit indexed_sequence_file(std::filesystem::path const & file_path) : _file{file_path}
+    {
+        std::filesystem::path index_path = file_path;
+        index_path += ".fai";
+
+        if (std::filesystem::exists(index_path))
+            read_index(index_path);
+        else
+            build_index(file_path);
+
+        for (size_t index = 0; index < _entries.size(); ++index)
+            _name_to_index.emplace(_entries[index].name, index); // The first of duplicated names is used.
+
+        _joined_sequences.resize(_entries.size());
+    }
+
+    indexed_sequence_file(indexed_sequence_file const &) = delete;
+    indexed_sequence_file & operator=(indexed_sequence_file const &) = delete;
+
+    //!\brief Returns the number of sequences.
+    size_t size() const noexcept
+    {
+        return _entries.size();
+    }
+
+    //!\brief Returns the index of the sequence with the given name or `std::nullopt` if there is none.
+    std::optional<size_t> find(std::string_view const name) const
+    {
+        auto it = _name_to_index.find(name);
+        return (it == _name_to_index.end()) ? std::nullopt : std::optional<size_t>{it->second};
+    }
+
+    //!\brief Returns the name of the sequence, i.e. its id up to the first whitespace.
+    std::string_view name(size_t const index) const noexcept
+    {
+        return _entries[index].name;
+    }
+
+    //!\brief Returns the number of symbols of the sequence without loading it.
+    size_t length(size_t const index) const noexcept
+    {
+        return _entries[index].length;
+    }
+
+    /**
+     * @brief Returns the sequence; can be called concurrently.
+     *
+     * The view is valid as long as the file and the returned owner exist.
+     */
+    indexed_sequence sequence(size_t const index)
+    {
+        entry const & location = _entries[index];
+        if (location.byte_size == location.length) // The sequence is stored in a single line.
+            return indexed_sequence{_file.view().substr(location.offset, location.length), nullptr};
+
+        std::lock_guard lock{_joined_sequences_mutex};
+        std::shared_ptr<std::string const> joined_sequence = _joined_sequences[index].lock();
+        if (joined_sequence == nullptr)
+        {
+            std::string symbols{};
+            symbols.reserve(location.length);
+            std::ranges::copy_if(_file.view().substr(location.offset, location.byte_size),
+                                 std::back_inserter(symbols),
+                                 [] (char const symbol) { return symbol != '\n' && symbol != '\r'; });
+
+            joined_sequence = std::make_shared<std::string const>(std::move(symbols));
+            _joined_sequences[index] = joined_sequence;
+        }
+        return indexed_sequence{*joined_sequence, joined_sequence};
+    }
+
+private:
+
+    [[noreturn]] static void throw_malformed_index(std::filesystem::path const & index_path, size_t const line_number)
+    {
+        throw std::runtime_error{"The line " + std::to_string(line_number) + " of the FASTA index " +
+                                 index_path.string() + " is malformed or does not match the FASTA file."};
+    }
+
+    // Reads the tab separated columns name, length, offset, symbols per line and bytes per line.
+    void read_index(std::filesystem::path const & index_path)
+    {
+        mapped_file const index_file{index_path};
+        _index_content.assign(index_file.view());
+
+        std::string_view content{_index_content};
+        for (size_t line_number = 1; !content.empty(); ++line_number)
+        {
+            size_t const line_end = std::min(content.find('\n'), content.size());
+            std::string_view line = content.substr(0, line_end);
+            content.remove_prefix(std::min(line_end + 1, content.size()));
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                continue;
+
+            std::string_view columns[5]{};
+            for (std::string_view & column : columns)
+            {
+                size_t const column_end = std::min(line.find('\t'), line.size());
+                column = line.substr(0, column_end);
+                line.remove_prefix(std::min(column_end + 1, line.size()));
+            }
+
+            auto parse = [&] (std::string_view const column) {
+                size_t value{};
+                auto [end, error] = std::from_chars(column.data(), column.data() + column.size(), value);
+                if (column.empty() || error != std::errc{} || end != column.data() + column.size())
+                    throw_malformed_index(index_path, line_number);
+                return value;
+            };
+
+            entry & location = _entries.emplace_back();
+            location.name = columns[0];
+            location.length = parse(columns[1]);
+            location.offset = parse(columns[2]);
+            size_t const line_symbols = parse(columns[3]);
+            size_t const line_bytes = parse(columns[4]);
+
+            if (location.length > 0)
+            {
+                if (line_symbols == 0 || line_bytes < line_symbols)
+                    throw_malformed_index(index_path, line_number);
+
+                size_t const last_symbol = location.length - 1;
+                location.byte_size = (last_symbol / line_symbols) * line_bytes + last_symbol % line_symbols + 1;
+            }
+
+            if (location.name.empty() || location.offset + location.byte_size > _file.size())
+                throw_malformed_index(index_path, line_number);
+        }
+    }
+
+    // Scans the FASTA file for the headers and the sizes of the sequences.
+    void build_index(std::filesystem::path const & file_path)
+    {
+        std::string_view const content = _file.view();
+        size_t position = content.find_first_not_of("\r\n");
+        if (position != std::string_view::npos && content[position] != '>')
+            throw std::runtime_error{"The file " + file_path.string() + " is not a FASTA file."};
+
+        while (position < content.size())
+        {
+            // The header line starting with '>'.
+            size_t const header_end = std::min(content.find('\n', position), content.size());
+            std::string_view const header = content.substr(position + 1, header_end - position - 1);
+            entry & location = _entries.emplace_back();
+            location.name = header.substr(0, std::min(header.find_first_of(" \t\r"), header.size()));
+            location.offset = std::min(header_end + 1, content.size());
+
+            // The sequence lines until the next header.
+            size_t sequence_end = location.offset;
+            for (position = location.offset; position < content.size() && content[position] != '>';)
+            {
+                size_t const line_end = std::min(content.find('\n', position), content.size());
+                size_t line_size = line_end - position;
+                if (line_size > 0 && content[line_end - 1] == '\r')
+                    --line_size;
+
+                if (line_size > 0)
+                {
+                    location.length += line_size;
+                    sequence_end = position + line_size;
+                }
+                position = line_end + 1;
+            }
+            location.byte_size = sequence_end - location.offset;
+        }
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::mapped_file.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief A file mapped read-only into memory.
+ *
+ * The pages are loaded by the operating system when they are accessed. Readers that consume the file front to back
+ * can release the pages they have passed with seqan::pairwise_aligner::mapped_file::release, such that the resident
+ * memory stays bounded regardless of the file size.
+ */
+class mapped_file
+{
+private:
+    char const * _data{};
+    size_t _size{};
+
+public:
+
+    mapped_file() = default;
+    mapped_file(mapped_file const &) = delete;
+    mapped_file(mapped_file && other) noexcept :
+        _data{std::exchange(other._data, nullptr)},
+        _size{std::exchange(other._size, 0)}
+    {}
+
+    mapped_file & operator=(mapped_file const &) = delete;
+    mapped_file & operator=(mapped_file && other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        if (_data != nullptr)
+            ::munmap(const_cast<char *>(_data), _size);
+    }
+
+    /**
+     * @brief Maps the given file into memory.
+     *
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit mapped_file(std::filesystem::path const & file_path)
+    {
+        int const file_descriptor = ::open(file_path.c_str(), O_RDONLY);
+        if (file_descriptor < 0)
+            throw std::runtime_error{"Could not open the file " + file_path.string() + "."};
+
+        struct ::stat file_status{};
+        if (::fstat(file_descriptor, &file_status) != 0)
+        {
+            ::close(file_descriptor);
+            throw std::runtime_error{"Could not read the size of the file " + file_path.string() + "."};
+        }
+
+        _size = file_status.st_size;
+        if (_size == 0) // Empty files cannot be mapped.
+        {
+            ::close(file_descriptor);
+            return;
+        }
+
+        void * data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        ::close(file_descriptor); // The mapping keeps the file open.
+        if (data == MAP_FAILED)
+        {
+            _size = 0;
+            throw std::runtime_error{"Could not map the file " + file_path.string() + "."};
+        }
+
+        _data = static_cast<char const *>(data);
+    }
+
+    char const * data() const noexcept
+    {
+        return _data;
+    }
+
+    size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    std::string_view view() const noexcept
+    {
+        return std::string_view{_data, _size};
+    }
+
+    //!\brief Hints that the file is read front to back, such that the pages can be read ahead.
+    void advise_sequential() const noexcept
+    {
+        if (_data != nullptr)
+            ::madvise(const_cast<char *>(_data), _size, MADV_SEQUENTIAL);
+    }
+
+    //!\brief Releases the pages before the given offset; they are loaded again if they are accessed later.
+    void release(size_t const offset) const noexcept
+    {
+        size_t const page_size = ::sysconf(_SC_PAGESIZE);
+        size_t const release_size = (std::min(offset, _size) / page_size) * page_size;
+        if (_data != nullptr && release_size > 0)
+            ::madvise(const_cast<char *>(_data), release_size, MADV_DONTNEED);
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
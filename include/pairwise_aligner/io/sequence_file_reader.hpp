@@ -0,0 +1,366 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::sequence_file_reader and seqan::pairwise_aligner::sequence_record_batch.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/io/decompressed_file.hpp>
+#include <pairwise_aligner/io/mapped_file.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+//!\brief The formats read by seqan::pairwise_aligner::sequence_file_reader.
+enum class sequence_file_format
+{
+    fasta,
+    fastq
+};
+
+/**
+ * @brief A batch of records read by seqan::pairwise_aligner::sequence_file_reader.
+ *
+ * The ids, sequences and qualities are views. If a field is stored in a single line, the view refers directly to the
+ * mapped or decompressed file. Fields spanning multiple lines are joined in a buffer of the batch, which is reused for
+ * the next batch. Hence, the views are valid until the next batch is read into the same object or the batch is
+ * destroyed.
+ * The sequences can be passed directly as a bulk to the compute interfaces of the aligners.
+ */
+class sequence_record_batch
+{
+private:
+    friend class sequence_file_reader;
+
+    // A field joined from multiple lines, which is stored at the given position in the buffer.
+    struct buffered_field
+    {
+        std::vector<std::string_view> * fields{};
+        size_t index{};
+        size_t offset{};
+        size_t size{};
+    };
+
+    std::vector<std::string_view> _ids{};
+    std::vector<std::string_view> _sequences{};
+    std::vector<std::string_view> _qualities{};
+    std::vector<char> _buffer{}; // Unlike a std::string, moving the buffer keeps the views valid.
+    std::vector<buffered_field> _buffered_fields{};
+    std::shared_ptr<void const> _lease{}; // Keeps the decompressed data viewed by the batch.
+
+    void clear() noexcept
+    {
+        _lease.reset();
+        _ids.clear();
+        _sequences.clear();
+        _qualities.clear();
+        _buffer.clear();
+        _buffered_fields.clear();
+    }
+
+    // Points the joined fields into the buffer, which does not grow anymore once the batch is complete.
+    void finalise() noexcept
+    {
+        for (buffered_field const & buffered : _buffered_fields)
+            (*buffered.fields)[buffered.index] = std::string_view{_buffer.data() + buffered.offset, buffered.size};
+    }
+
+public:
+
+    sequence_record_batch() = default;
+    sequence_record_batch(sequence_record_batch const &) = delete; // The views might refer to the buffer.
+    sequence_record_batch(sequence_record_batch &&) = default;
+    sequence_record_batch & operator=(sequence_record_batch const &) = delete;
+    sequence_record_batch & operator=(sequence_record_batch &&) = default;
+
+    //!\brief Returns the number of records in the batch.
+    size_t size() const noexcept
+    {
+        return _sequences.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return _sequences.empty();
+    }
+
+    std::span<std::string_view const> ids() const noexcept
+    {
+        return _ids;
+    }
+
+    std::span<std::string_view const> sequences() const noexcept
+    {
+        return _sequences;
+    }
+
+    //!\brief Returns the qualities of the records, which are empty for FASTA files.
+    std::span<std::string_view const> qualities() const noexcept
+    {
+        return _qualities;
+    }
+};
+
+/**
+ * @brief Reads the records of a FASTA or FASTQ file in batches of a fixed size.
+ *
+ * The file is mapped into memory and scanned for the line ends with `std::memchr`, which is vectorised by the
+ * standard library. Records are not copied unless a field spans multiple lines. The pages of the file before the
+ * current batch are released when the next batch is read, such that the resident memory is bounded by the size of
+ * the batches and not by the size of the file. The format is detected from the first symbol of the file.
+ *
+ * Files compressed with gzip or BGZF are detected by their magic bytes and read through a
+ * seqan::pairwise_aligner::decompressed_file, which decompresses ahead of the reader on background threads. The
+ * records are then viewed directly in the decompressed data, which is released once no batch views it anymore.
+ * Choose the bulk size of the aligner as the batch size to obtain batches that fill all lanes of the simd aligners.
+ */
+class sequence_file_reader
+{
+private:
+    mapped_file _file{};
+    decompressed_file _decompressed_file{};
+    bool _is_compressed{false};
+    std::string_view _content{};
+    size_t _position{};
+    size_t _batch_size{};
+    sequence_file_format _format{};
+
+public:
+
+    sequence_file_reader() = default;
+
+    /**
+     * @brief Opens the given FASTA or FASTQ file.
+     *
+     * @param file_path The path to the file, which might be compressed with gzip or BGZF.
+     * @param batch_size The maximal number of records read into one batch.
+     * @param decompression_thread_count The number of threads decompressing a BGZF file.
+     *
+     * @throws std::invalid_argument if the batch size is zero.
+     * @throws std::runtime_error if the file cannot be mapped or decompressed or does not start with a FASTA or
+     *                            FASTQ record.
+     */
+    explicit sequence_file_reader(std::filesystem::path const & file_path,
+                                  size_t const batch_size,
+                                  size_t const decompression_thread_count = 1) :
+        _file{file_path},
+        _content{_file.view()},
+        _batch_size{batch_size}
+    {
+        if (_batch_size == 0)
+            throw std::invalid_argument{"The batch size must be greater than zero."};
+
+        if (decompressed_file::is_compressed(_content))
+        {
+            _decompressed_file = decompressed_file{std::move(_file), decompression_thread_count};
+            _is_compressed = true;
+            _content = _decompressed_file.wait_for(0);
+        }
+
+        skip_empty_lines();
+        if (!at_end())
+        {
+            switch (_content[_position])
+            {
+                case '>': _format = sequence_file_format::fasta; break;
+                case '@': _format = sequence_file_format::fastq; break;
+                default: throw std::runtime_error{"The file " + file_path.string() + " is neither a FASTA nor a "
+                                                  "FASTQ file."};
+            }
+        }
+
+        _file.advise_sequential();
+    }
+
+    sequence_file_format format() const noexcept
+    {
+        return _format;
+    }
+
+    size_t batch_size() const noexcept
+    {
+        return _batch_size;
+    }
+
+    /**
+     * @brief Reads the next records into the given batch.
+     *
+     * @returns `false` if the end of the file was reached before any record was read, `true` otherwise.
+     * @throws std::runtime_error if a record is malformed.
+     */
+    bool read_batch(sequence_record_batch & batch)
+    {
+        batch.clear();
+        skip_empty_lines();
+        if (_is_compressed)
+        {
+            _decompressed_file.release(_position);
+            batch._lease = _decompressed_file.lease(_position);
+        }
+        else
+        {
+            _file.release(_position);
+        }
+
+        while (batch.size() < _batch_size && !at_end())
+        {
+            if (_format == sequence_file_format::fasta)
+                read_fasta_record(batch);
+            else
+                read_fastq_record(batch);
+
+            skip_empty_lines();
+        }
+
+        batch.finalise();
+        return !batch.empty();
+    }
+
+private:
+
+    // Waits for more decompressed data; returns false at the end of the file.
+    bool extend_content()
+    {
+        if (!_is_compressed)
+            return false;
+
+        size_t const size = _content.size();
+        _content = _decompressed_file.wait_for(size + 1);
+        return _content.size() > size;
+    }
+
+    bool at_end()
+    {
+        return _position >= _content.size() && !extend_content();
+    }
+
+    // Returns the next line without the line break and moves behind it.
+    std::string_view next_line()
+    {
+        size_t line_end = _content.find('\n', _position);
+        for (size_t searched_size = _content.size(); line_end == std::string_view::npos && extend_content();)
+        {
+            line_end = _content.find('\n', searched_size);
+            searched_size = _content.size();
+        }
+
+        if (line_end == std::string_view::npos)
+            line_end = _content.size();
+
+        std::string_view line = _content.substr(_position, line_end - _position);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        _position = std::min(line_end + 1, _content.size());
+        return line;
+    }
+
+    void skip_empty_lines()
+    {
+        while (!at_end() && (_content[_position] == '\n' || _content[_position] == '\r'))
+            ++_position;
+    }
+
+    char peek()
+    {
+        return at_end() ? '\0' : _content[_position];
+    }
+
+    std::string_view read_header(char const marker)
+    {
+        std::string_view const line = next_line();
+        if (line.empty() || line.front() != marker)
+            throw_malformed_record();
+
+        return line.substr(1);
+    }
+
+    // Reads the lines of a field until the predicate is satisfied by the number of lines and the size of the field.
+    // Returns the size of the field, as the view of a field joined from multiple lines is set only later.
+    template <typename is_complete_t>
+    size_t read_field(sequence_record_batch & batch,
+                      std::vector<std::string_view> & fields,
+                      is_complete_t && is_complete)
+    {
+        size_t const buffer_offset = batch._buffer.size();
+        std::string_view field{};
+        size_t field_size = 0;
+        size_t line_count = 0;
+        for (; !at_end() && !is_complete(line_count, field_size); ++line_count)
+        {
+            std::string_view const line = next_line();
+            if (line_count == 0)
+                field = line;
+            else if (line_count == 1)
+                batch._buffer.insert(batch._buffer.end(), field.begin(), field.end());
+
+            if (line_count > 0)
+                batch._buffer.insert(batch._buffer.end(), line.begin(), line.end());
+
+            field_size += line.size();
+        }
+
+        if (line_count > 1) // The view is set when the buffer does not grow anymore; see finalise.
+            batch._buffered_fields.push_back({&fields, fields.size(), buffer_offset, field_size});
+
+        fields.push_back(field);
+        return field_size;
+    }
+
+    void read_fasta_record(sequence_record_batch & batch)
+    {
+        batch._ids.push_back(read_header('>'));
+        batch._qualities.emplace_back();
+        read_field(batch, batch._sequences, [this] (size_t, size_t) { return peek() == '>'; });
+    }
+
+    void read_fastq_record(sequence_record_batch & batch)
+    {
+        batch._ids.push_back(read_header('@'));
+        size_t const sequence_size = read_field(batch, batch._sequences, [this] (size_t, size_t) {
+            return peek() == '+';
+        });
+
+        if (peek() != '+')
+            throw_malformed_record();
+        next_line();
+
+        // The quality might start with '@' or '+', hence its end is determined by the size of the sequence.
+        auto is_complete = [=] (size_t const line_count, size_t const quality_size) {
+            return line_count > 0 && quality_size >= sequence_size;
+        };
+        size_t const quality_size = read_field(batch, batch._qualities, is_complete);
+
+        if (quality_size != sequence_size)
+            throw_malformed_record();
+    }
+
+    [[noreturn]] void throw_malformed_record() const
+    {
+        throw std::runtime_error{"The record ending at byte " + std::to_string(_position) + " of the " +
+                                 ((_format == sequence_file_format::fasta) ? "FASTA" : "FASTQ") +
+                                 " file is malformed."};
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -106,11 +106,20 @@ protected:
 
     void reset(score_t const & new_offset) noexcept
     {
-        for (size_t i = 0; i < size(); ++i)
-            std::apply([&] (auto & ...values) {
-                ((values -= new_offset), ...);
-                ((values += _dp_vector.saturated_zero_offset()), ...);
-            }, range()[i]);
+        if constexpr (requires (range_type & dp_vector) { dp_vector.plane(0); }) {
+            // Structure-of-arrays layout: rebase every array of the cell values contiguously.
+            for (size_t plane_idx = 0; plane_idx < range_type::plane_count; ++plane_idx)
+                for (score_t & value : range().plane(plane_idx)) {
+                    value -= new_offset;
+                    value += _dp_vector.saturated_zero_offset();
+                }
+        } else {
+            for (size_t i = 0; i < size(); ++i)
+                std::apply([&] (auto & ...values) {
+                    ((values -= new_offset), ...);
+                    ((values += _dp_vector.saturated_zero_offset()), ...);
+                }, range()[i]);
+        }
     }
 
     constexpr bool check_saturated_arithmetic(score_t const & new_offset) const noexcept
@@ -14,7 +14,7 @@
 
 #include <type_traits>
 
-#include <pairwise_aligner/simd/simd_base.hpp>
+#include <pairwise_aligner/utility/tuning_profile.hpp>
 
 namespace seqan::pairwise_aligner
 {
@@ -25,7 +25,7 @@ namespace dp_matrix {
 template <std::size_t width>
 using lane_width_t = std::integral_constant<std::size_t, width>;
 
-template <std::size_t width = (seqan::pairwise_aligner::detail::max_simd_size == 64 ? 8 : 4)>
+template <std::size_t width = tuning::profile::lane_width>
 inline constexpr lane_width_t<width> lane_width;
 
 namespace detail {
@@ -45,7 +45,7 @@ inline constexpr lane_tag<width_t, true> dynamic_lane{};
 } // mamespace detail
 } // namespace dp_matrix
 
-template <size_t width = ((seqan::pairwise_aligner::detail::max_simd_size == 64) ? 8 : 4)>
+template <size_t width = tuning::profile::lane_width>
 struct lane_width_policy
 {
     constexpr dp_matrix::lane_width_t<width> make_lane_width() const noexcept
@@ -14,10 +14,16 @@
 
 #include <algorithm>
 #include <ranges>
+#include <span>
+#include <vector>
+
 #include <seqan3/utility/container/aligned_allocator.hpp>
 #include <seqan3/utility/simd/views/to_simd.hpp>
 #include <seqan3/alphabet/adaptation/char.hpp>
 
+#include <pairwise_aligner/sequence/packed_dna_sequence.hpp>
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
+
 namespace seqan::pairwise_aligner
 {
 inline namespace v1
@@ -28,9 +34,12 @@ class dp_vector_bulk
 private:
     using scalar_t = typename simd_t::value_type;
     using native_simd_t = typename simd_t::simd_type::value_type;
+    using simd_sequence_t = std::vector<simd_t, seqan3::aligned_allocator<simd_t, alignof(simd_t)>>;
 
     dp_vector_t _dp_vector{};
     scalar_t _padding_symbol{};
+    // The transposed sequences, which are kept to reuse the memory when initialised again.
+    simd_sequence_t _simd_sequence{};
 
 public:
 
@@ -83,23 +92,61 @@ public:
     template <std::ranges::forward_range sequence_collection_t, typename initialisation_strategy_t>
     auto initialise(sequence_collection_t && sequence_collection, initialisation_strategy_t && init_strategy)
     {
-        size_t max_sequence_size = 0;
+        transpose(sequence_collection, _simd_sequence);
+        return _dp_vector.initialise(std::span{_simd_sequence}, std::forward<initialisation_strategy_t>(init_strategy));
+    }
+
+    // The batch was prepared by this dp vector, such that its symbols are passed to the innermost dp vector.
+    template <sequence_batch_range sequence_collection_t, typename initialisation_strategy_t>
+    auto initialise(sequence_collection_t && sequence_collection, initialisation_strategy_t && init_strategy)
+    {
+        return _dp_vector.initialise(sequence_collection.symbols(),
+                                     std::forward<initialisation_strategy_t>(init_strategy));
+    }
 
+    //!\brief Transposes and transforms the given sequences into a seqan::pairwise_aligner::sequence_batch.
+    template <std::ranges::forward_range sequence_collection_t>
+    auto prepare(sequence_collection_t && sequence_collection) const
+    {
+        std::vector<size_t> sequence_sizes{};
         std::ranges::for_each(sequence_collection, [&] (auto && sequence) {
-            max_sequence_size = std::max<size_t>(max_sequence_size, std::ranges::distance(sequence));
+            sequence_sizes.push_back(std::ranges::distance(sequence));
         });
 
-        std::vector<simd_t, seqan3::aligned_allocator<simd_t, alignof(simd_t)>> simd_sequence{};
-        simd_sequence.reserve(max_sequence_size);
+        simd_sequence_t simd_sequence{};
+        transpose(sequence_collection, simd_sequence);
+
+        auto symbols = detail::prepare_sequence(_dp_vector, std::move(simd_sequence));
+        using symbol_t = std::ranges::range_value_t<decltype(symbols)>;
+        return sequence_batch<symbol_t>{std::move(symbols), sequence_sizes};
+    }
+
+private:
+
+    template <typename sequence_collection_t>
+    void transpose(sequence_collection_t && sequence_collection, simd_sequence_t & simd_sequence) const
+    {
+        if constexpr (packed_dna_collection<sequence_collection_t>) {
+            // Decode the packed sequences while transposing them instead of transposing the decoded symbols.
+            detail::unpack_and_transpose<simd_t>(sequence_collection, _padding_symbol, simd_sequence);
+        } else {
+            size_t max_sequence_size = 0;
+
+            std::ranges::for_each(sequence_collection, [&] (auto && sequence) {
+                max_sequence_size = std::max<size_t>(max_sequence_size, std::ranges::distance(sequence));
+            });
+
+            simd_sequence.clear();
+            simd_sequence.reserve(max_sequence_size);
 
-        auto simd_view = sequence_collection | seqan3::views::to_simd<native_simd_t>(_padding_symbol);
+            auto simd_view = sequence_collection | seqan3::views::to_simd<native_simd_t>(_padding_symbol);
 
-        for (auto && simd_vector_chunk : simd_view) {
-            for (auto && simd_vector : simd_vector_chunk) {
-                simd_sequence.emplace_back(std::move(simd_vector));
+            for (auto && simd_vector_chunk : simd_view) {
+                for (auto && simd_vector : simd_vector_chunk) {
+                    simd_sequence.emplace_back(std::move(simd_vector));
+                }
             }
         }
-        return _dp_vector.initialise(std::move(simd_sequence), std::forward<initialisation_strategy_t>(init_strategy));
     }
 };
 
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <ranges>
 #include <span>
+#include <vector>
 
 namespace seqan::pairwise_aligner
 {
@@ -26,18 +27,21 @@ class dp_vector_chunk
 {
 private:
 
+    // Chunks beyond the current chunk count are kept to reuse their memory when initialised again.
     std::vector<dp_vector_t> _dp_vector_chunks{};
+    size_t _chunk_count{};
     size_t _chunk_size{};
 
 public:
 
-    using range_type = std::vector<dp_vector_t>;
+    using range_type = std::span<dp_vector_t>;
     using value_type = std::ranges::range_value_t<range_type>;
     using reference = std::ranges::range_reference_t<range_type>;
-    using const_reference = std::ranges::range_reference_t<range_type const>;
+    using const_reference = dp_vector_t const &;
 
     explicit dp_vector_chunk(dp_vector_t && dp_vector, size_t const chunk_size) noexcept :
         _dp_vector_chunks{1, std::move(dp_vector)},
+        _chunk_count{1},
         _chunk_size{chunk_size}
     {}
 
@@ -53,7 +57,7 @@ public:
 
     constexpr size_t size() const noexcept
     {
-        return _dp_vector_chunks.size();
+        return _chunk_count;
     }
 
     constexpr size_t chunk_size() const noexcept
@@ -61,14 +65,14 @@ public:
         return _chunk_size;
     }
 
-    range_type & range() noexcept
+    range_type range() noexcept
     {
-        return _dp_vector_chunks;
+        return range_type{_dp_vector_chunks.data(), _chunk_count};
     }
 
-    range_type const & range() const noexcept
+    std::span<dp_vector_t const> range() const noexcept
     {
-        return _dp_vector_chunks;
+        return std::span<dp_vector_t const>{_dp_vector_chunks.data(), _chunk_count};
     }
 
     // initialisation interface
@@ -107,9 +111,12 @@ public:
         size_t const chunk_size = std::min(sequence_size, _chunk_size);
         size_t const element_count = (chunk_size > 0) ? (sequence_size + chunk_size - 1) / chunk_size : 1;
 
-        _dp_vector_chunks.resize(element_count, _dp_vector_chunks.front());
+        if (element_count > _dp_vector_chunks.size())
+            _dp_vector_chunks.resize(element_count, _dp_vector_chunks.front());
 
-        for (size_t i = 0; i < _dp_vector_chunks.size(); ++i)
+        _chunk_count = element_count;
+
+        for (size_t i = 0; i < _chunk_count; ++i)
         {
             size_t const first = i * chunk_size;
             size_t const last = (i + 1) * chunk_size;
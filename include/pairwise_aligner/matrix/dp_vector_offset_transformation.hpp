@@ -17,6 +17,8 @@
 
 #include <seqan3/utility/container/aligned_allocator.hpp>
 
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
+
 namespace seqan::pairwise_aligner
 {
 inline namespace v1
@@ -78,9 +80,32 @@ public:
 
     template <std::ranges::forward_range sequence_t, typename initialisation_strategy_t>
     auto initialise(sequence_t && sequence, initialisation_strategy_t && init_strategy)
+    {
+        return _dp_vector.initialise(transform(std::forward<sequence_t>(sequence)),
+                                     std::forward<initialisation_strategy_t>(init_strategy));
+    }
+
+    template <prepared_sequence_range sequence_t, typename initialisation_strategy_t>
+    auto initialise(sequence_t && sequence, initialisation_strategy_t && init_strategy)
+    {
+        return _dp_vector.initialise(std::forward<sequence_t>(sequence),
+                                     std::forward<initialisation_strategy_t>(init_strategy));
+    }
+
+    //!\brief Computes the offsets of the given sequence and applies the transformations of the wrapped dp vector.
+    template <std::ranges::forward_range sequence_t>
+    auto prepare(sequence_t && sequence) const
+    {
+        return detail::prepare_sequence(_dp_vector, transform(std::forward<sequence_t>(sequence)));
+    }
+
+private:
+
+    template <typename sequence_t>
+    auto transform(sequence_t && sequence) const
     {
         // expect simd range!
-        using offset_t = std::invoke_result_t<offset_fn_t, std::ranges::range_rvalue_reference_t<sequence_t>>;
+        using offset_t = std::invoke_result_t<offset_fn_t const &, std::ranges::range_rvalue_reference_t<sequence_t>>;
 
         std::vector<offset_t, seqan3::aligned_allocator<offset_t, alignof(offset_t)>> offset_sequence{};
         offset_sequence.resize(std::ranges::distance(sequence));
@@ -88,8 +113,7 @@ public:
             return _offset_fn(std::move(symbol));
         }), offset_sequence.begin());
 
-        return _dp_vector.initialise(std::move(offset_sequence),
-                                     std::forward<initialisation_strategy_t>(init_strategy));
+        return offset_sequence;
     }
 };
 
@@ -14,9 +14,13 @@
 
 #include <algorithm>
 #include <ranges>
+#include <span>
+#include <vector>
 
 #include <seqan3/utility/container/aligned_allocator.hpp>
 
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
+
 namespace seqan::pairwise_aligner
 {
 inline namespace v1
@@ -25,10 +29,12 @@ template <typename dp_vector_t, typename rank_map_t>
 class dp_vector_rank_transformation
 {
 private:
+    using rank_t = typename rank_map_t::value_type;
+
     dp_vector_t _dp_vector{};
     rank_map_t _rank_map{};
-
-    using rank_t = typename rank_map_t::value_type;
+    // The rank sequence, which is kept to reuse the memory when initialised again.
+    std::vector<rank_t, seqan3::aligned_allocator<rank_t, alignof(rank_t)>> _rank_sequence{};
 
     static constexpr bool is_simd_rank_v = !std::integral<rank_t>;
 
@@ -83,26 +89,26 @@ public:
     template <std::ranges::forward_range sequence_t, typename initialisation_strategy_t>
     auto initialise(sequence_t && sequence, initialisation_strategy_t && init_strategy)
     {
-        std::vector<rank_t, seqan3::aligned_allocator<rank_t, alignof(rank_t)>> rank_sequence{};
-        rank_sequence.resize(std::ranges::distance(sequence));
+        _rank_sequence.resize(std::ranges::distance(sequence));
         std::ranges::copy(sequence | std::views::transform([&] (auto const & symbol) -> rank_t {
             return _rank_map[symbol];
-        }), rank_sequence.begin());
+        }), _rank_sequence.begin());
 
-        return _dp_vector.initialise(std::move(rank_sequence), std::forward<initialisation_strategy_t>(init_strategy));
+        return _dp_vector.initialise(std::span{_rank_sequence}, std::forward<initialisation_strategy_t>(init_strategy));
     }
 
     template <std::ranges::forward_range sequence_t, typename initialisation_strategy_t>
-        requires (is_simd_rank_v && std::integral<std::ranges::range_value_t<sequence_t>>)
+        requires (is_simd_rank_v && std::integral<std::ranges::range_value_t<sequence_t>> &&
+                  !prepared_sequence_range<sequence_t>)
     auto initialise(sequence_t && sequence, initialisation_strategy_t && init_strategy)
     {
         using scalar_rank_t = typename rank_t::value_type;
-        // Load the sequence into a single vector of simd values.
+        // Load the sequence into a single vector of simd values, which is then read as sequence of scalar ranks.
         std::ptrdiff_t sequence_size = std::ranges::distance(sequence);
-        std::vector<scalar_rank_t> rank_sequence{};
         std::ptrdiff_t max_size = (sequence_size - 1 + rank_t::size_v) / rank_t::size_v;
-        rank_sequence.reserve(max_size * rank_t::size_v);
-        rank_sequence.resize(sequence_size);
+        _rank_sequence.resize(max_size);
+        std::span<scalar_rank_t> rank_sequence{reinterpret_cast<scalar_rank_t *>(_rank_sequence.data()),
+                                               static_cast<size_t>(sequence_size)};
 
         if constexpr (std::ranges::contiguous_range<sequence_t>) {
             std::ranges::for_each(std::views::iota(0, max_size), [&] (std::ptrdiff_t i) {
@@ -128,6 +134,26 @@ public:
 
         return _dp_vector.initialise(std::move(rank_sequence), std::forward<initialisation_strategy_t>(init_strategy));
     }
+
+    template <prepared_sequence_range sequence_t, typename initialisation_strategy_t>
+    auto initialise(sequence_t && sequence, initialisation_strategy_t && init_strategy)
+    {
+        return _dp_vector.initialise(std::forward<sequence_t>(sequence),
+                                     std::forward<initialisation_strategy_t>(init_strategy));
+    }
+
+    //!\brief Converts the symbols of the given sequence and applies the transformations of the wrapped dp vector.
+    template <std::ranges::forward_range sequence_t>
+    auto prepare(sequence_t && sequence) const
+    {
+        std::vector<rank_t, seqan3::aligned_allocator<rank_t, alignof(rank_t)>> rank_sequence{};
+        rank_sequence.resize(std::ranges::distance(sequence));
+        std::ranges::copy(sequence | std::views::transform([&] (auto const & symbol) -> rank_t {
+            return _rank_map[symbol];
+        }), rank_sequence.begin());
+
+        return detail::prepare_sequence(_dp_vector, std::move(rank_sequence));
+    }
 };
 
 namespace detail
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <ranges>
+#include <tuple>
 #include <type_traits>
 
 #include <pairwise_aligner/simd/simd_base.hpp>
@@ -52,25 +53,24 @@ private:
             _regular_offset{offset}
         {}
 
-        _proxy & operator=(_proxy other) noexcept
+        // Assigns the values of the referenced cell, which might be a proxy itself, e.g. in structure-of-arrays layout.
+        _proxy & operator=(_proxy const & other) noexcept
         {
-            using std::swap;
-            swap(_saturated_value, other._saturated_value);
+            _saturated_value = static_cast<value_type>(other._saturated_value);
             return *this;
         }
 
         // assignable from actual type.
-        _proxy & operator=(value_type cell) noexcept
+        _proxy & operator=(value_type const & cell) noexcept
         {
-            using std::swap;
-            swap(_saturated_value, cell);
+            _saturated_value = cell;
             return *this;
         }
 
         // TODO: cast into original cell type
         constexpr operator regular_cell_t() const noexcept
         {
-            regular_cell_t cell{_saturated_value};
+            regular_cell_t cell{static_cast<value_type>(_saturated_value)};
             std::apply([this] (auto & ...values) { ((values += _regular_offset), ...); }, cell);
             return cell;
         }
@@ -133,14 +133,14 @@ public:
 
     decltype(auto) range() noexcept
     {
-        return _dp_vector.range() | std::views::transform([this] (auto & cell) {
+        return _dp_vector.range() | std::views::transform([this] (auto && cell) {
             return reference{cell, _regular_offset};
         });
     }
 
     decltype(auto) range() const noexcept
     {
-        return _dp_vector.range() | std::views::transform([this] (auto const & cell) {
+        return _dp_vector.range() | std::views::transform([this] (auto && cell) {
             return const_reference{cell, _regular_offset};
         });
     }
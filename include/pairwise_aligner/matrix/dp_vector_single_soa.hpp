@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::dp_vector_single_soa.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+template <typename dp_cell_t>
+class dp_vector_single_soa;
+
+namespace detail
+{
+
+/**
+ * @brief The proxy referencing a cell of the seqan::pairwise_aligner::dp_vector_single_soa.
+ *
+ * Behaves like a reference to the cell and implements the tuple protocol over references to its values, such that
+ * the values can be accessed with `get` and structured bindings.
+ *
+ * @tparam dp_cell_t The type of the cell.
+ * @tparam is_const Whether the proxy references a constant cell.
+ */
+template <typename dp_cell_t, bool is_const>
+class dp_vector_single_soa_proxy
+{
+private:
+
+    using vector_t = std::conditional_t<is_const,
+                                        dp_vector_single_soa<dp_cell_t> const,
+                                        dp_vector_single_soa<dp_cell_t>>;
+    using score_t = typename dp_cell_t::score_type;
+    using score_reference_t = std::conditional_t<is_const, score_t const &, score_t &>;
+
+    static constexpr size_t plane_count_v = std::tuple_size_v<dp_cell_t>;
+
+    vector_t * _dp_vector{};
+    size_t _position{};
+
+public:
+
+    using value_type = dp_cell_t;
+    using score_type = score_t;
+
+    dp_vector_single_soa_proxy() = delete;
+    explicit dp_vector_single_soa_proxy(vector_t & dp_vector, size_t const position) noexcept :
+        _dp_vector{std::addressof(dp_vector)},
+        _position{position}
+    {}
+
+    dp_vector_single_soa_proxy(dp_vector_single_soa_proxy const &) = default;
+
+    // Assigns the values of the referenced cell and not the position.
+    dp_vector_single_soa_proxy & operator=(dp_vector_single_soa_proxy const & other) noexcept
+    {
+        return *this = static_cast<value_type>(other);
+    }
+
+    dp_vector_single_soa_proxy & operator=(value_type const & cell) noexcept
+    {
+        std::apply([this] (auto const & ...values) {
+            size_t plane_idx{};
+            ((value_at(plane_idx++) = values), ...);
+        }, cell);
+        return *this;
+    }
+
+    constexpr operator value_type() const noexcept
+    {
+        return make_cell(std::make_index_sequence<plane_count_v>());
+    }
+
+    constexpr score_reference_t score() const noexcept
+    {
+        return get<0>(*this);
+    }
+
+    template <size_t plane_idx>
+        requires (plane_idx < plane_count_v)
+    friend constexpr score_reference_t get(dp_vector_single_soa_proxy const & proxy) noexcept
+    {
+        return proxy.value_at(plane_idx);
+    }
+
+    friend void swap(dp_vector_single_soa_proxy lhs, dp_vector_single_soa_proxy rhs) noexcept
+    {
+        value_type tmp = lhs;
+        lhs = static_cast<value_type>(rhs);
+        rhs = tmp;
+    }
+
+    friend void swap(dp_vector_single_soa_proxy lhs, value_type & cell) noexcept
+    {
+        value_type tmp = lhs;
+        lhs = cell;
+        cell = std::move(tmp);
+    }
+
+private:
+
+    constexpr score_reference_t value_at(size_t const plane_idx) const noexcept
+    {
+        return _dp_vector->plane(plane_idx)[_position];
+    }
+
+    template <size_t ...plane_idx>
+    constexpr value_type make_cell(std::index_sequence<plane_idx...> const &) const noexcept
+    {
+        return value_type{value_at(plane_idx)...};
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A dp vector storing the cells in structure-of-arrays layout.
+ *
+ * Stores every value of the cells in a separate array, i.e. for the affine cell one array with the best scores
+ * followed by one array with the gap scores. The elements are accessed through a proxy, which behaves like the
+ * cell of the dp_vector_single. Operations that only read the best scores, e.g. the search for the maximal score in
+ * the last column and row, touch only the first array.
+ *
+ * @tparam dp_cell_t The type of the cell; must be a tuple-like type over dp_cell_t::score_type.
+ */
+template <typename dp_cell_t>
+class dp_vector_single_soa
+{
+private:
+
+    using score_t = typename dp_cell_t::score_type;
+    using plane_t = std::vector<score_t>;
+
+    static constexpr size_t plane_count_v = std::tuple_size_v<dp_cell_t>;
+
+    template <bool is_const>
+    using _proxy = detail::dp_vector_single_soa_proxy<dp_cell_t, is_const>;
+
+    template <bool is_const>
+    struct _at
+    {
+        std::conditional_t<is_const, dp_vector_single_soa const, dp_vector_single_soa> * _dp_vector;
+
+        constexpr _proxy<is_const> operator()(size_t const pos) const noexcept
+        {
+            return (*_dp_vector)[pos];
+        }
+    };
+
+    std::array<plane_t, plane_count_v> _planes{};
+
+public:
+
+    using value_type = dp_cell_t;
+    using reference = _proxy<false>;
+    using const_reference = _proxy<true>;
+    using range_type = std::ranges::transform_view<std::ranges::iota_view<size_t, size_t>, _at<false>>;
+
+    static constexpr size_t plane_count = plane_count_v;
+
+    reference operator[](size_t const pos) noexcept
+    {
+        return reference{*this, pos};
+    }
+
+    const_reference operator[](size_t const pos) const noexcept
+    {
+        return const_reference{*this, pos};
+    }
+
+    constexpr size_t size() const noexcept
+    {
+        return _planes[0].size();
+    }
+
+    range_type range() noexcept
+    {
+        return range_type{std::views::iota(size_t{0}, size()), _at<false>{this}};
+    }
+
+    auto range() const noexcept
+    {
+        return std::views::iota(size_t{0}, size()) | std::views::transform(_at<true>{this});
+    }
+
+    //!\brief Returns the contiguous array storing the values at the given position of all cells.
+    std::span<score_t> plane(size_t const plane_idx) noexcept
+    {
+        return std::span{_planes[plane_idx]};
+    }
+
+    //!\copydoc plane
+    std::span<score_t const> plane(size_t const plane_idx) const noexcept
+    {
+        return std::span{_planes[plane_idx]};
+    }
+
+    // initialisation interface
+
+    template <std::ranges::forward_range sequence_t, typename initialisation_strategy_t>
+    sequence_t initialise(sequence_t && sequence, initialisation_strategy_t && init_factory)
+    {
+        size_t const sequence_size = std::ranges::distance(sequence);
+        for (plane_t & plane : _planes)
+            plane.resize(sequence_size + 1);
+
+        auto generator = init_factory.template create<score_t>();
+        for (size_t index = 0; index < size(); ++index)
+            (*this)[index] = value_type{generator(index)};
+
+        return sequence;
+    }
+};
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
+
+namespace std
+{
+
+template <typename dp_cell_t, bool is_const>
+struct tuple_size<seqan::pairwise_aligner::detail::dp_vector_single_soa_proxy<dp_cell_t, is_const>> :
+    tuple_size<dp_cell_t>
+{};
+
+template <size_t idx, typename dp_cell_t, bool is_const>
+struct tuple_element<idx, seqan::pairwise_aligner::detail::dp_vector_single_soa_proxy<dp_cell_t, is_const>>
+{
+    using type = decltype(get<idx>(
+        std::declval<seqan::pairwise_aligner::detail::dp_vector_single_soa_proxy<dp_cell_t, is_const> const &>()));
+};
+
+} // namespace std
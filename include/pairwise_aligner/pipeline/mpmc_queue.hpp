@@ -0,0 +1,144 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::mpmc_queue.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <pairwise_aligner/pipeline/spsc_queue.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief A lock-free bounded queue for any number of producing and consuming threads.
+ *
+ * Every slot of the ring buffer carries a sequence number, which tells whether the slot can be written or read in
+ * the current round. Producers and consumers claim positions with a compare-and-swap on the tail or the head and
+ * then access only the claimed slot, such that there is no contention between producers and consumers unless the
+ * queue is full or empty. The capacity is rounded up to the next power of two, which is at least two.
+ *
+ * @tparam value_t The type of the values; must be move constructible.
+ */
+template <typename value_t>
+class mpmc_queue
+{
+private:
+    struct slot
+    {
+        std::atomic<size_t> sequence{};
+        std::optional<value_t> value{};
+    };
+
+    std::unique_ptr<slot[]> _slots;
+    size_t _mask{};
+
+    alignas(detail::cache_line_size) std::atomic<size_t> _head{0}; // The next position to pop.
+    alignas(detail::cache_line_size) std::atomic<size_t> _tail{0}; // The next position to push.
+
+public:
+
+    //!\brief Whether multiple threads can push concurrently.
+    static constexpr bool is_multi_producer = true;
+    //!\brief Whether multiple threads can pop concurrently.
+    static constexpr bool is_multi_consumer = true;
+
+    explicit mpmc_queue(size_t const capacity) :
+        _slots{std::make_unique<slot[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))},
+        _mask{std::bit_ceil(std::max<size_t>(capacity, 2)) - 1}
+    {
+        for (size_t position = 0; position <= _mask; ++position)
+            _slots[position].sequence.store(position, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(mpmc_queue const &) = delete;
+    mpmc_queue & operator=(mpmc_queue const &) = delete;
+
+    //!\brief Returns the number of values the queue can hold.
+    size_t capacity() const noexcept
+    {
+        return _mask + 1;
+    }
+
+    //!\brief Moves the value into the queue and returns `true`, or leaves it unchanged and returns `false` if full.
+    bool try_push(value_t & value)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot & current = _slots[tail & _mask];
+            size_t const sequence = current.sequence.load(std::memory_order_acquire);
+            intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(tail);
+
+            if (difference == 0) // The slot is free in this round.
+            {
+                if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                {
+                    current.value.emplace(std::move(value));
+                    current.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) // The slot still holds the value of the previous round.
+            {
+                return false;
+            }
+            else // Another producer claimed the position.
+            {
+                tail = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //!\brief Removes the first value, or returns `std::nullopt` if the queue is empty.
+    std::optional<value_t> try_pop()
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot & current = _slots[head & _mask];
+            size_t const sequence = current.sequence.load(std::memory_order_acquire);
+            intptr_t const difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head + 1);
+
+            if (difference == 0) // The slot was written in this round.
+            {
+                if (_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+                {
+                    std::optional<value_t> value{std::move(current.value)};
+                    current.value.reset();
+                    current.sequence.store(head + capacity(), std::memory_order_release);
+                    return value;
+                }
+            }
+            else if (difference < 0) // The slot was not written yet.
+            {
+                return std::nullopt;
+            }
+            else // Another consumer claimed the position.
+            {
+                head = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -0,0 +1,372 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::pipeline.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/pipeline/pipeline_channel.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+//!\brief The counters of one stage of a seqan::pairwise_aligner::pipeline, which are summed over its threads.
+struct pipeline_stage_statistics
+{
+    std::string name{}; //!< The name of the stage.
+    size_t thread_count{}; //!< The number of threads running the stage.
+    size_t item_count{}; //!< The number of items produced by the stage.
+    double busy_seconds{}; //!< The time spent processing the items.
+    double input_wait_seconds{}; //!< The time spent waiting for items of the previous stage.
+    double output_wait_seconds{}; //!< The time spent waiting for the next stage to accept the items.
+
+    /**
+     * @brief Returns the number of items the stage can process per second if it never waits.
+     *
+     * The stage with the lowest throughput limits the whole pipeline; adding threads to it or speeding it up
+     * increases the throughput of the pipeline, while the other stages spend the difference waiting.
+     */
+    double items_per_second() const noexcept
+    {
+        return (busy_seconds > 0) ? item_count * thread_count / busy_seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Runs the stages of a streaming computation on dedicated threads connected by bounded channels.
+ *
+ * A pipeline consists of one or more sources producing items, stages transforming the items of their input channel
+ * into the items of their output channel and sinks consuming the items. Every stage runs on its own threads, such
+ * that e.g. reading, preparing, aligning and writing overlap. The bounded channels apply back-pressure: a stage that
+ * is faster than the stages behind it waits until they have caught up, which bounds the number of items in flight.
+ *
+ * If a stage throws, all channels are cancelled, such that the remaining stages stop, and run() rethrows the first
+ * exception. The pipeline measures for every stage the time spent processing and waiting, which identifies the stage
+ * limiting the throughput.
+ *
+ * ### Example
+ *
+ * ```cpp
+ * pipeline_channel<int> numbers{16};
+ * spsc_channel<int> squares{16};
+ * pipeline pipe{};
+ * pipe.add_source("count", numbers, [] (auto emit) { for (int i = 0; i < 100 && emit(i); ++i) {} });
+ * pipe.add_stage("square", 4, numbers, squares, [] () { return [] (int i) { return i * i; }; });
+ * pipe.add_sink("print", squares, [] (int square) { std::cout << square << '\n'; });
+ * pipe.run();
+ * ```
+ */
+class pipeline
+{
+private:
+    using clock_t = std::chrono::steady_clock;
+
+    // The counters of one stage, which are accumulated by its threads.
+    struct stage_counters
+    {
+        std::string name{};
+        size_t thread_count{};
+        std::atomic<uint64_t> item_count{};
+        std::atomic<uint64_t> busy_nanoseconds{};
+        std::atomic<uint64_t> input_wait_nanoseconds{};
+        std::atomic<uint64_t> output_wait_nanoseconds{};
+    };
+
+    // The time measured by one thread, which is added to the counters of the stage when the thread finishes.
+    struct thread_timer
+    {
+        stage_counters & counters;
+        clock_t::time_point start{clock_t::now()};
+        clock_t::duration input_wait{};
+        clock_t::duration output_wait{};
+        uint64_t item_count{};
+
+        template <typename operation_t>
+        decltype(auto) measure(clock_t::duration & wait, operation_t && operation)
+        {
+            clock_t::time_point const wait_start = clock_t::now();
+            struct add_on_exit
+            {
+                clock_t::duration & wait;
+                clock_t::time_point wait_start;
+                ~add_on_exit() { wait += clock_t::now() - wait_start; }
+            } guard{wait, wait_start};
+            return operation();
+        }
+
+        ~thread_timer()
+        {
+            auto nanoseconds = [] (clock_t::duration const duration) -> uint64_t {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            };
+
+            clock_t::duration const total = clock_t::now() - start;
+            counters.item_count.fetch_add(item_count, std::memory_order_relaxed);
+            counters.input_wait_nanoseconds.fetch_add(nanoseconds(input_wait), std::memory_order_relaxed);
+            counters.output_wait_nanoseconds.fetch_add(nanoseconds(output_wait), std::memory_order_relaxed);
+            counters.busy_nanoseconds.fetch_add(nanoseconds(total - input_wait - output_wait),
+                                                std::memory_order_relaxed);
+        }
+    };
+
+    std::deque<stage_counters> _counters{}; // A deque keeps the counters at their address while stages are added.
+    std::vector<std::function<void()>> _threads{};
+    std::vector<std::function<void()>> _cancel_channels{};
+    std::exception_ptr _first_error{};
+    std::mutex _error_mutex{};
+    std::atomic<bool> _cancelled{false};
+    bool _started{false};
+
+public:
+
+    pipeline() = default;
+    pipeline(pipeline const &) = delete;
+    pipeline & operator=(pipeline const &) = delete;
+
+    /**
+     * @brief Adds a stage producing the items of the output channel.
+     *
+     * @param name The name of the stage in the statistics.
+     * @param output The channel receiving the items.
+     * @param source The callable producing the items; it is called once with a callable `emit`, which pushes an item
+     *               into the output channel and returns `false` if the pipeline was cancelled. The source should stop
+     *               producing items in this case.
+     */
+    template <typename channel_t, typename source_t>
+    void add_source(std::string name, channel_t & output, source_t source)
+    {
+        register_channel(output);
+        output.add_producer();
+
+        stage_counters & counters = add_counters(std::move(name), 1);
+        _threads.push_back([this, &counters, &output, source = std::move(source)] () mutable {
+            try
+            {
+                thread_timer timer{counters};
+                auto emit = [&] (typename channel_t::value_type item) {
+                    bool const pushed = timer.measure(timer.output_wait, [&] () {
+                        return output.push(std::move(item));
+                    });
+                    timer.item_count += pushed;
+                    return pushed;
+                };
+                source(emit);
+            }
+            catch (...)
+            {
+                cancel(std::current_exception());
+            }
+            output.remove_producer();
+        });
+    }
+
+    /**
+     * @brief Adds a stage transforming the items of the input channel into the items of the output channel.
+     *
+     * @param name The name of the stage in the statistics.
+     * @param thread_count The number of threads running the stage; must be greater than zero.
+     * @param input The channel providing the items.
+     * @param output The channel receiving the transformed items.
+     * @param make_transform The callable creating the transformation; it is called once by every thread, such that
+     *                       every thread can own its state, e.g. an aligner. The transformation is called with an
+     *                       item of the input channel and returns the item for the output channel.
+     *
+     * @throws std::invalid_argument if the thread count is zero or exceeds the threads supported by the channels.
+     */
+    template <typename input_channel_t, typename output_channel_t, typename make_transform_t>
+    void add_stage(std::string name,
+                   size_t const thread_count,
+                   input_channel_t & input,
+                   output_channel_t & output,
+                   make_transform_t make_transform)
+    {
+        if (thread_count == 0)
+            throw std::invalid_argument{"The stage " + name + " must run on at least one thread."};
+
+        register_channel(input);
+        register_channel(output);
+        for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx)
+        {
+            input.add_consumer();
+            output.add_producer();
+        }
+
+        stage_counters & counters = add_counters(std::move(name), thread_count);
+        for (size_t thread_idx = 0; thread_idx < thread_count; ++thread_idx)
+        {
+            _threads.push_back([this, &counters, &input, &output, make_transform] () mutable {
+                try
+                {
+                    thread_timer timer{counters};
+                    auto transform = make_transform();
+                    while (std::optional item = timer.measure(timer.input_wait, [&] () { return input.pop(); }))
+                    {
+                        auto transformed_item = transform(std::move(*item));
+                        auto push = [&] () { return output.push(std::move(transformed_item)); };
+                        if (!timer.measure(timer.output_wait, push))
+                            break;
+                        ++timer.item_count;
+                    }
+                }
+                catch (...)
+                {
+                    cancel(std::current_exception());
+                }
+                output.remove_producer();
+            });
+        }
+    }
+
+    /**
+     * @brief Adds a stage consuming the items of the input channel on a single thread.
+     *
+     * @param name The name of the stage in the statistics.
+     * @param input The channel providing the items.
+     * @param sink The callable consuming the items; it is called with every item of the input channel.
+     */
+    template <typename channel_t, typename sink_t>
+    void add_sink(std::string name, channel_t & input, sink_t sink)
+    {
+        register_channel(input);
+        input.add_consumer();
+
+        stage_counters & counters = add_counters(std::move(name), 1);
+        _threads.push_back([this, &counters, &input, sink = std::move(sink)] () mutable {
+            try
+            {
+                thread_timer timer{counters};
+                while (std::optional item = timer.measure(timer.input_wait, [&] () { return input.pop(); }))
+                {
+                    sink(std::move(*item));
+                    ++timer.item_count;
+                }
+            }
+            catch (...)
+            {
+                cancel(std::current_exception());
+            }
+        });
+    }
+
+    /**
+     * @brief Runs all stages and waits until they finished.
+     *
+     * @throws The first exception thrown by a stage; std::logic_error if the pipeline was run before.
+     */
+    void run()
+    {
+        if (std::exchange(_started, true))
+            throw std::logic_error{"The pipeline can only be run once."};
+
+        {
+            std::vector<std::jthread> threads{};
+            threads.reserve(_threads.size());
+            try
+            {
+                for (std::function<void()> & thread_function : _threads)
+                    threads.emplace_back(std::move(thread_function));
+            }
+            catch (...)
+            {
+                cancel(std::current_exception());
+            }
+        } // Joins all threads.
+
+        if (_first_error)
+            std::rethrow_exception(_first_error);
+    }
+
+    /**
+     * @brief Stops all stages and stores the error, which is rethrown by run().
+     *
+     * Can be called by any stage, e.g. to wake up a source waiting for a resource released by a later stage.
+     */
+    void cancel(std::exception_ptr error) noexcept
+    {
+        {
+            std::lock_guard lock{_error_mutex};
+            if (!_first_error)
+                _first_error = std::move(error);
+        }
+
+        if (!_cancelled.exchange(true))
+        {
+            for (std::function<void()> const & cancel_channel : _cancel_channels)
+                cancel_channel();
+        }
+    }
+
+    //!\brief Whether a stage failed and the pipeline is stopping.
+    bool is_cancelled() const noexcept
+    {
+        return _cancelled.load();
+    }
+
+    //!\brief Returns the statistics of every stage in the order the stages were added; complete after run().
+    std::vector<pipeline_stage_statistics> statistics() const
+    {
+        auto seconds = [] (std::atomic<uint64_t> const & nanoseconds) {
+            return nanoseconds.load(std::memory_order_relaxed) * 1e-9;
+        };
+
+        std::vector<pipeline_stage_statistics> stage_statistics{};
+        for (stage_counters const & counters : _counters)
+        {
+            stage_statistics.push_back(pipeline_stage_statistics{
+                .name = counters.name,
+                .thread_count = counters.thread_count,
+                .item_count = counters.item_count.load(std::memory_order_relaxed),
+                .busy_seconds = seconds(counters.busy_nanoseconds),
+                .input_wait_seconds = seconds(counters.input_wait_nanoseconds),
+                .output_wait_seconds = seconds(counters.output_wait_nanoseconds)
+            });
+        }
+        return stage_statistics;
+    }
+
+private:
+
+    stage_counters & add_counters(std::string name, size_t const thread_count)
+    {
+        stage_counters & counters = _counters.emplace_back();
+        counters.name = std::move(name);
+        counters.thread_count = thread_count;
+        return counters;
+    }
+
+    template <typename channel_t>
+    void register_channel(channel_t & channel)
+    {
+        if (_started)
+            throw std::logic_error{"The stages must be added before the pipeline is run."};
+
+        _cancel_channels.push_back([&channel] () { channel.cancel(); });
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -0,0 +1,178 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::pipeline_channel.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <pairwise_aligner/pipeline/mpmc_queue.hpp>
+#include <pairwise_aligner/pipeline/spsc_queue.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace detail
+{
+
+// Waits between two failed attempts to access a queue; spins first and sleeps if the queue stays full or empty.
+class channel_backoff
+{
+private:
+    size_t _attempt{};
+
+public:
+    void wait()
+    {
+        if (++_attempt < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A bounded channel connecting two stages of a seqan::pairwise_aligner::pipeline.
+ *
+ * Pushing waits while the channel is full and popping waits while it is empty, such that a fast stage is slowed down
+ * to the pace of the stages behind it instead of buffering an unbounded amount of work. The channel is closed when
+ * its last producer was removed; the consumers then receive the remaining values before popping fails. Cancelling
+ * the channel makes pushing and popping fail immediately.
+ *
+ * @tparam value_t The type of the values.
+ * @tparam queue_t The lock-free queue storing the values; seqan::pairwise_aligner::spsc_queue if the channel connects
+ *                 exactly one producer with exactly one consumer, seqan::pairwise_aligner::mpmc_queue otherwise.
+ */
+template <typename value_t, typename queue_t = mpmc_queue<value_t>>
+class pipeline_channel
+{
+private:
+    queue_t _queue;
+    std::atomic<size_t> _active_producers{0};
+    size_t _producer_count{0};
+    size_t _consumer_count{0};
+    std::atomic<bool> _closed{false};
+    std::atomic<bool> _cancelled{false};
+
+public:
+
+    using value_type = value_t; //!< The type of the values.
+
+    explicit pipeline_channel(size_t const capacity) : _queue{capacity}
+    {}
+
+    pipeline_channel(pipeline_channel const &) = delete;
+    pipeline_channel & operator=(pipeline_channel const &) = delete;
+
+    //!\brief Returns the number of values the channel can hold.
+    size_t capacity() const noexcept
+    {
+        return _queue.capacity();
+    }
+
+    /**
+     * @brief Registers a producing thread; must be called before any thread uses the channel.
+     *
+     * @throws std::invalid_argument if the queue supports only a single producer and one was registered already.
+     */
+    void add_producer()
+    {
+        if (!queue_t::is_multi_producer && _producer_count > 0)
+            throw std::invalid_argument{"The channel supports only a single producer."};
+
+        ++_producer_count;
+        _active_producers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //!\brief Unregisters a producing thread, which has finished; closes the channel when the last one finished.
+    void remove_producer()
+    {
+        if (_active_producers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            close();
+    }
+
+    /**
+     * @brief Registers a consuming thread; must be called before any thread uses the channel.
+     *
+     * @throws std::invalid_argument if the queue supports only a single consumer and one was registered already.
+     */
+    void add_consumer()
+    {
+        if (!queue_t::is_multi_consumer && _consumer_count > 0)
+            throw std::invalid_argument{"The channel supports only a single consumer."};
+
+        ++_consumer_count;
+    }
+
+    //!\brief Appends the value and returns `true`, or returns `false` if the channel was closed or cancelled.
+    bool push(value_t value)
+    {
+        for (detail::channel_backoff backoff{};; backoff.wait())
+        {
+            if (_closed.load(std::memory_order_acquire) || _cancelled.load(std::memory_order_acquire))
+                return false;
+
+            if (_queue.try_push(value))
+                return true;
+        }
+    }
+
+    //!\brief Removes the first value, or returns `std::nullopt` if the channel is closed and empty or cancelled.
+    std::optional<value_t> pop()
+    {
+        for (detail::channel_backoff backoff{};; backoff.wait())
+        {
+            if (_cancelled.load(std::memory_order_acquire))
+                return std::nullopt;
+
+            if (std::optional<value_t> value = _queue.try_pop(); value.has_value())
+                return value;
+
+            // All values were pushed before the channel was closed, hence a last attempt finds the remaining ones.
+            if (_closed.load(std::memory_order_acquire))
+                return _queue.try_pop();
+        }
+    }
+
+    //!\brief Closes the channel; no values can be pushed afterwards.
+    void close() noexcept
+    {
+        _closed.store(true, std::memory_order_release);
+    }
+
+    //!\brief Cancels the channel; pushing and popping fail afterwards and the remaining values are dropped.
+    void cancel() noexcept
+    {
+        _cancelled.store(true, std::memory_order_release);
+    }
+
+    //!\brief Whether the channel was cancelled.
+    bool is_cancelled() const noexcept
+    {
+        return _cancelled.load(std::memory_order_acquire);
+    }
+};
+
+//!\brief A channel connecting exactly one producing with exactly one consuming thread.
+template <typename value_t>
+using spsc_channel = pipeline_channel<value_t, spsc_queue<value_t>>;
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
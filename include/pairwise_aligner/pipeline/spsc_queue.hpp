@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::spsc_queue.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace detail
+{
+
+//!\brief The size of a cache line, which separates the positions written by different threads.
+inline constexpr size_t cache_line_size = 64;
+
+} // namespace detail
+
+/**
+ * @brief A lock-free bounded queue for exactly one producing and one consuming thread.
+ *
+ * The values are stored in a ring buffer, whose capacity is rounded up to the next power of two. The producer only
+ * writes the tail and the consumer only writes the head, such that both run without any atomic read-modify-write
+ * operation. Each side caches the position of the other side and reloads it only if the queue appears full or empty.
+ *
+ * @tparam value_t The type of the values; must be move constructible.
+ */
+template <typename value_t>
+class spsc_queue
+{
+private:
+    std::unique_ptr<std::optional<value_t>[]> _slots;
+    size_t _mask{};
+
+    alignas(detail::cache_line_size) std::atomic<size_t> _head{0}; // The next position to pop.
+    size_t _cached_tail{0}; // The tail as last seen by the consumer.
+
+    alignas(detail::cache_line_size) std::atomic<size_t> _tail{0}; // The next position to push.
+    size_t _cached_head{0}; // The head as last seen by the producer.
+
+public:
+
+    //!\brief Whether multiple threads can push concurrently.
+    static constexpr bool is_multi_producer = false;
+    //!\brief Whether multiple threads can pop concurrently.
+    static constexpr bool is_multi_consumer = false;
+
+    explicit spsc_queue(size_t const capacity) :
+        _slots{std::make_unique<std::optional<value_t>[]>(std::bit_ceil(std::max<size_t>(capacity, 1)))},
+        _mask{std::bit_ceil(std::max<size_t>(capacity, 1)) - 1}
+    {}
+
+    spsc_queue(spsc_queue const &) = delete;
+    spsc_queue & operator=(spsc_queue const &) = delete;
+
+    //!\brief Returns the number of values the queue can hold.
+    size_t capacity() const noexcept
+    {
+        return _mask + 1;
+    }
+
+    //!\brief Moves the value into the queue and returns `true`, or leaves it unchanged and returns `false` if full.
+    bool try_push(value_t & value)
+    {
+        size_t const tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cached_head == capacity())
+        {
+            _cached_head = _head.load(std::memory_order_acquire);
+            if (tail - _cached_head == capacity())
+                return false;
+        }
+
+        _slots[tail & _mask].emplace(std::move(value));
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    //!\brief Removes the first value, or returns `std::nullopt` if the queue is empty.
+    std::optional<value_t> try_pop()
+    {
+        size_t const head = _head.load(std::memory_order_relaxed);
+        if (head == _cached_tail)
+        {
+            _cached_tail = _tail.load(std::memory_order_acquire);
+            if (head == _cached_tail)
+                return std::nullopt;
+        }
+
+        std::optional<value_t> & slot = _slots[head & _mask];
+        std::optional<value_t> value{std::move(slot)};
+        slot.reset();
+        _head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -86,15 +86,16 @@ struct _fn
               typename score_t>
     auto operator()(sequence1_t && sequence1,
                     sequence2_t && sequence2,
-                    dp_column_t dp_column,
-                    dp_row_t dp_row,
+                    dp_column_t && dp_column,
+                    dp_row_t && dp_row,
                     score_t score) const noexcept
     {
+        // The dp vectors are referenced if passed as lvalue, e.g. when they are owned by an aligner workspace.
         using aligner_result_t = _aligner_result::value<sequence1_t, sequence2_t, dp_column_t, dp_row_t, score_t>;
         return aligner_result_t{std::forward<sequence1_t>(sequence1),
                                 std::forward<sequence2_t>(sequence2),
-                                std::move(dp_column),
-                                std::move(dp_row),
+                                std::forward<dp_column_t>(dp_column),
+                                std::forward<dp_row_t>(dp_row),
                                 std::move(score)};
     }
 };
@@ -0,0 +1,213 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::aligner_result_batch.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <compare>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <pairwise_aligner/result/aligner_result_bulk.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief The results of all pairs of a bulk stored in a single object.
+ *
+ * @tparam aligner_result_t The type of the result of the bulk.
+ *
+ * The batch owns the result of the bulk and stores the scores of the pairs contiguously.
+ * The elements are lightweight views of type seqan::pairwise_aligner::aligner_result_bulk referring to this batch,
+ * such that they must not outlive it. Unlike the shared results returned before, the elements, the iterators and the
+ * scores are therefore only accessible from a batch that is an lvalue, e.g. `aligner.compute(...)[0]` does not
+ * compile. Store the batch in a variable first or iterate over it with a range-based for loop.
+ */
+template <typename aligner_result_t>
+class aligner_result_batch
+{
+private:
+    using simd_score_t = std::remove_cvref_t<decltype(std::declval<aligner_result_t const &>().score())>;
+
+public:
+    using score_type = typename simd_score_t::value_type;
+    using value_type = aligner_result_bulk<aligner_result_t>;
+    using reference = value_type;
+    using const_reference = value_type;
+
+    class iterator;
+
+private:
+    aligner_result_t _result;
+    std::array<score_type, simd_score_t::size_v> _scores{};
+    size_t _size{};
+
+public:
+
+    aligner_result_batch() = delete;
+    explicit aligner_result_batch(aligner_result_t result, size_t const size) noexcept :
+        _result{std::move(result)},
+        _size{size}
+    {
+        assert(size <= _scores.size());
+
+        for (size_t index = 0; index < _size; ++index)
+            _scores[index] = _result.score()[index];
+    }
+
+    reference operator[](size_t const index) const & noexcept
+    {
+        assert(index < _size);
+        return reference{_result, index};
+    }
+
+    reference operator[](size_t const index) const && = delete;
+
+    constexpr size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    iterator begin() const & noexcept
+    {
+        return iterator{*this, 0};
+    }
+
+    iterator begin() const && = delete;
+
+    iterator end() const & noexcept
+    {
+        return iterator{*this, _size};
+    }
+
+    iterator end() const && = delete;
+
+    //!\brief The scores of all pairs in the order of the bulk.
+    std::span<score_type const> scores() const & noexcept
+    {
+        return std::span<score_type const>{_scores.data(), _size};
+    }
+
+    std::span<score_type const> scores() const && = delete;
+
+    //!\brief The result of the bulk with the dp vectors and the simd score.
+    aligner_result_t const & bulk_result() const & noexcept
+    {
+        return _result;
+    }
+
+    aligner_result_t const & bulk_result() const && = delete;
+};
+
+template <typename aligner_result_t>
+class aligner_result_batch<aligner_result_t>::iterator
+{
+    aligner_result_batch const * _batch{};
+    size_t _index{0};
+
+public:
+
+    using value_type = typename aligner_result_batch::value_type;
+    using reference = typename aligner_result_batch::reference;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using iterator_category = std::random_access_iterator_tag;
+
+    iterator() = default;
+    iterator(aligner_result_batch const & batch, size_t const index) :
+        _batch{std::addressof(batch)},
+        _index{index}
+    {}
+
+    reference operator*() const noexcept {
+        assert(_batch != nullptr);
+        return _batch->operator[](_index);
+    }
+
+    reference operator[](difference_type const offset) const noexcept {
+        assert(_batch != nullptr);
+        return _batch->operator[](_index + offset);
+    }
+
+    iterator & operator++() noexcept {
+        ++_index;
+        return *this;
+    }
+
+    iterator operator++(int) noexcept {
+        iterator tmp{*this};
+        ++_index;
+        return tmp;
+    }
+
+    iterator & operator--() noexcept {
+        --_index;
+        return *this;
+    }
+
+    iterator operator--(int) noexcept {
+        iterator tmp{*this};
+        --_index;
+        return tmp;
+    }
+
+    iterator & operator+=(difference_type const offset) noexcept {
+        _index += offset;
+        return *this;
+    }
+
+    iterator & operator-=(difference_type const offset) noexcept {
+        _index -= offset;
+        return *this;
+    }
+
+    friend constexpr iterator operator+(iterator lhs, difference_type const offset) noexcept {
+        lhs += offset;
+        return lhs;
+    }
+
+    friend constexpr iterator operator+(difference_type const offset, iterator const & rhs) noexcept {
+        return rhs + offset;
+    }
+
+    friend constexpr iterator operator-(iterator lhs, difference_type const offset) noexcept {
+        lhs -= offset;
+        return lhs;
+    }
+
+    friend constexpr difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept {
+        return lhs._index - rhs._index;
+    }
+
+    friend constexpr bool operator==(iterator const & lhs, iterator const & rhs) noexcept {
+        return lhs._index == rhs._index;
+    }
+
+    friend constexpr auto operator<=>(iterator const & lhs, iterator const & rhs) noexcept {
+        return lhs._index <=> rhs._index;
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -6,7 +6,7 @@
 // -----------------------------------------------------------------------------------------------------
 
 /*!\file
- * \brief Provides seqan::pairwise_aligner::aligner_result_batch.
+ * \brief Provides seqan::pairwise_aligner::aligner_result_bulk.
  * \author Rene Rahn <rahn AT molgen.mpg.de>
  */
 
@@ -29,17 +29,23 @@ class aligner_result_bulk
                            std::true_type,
                            std::false_type>::value;
 
-    std::shared_ptr<aligner_result_t> _result{};
+    // Refers to the result of the bulk, which is owned by an aligner_result_batch. The view must not outlive the batch.
+    aligner_result_t const * _result{};
     size_t _index{};
 
 public:
 
     aligner_result_bulk() = default;
-    explicit aligner_result_bulk(std::shared_ptr<aligner_result_t> result, size_t const index) noexcept :
-        _result{std::move(result)},
+    explicit aligner_result_bulk(aligner_result_t const & result, size_t const index) noexcept :
+        _result{std::addressof(result)},
         _index{index}
     {}
 
+    size_t index() const noexcept
+    {
+        return _index;
+    }
+
     auto const & dp_column() const & noexcept
     {
         return _result->dp_column();
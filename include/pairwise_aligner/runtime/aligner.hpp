@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::runtime::aligner.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/configuration/end_gap_policy.hpp>
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime {
+
+//!\brief The alignment method computed by the seqan::pairwise_aligner::runtime::aligner.
+enum struct alignment_method
+{
+    global, //!< Global alignment with configurable end gaps.
+    local //!< Local alignment; the end gap rules are ignored.
+};
+
+//!\brief The precision of the scores computed within the kernel.
+enum struct score_precision
+{
+    int8_saturated, //!< 8-bit scores with saturated blocks, which are rescaled to 32-bit scores.
+    int16, //!< 16-bit scores.
+    int32 //!< 32-bit scores.
+};
+
+//!\brief The engine, i.e. the vectorisation layout, of the kernel.
+enum struct alignment_engine
+{
+    scalar, //!< Computes one pair at a time without vectorisation.
+    simd_NxN, //!< Computes independent pairs in the lanes of a simd vector.
+    //!\brief Computes one first sequence against several second sequences in the lanes of a simd vector.
+    //!        Supports only the int8_saturated precision.
+    simd_1xN
+};
+
+//!\brief The runtime parameters to select a precompiled kernel.
+struct aligner_parameters
+{
+    //!\brief The name of the substitution matrix; one of `blosum62` or `blosum62_extended`.
+    std::string substitution_matrix{"blosum62"};
+    int32_t gap_open_score{-10}; //!< The score for opening a gap.
+    int32_t gap_extension_score{-1}; //!< The score for extending a gap.
+    alignment_method method{alignment_method::global}; //!< The alignment method.
+    cfg::leading_end_gap leading_end_gap{}; //!< The leading end gaps of a global alignment.
+    cfg::trailing_end_gap trailing_end_gap{}; //!< The trailing end gaps of a global alignment.
+    score_precision precision{score_precision::int8_saturated}; //!< The precision of the kernel.
+    alignment_engine engine{alignment_engine::simd_NxN}; //!< The engine of the kernel.
+    //!\brief Whether the pairs are sorted by length before they are distributed over the lanes of the simd_NxN engine.
+    bool group_by_length{false};
+};
+
+namespace detail {
+struct kernel_base;
+struct prepared_bulk_base;
+} // namespace detail
+
+/**
+ * @brief Pairs whose sequences were transformed and transposed by seqan::pairwise_aligner::runtime::aligner::prepare.
+ *
+ * Preparing the pairs and computing their scores can be done by different threads and different aligners, e.g. in
+ * separate stages of a pipeline, as long as the aligners use the same engine and precision. The prepared pairs might
+ * still refer to the original sequences, which must be kept alive until the scores are computed.
+ */
+class prepared_pairs
+{
+public:
+    prepared_pairs();
+    prepared_pairs(prepared_pairs &&) noexcept;
+    prepared_pairs & operator=(prepared_pairs &&) noexcept;
+    ~prepared_pairs();
+
+    //!\brief Returns the number of prepared pairs.
+    size_t size() const noexcept
+    {
+        return _size;
+    }
+
+private:
+    friend class aligner;
+
+    std::unique_ptr<detail::prepared_bulk_base> _bulks;
+    std::vector<size_t> _order{}; // The positions of the pairs if they were sorted by length.
+    size_t _size{};
+};
+
+/**
+ * @brief A type-erased aligner selecting one of the precompiled kernels at runtime.
+ *
+ * In contrast to the aligners generated by seqan::pairwise_aligner::cfg::configure_aligner, this aligner is configured
+ * with runtime parameters and dispatches to a kernel compiled once within the `seqan::pairwise_aligner::runtime`
+ * library target. Hence, including this header does not instantiate any of the alignment algorithms.
+ * The sequences are passed as spans of string views, such that no templated ranges cross the library boundary.
+ * The pairs are computed in bulks of size seqan::pairwise_aligner::runtime::aligner::bulk_size.
+ */
+class aligner
+{
+public:
+    /**
+     * @brief Constructs the aligner from the given runtime parameters.
+     *
+     * @param parameters The parameters selecting the kernel.
+     *
+     * @throws std::invalid_argument if the substitution matrix is unknown or the engine does not support the
+     *         precision.
+     */
+    explicit aligner(aligner_parameters const & parameters);
+    aligner(aligner &&) noexcept;
+    aligner & operator=(aligner &&) noexcept;
+    ~aligner();
+
+    //!\brief Returns the number of pairs computed simultaneously by the selected kernel.
+    size_t bulk_size() const noexcept;
+
+    /**
+     * @brief Computes the scores of the pairwise alignments between the sequences at the same positions.
+     *
+     * @param sequences1 The first sequences of the pairs.
+     * @param sequences2 The second sequences of the pairs.
+     * @param scores The output span receiving the score of every pair.
+     *
+     * @throws std::invalid_argument if the sizes of the three spans differ.
+     *
+     * The simd_1xN engine computes consecutive pairs with the same first sequence within one bulk. Hence, the pairs
+     * should be ordered by their first sequence. If the parameter `group_by_length` is set, the pairs computed by the
+     * simd_NxN engine are sorted by their length, such that the lanes of one bulk have similar lengths and the bulk
+     * computes few blocks lying beyond the ends of all its pairs.
+     * The scores are always reported in the order of the given pairs.
+     */
+    void compute(std::span<std::string_view const> sequences1,
+                 std::span<std::string_view const> sequences2,
+                 std::span<int32_t> scores);
+
+    //!\overload
+    std::vector<int32_t> compute(std::span<std::string_view const> sequences1,
+                                 std::span<std::string_view const> sequences2);
+
+    /**
+     * @brief Transforms and transposes the pairs for a later call of compute.
+     *
+     * @param sequences1 The first sequences of the pairs.
+     * @param sequences2 The second sequences of the pairs.
+     *
+     * @throws std::invalid_argument if the number of first and second sequences differ.
+     *
+     * Separates the preparation of the sequences from the computation of the alignments, such that both can run
+     * concurrently on different threads. Preparing does not modify the aligner and can be called concurrently.
+     */
+    prepared_pairs prepare(std::span<std::string_view const> sequences1,
+                           std::span<std::string_view const> sequences2) const;
+
+    /**
+     * @brief Computes the scores of the prepared pairs.
+     *
+     * @param pairs The pairs prepared by an aligner with the same engine and precision.
+     * @param scores The output span receiving the score of every pair in the order they were prepared.
+     *
+     * @throws std::invalid_argument if the number of pairs and scores differ or the pairs were prepared by an aligner
+     *                               with another engine or precision.
+     */
+    void compute(prepared_pairs const & pairs, std::span<int32_t> scores);
+
+private:
+    std::unique_ptr<detail::kernel_base> _kernel;
+    bool _group_by_length{false};
+
+    void compute_in_order(std::span<std::string_view const> sequences1,
+                          std::span<std::string_view const> sequences2,
+                          std::span<int32_t> scores);
+};
+
+} // namespace runtime
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::runtime::plan_aligner.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+
+#include <pairwise_aligner/runtime/aligner.hpp>
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime {
+
+//!\brief The statistics of a batch of pairs inspected by seqan::pairwise_aligner::runtime::plan_aligner.
+struct batch_statistics
+{
+    size_t pair_count{}; //!< The number of pairs.
+    size_t min_length{}; //!< The length of the shortest sequence.
+    size_t max_length{}; //!< The length of the longest sequence.
+    double mean_length{}; //!< The mean length of all sequences.
+    double length_deviation{}; //!< The standard deviation of the lengths of all sequences.
+    bool one_vs_many{}; //!< Whether all pairs view the same first sequence, i.e. the same data and size.
+};
+
+/**
+ * @brief Collects the statistics of the given batch.
+ *
+ * @param sequences1 The first sequences of the pairs.
+ * @param sequences2 The second sequences of the pairs.
+ *
+ * @throws std::invalid_argument if the number of first and second sequences differ.
+ */
+batch_statistics collect_batch_statistics(std::span<std::string_view const> sequences1,
+                                          std::span<std::string_view const> sequences2);
+
+/**
+ * @brief Selects the engine, the precision and the batching for the given workload.
+ *
+ * @param parameters The parameters of the alignment; the engine, precision and batching are overwritten.
+ * @param statistics The statistics of the batch to compute.
+ * @param log An optional stream the decisions and their reasons are written to.
+ *
+ * @returns The parameters with the selected engine, precision and batching.
+ *
+ * @throws std::invalid_argument if the substitution matrix is unknown.
+ *
+ * The planner follows these rules:
+ *  * Batches sharing a single first sequence use the simd_1xN engine if the saturated 8-bit precision is selected,
+ *    batches with too few pairs to fill the lanes meaningfully use the scalar engine, and all other batches use the
+ *    simd_NxN engine.
+ *  * The saturated 8-bit precision is used if the value range of the substitution matrix and the gap scores permit
+ *    blocks of a reasonable size, as computed by seqan::pairwise_aligner::cfg::detail::saturated_block_handler.
+ *    Otherwise, the 16-bit precision is used if the largest possible score of the longest pair fits into it,
+ *    and the 32-bit precision is used as last resort.
+ *  * The pairs are grouped by length if the lengths vary considerably, such that the lanes of the simd_NxN engine
+ *    compute similarly sized matrices.
+ */
+aligner_parameters plan_aligner(aligner_parameters parameters,
+                                batch_statistics const & statistics,
+                                std::ostream * log = nullptr);
+
+} // namespace runtime
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -12,8 +12,11 @@
 
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <concepts>
+#include <span>
+#include <utility>
 
 #include <seqan3/utility/container/aligned_allocator.hpp>
 
@@ -45,8 +48,11 @@ private:
     using typename simd_rank_selector_t::rank_map_t;
 
     struct _interleaved_substitution_profile;
+    class _interleaved_substitution_profile_slice;
 
-    std::array<rank_map_t, dimension> _matrix{};
+    using matrix_t = std::array<rank_map_t, dimension>;
+
+    matrix_t _matrix{};
     score_t _zero{};
 
 public:
@@ -57,6 +63,7 @@ public:
     using offset_type = std::pair<int32_t, index_t>;
 
     using profile_type = _interleaved_substitution_profile;
+    using profile_slice_type = _interleaved_substitution_profile_slice;
 
     type() = default;
 
@@ -74,6 +81,12 @@ public:
         }
     }
 
+    // Copies the rank maps of the given score model but uses a different zero.
+    constexpr explicit type(type const & other, score_t zero) noexcept : type{other}
+    {
+        _zero = zero;
+    }
+
     constexpr score_t const & zero() const noexcept
     {
         return _zero;
@@ -102,6 +115,8 @@ public:
     }
 };
 
+// The profile stores the scores of all symbols for every position of the sequence in one contiguous buffer, where
+// the scores of each symbol are stored consecutively for all positions.
 template <typename score_t, size_t dimension>
 class _score_model_matrix_simd_1xN<score_t, dimension>::type::_interleaved_substitution_profile
 {
@@ -112,18 +127,16 @@ class _score_model_matrix_simd_1xN<score_t, dimension>::type::_interleaved_subst
 
     static constexpr size_t min_align_v = std::max<size_t>(alignof(index_t), 16);
 
-    using interleaved_scores_t = std::vector<index_t, seqan3::aligned_allocator<index_t, min_align_v>>;
-    using profile_t = std::vector<interleaved_scores_t,
-                                  seqan3::aligned_allocator<interleaved_scores_t, min_align_v>>;
+    using profile_t = std::vector<index_t, seqan3::aligned_allocator<index_t, min_align_v>>;
 
     struct proxy_reference
     {
-        profile_t const & _interleaved_profile;
-        size_t const _profile_index;
+        index_t const * _scores;
+        size_t const _stride;
 
         constexpr auto operator[](size_t const rank) const noexcept
         {
-            return _interleaved_profile[rank][_profile_index];
+            return _scores[rank * _stride];
         }
     };
 
@@ -139,16 +152,17 @@ public:
     explicit _interleaved_substitution_profile(matrix_t const & matrix, sequence_slice_t && sequence) noexcept
     {
         _size = std::ranges::distance(sequence);
-
-        // Initialise profile: - go over all symbols in range [0..sigma)
-        _interleaved_profile.resize(dimension);
-        for_each_symbol([&] (scalar_index_t const rank) {
-            interleaved_scores_t & profile = _interleaved_profile[rank]; // fill profile for current symbol!
-            profile.resize(_size);
-            for (size_t index = 0; index < _size; ++index) { // for every symbol in sequence
-                profile[index] |= simd_rank_selector_t::select_rank_for(matrix[rank], sequence[index]);
-            }
-        }, std::make_index_sequence<dimension>());
+        _interleaved_profile.resize(alphabet_size_v * _size);
+
+        // Selects the scores of all symbols for one position at once, such that every simd symbol of the sequence is
+        // loaded and split into the shuffle keys only once.
+        index_t * scores = _interleaved_profile.data();
+        size_t index = 0;
+        for (auto it = std::ranges::begin(sequence); index < _size; ++it, ++index) {
+            simd_rank_selector_t::select_ranks_for(matrix, *it, [&] (size_t const rank, index_t const & ranks) {
+                scores[rank * _size + index] = ranks;
+            });
+        }
     }
 
     iterator begin() const noexcept {
@@ -161,7 +175,7 @@ public:
 
     constexpr auto operator[](size_t const offset) const noexcept
     {
-        return proxy_reference{_interleaved_profile, offset};
+        return proxy_reference{_interleaved_profile.data() + offset, _size};
     }
 
     constexpr size_t size() const noexcept
@@ -169,16 +183,16 @@ public:
         return _size;
     }
 
-    constexpr auto scores_for(scalar_index_t const & rank) const noexcept
+    constexpr std::span<index_t const> scores_for(scalar_index_t const & rank) const noexcept
     {
-        return _interleaved_profile[rank];
+        return std::span<index_t const>{_interleaved_profile.data() + rank * _size, _size};
     }
 
-private:
-    template <typename fn_t, size_t ...alphabet_rank>
-    void for_each_symbol(fn_t && fn, std::index_sequence<alphabet_rank...> const &) const noexcept
+    //!\brief Returns the profile of the symbols in `[offset, offset + size)` without copying the scores.
+    constexpr profile_slice_type slice(size_t const offset, size_t const size) const noexcept
     {
-        (fn(static_cast<scalar_index_t>(alphabet_rank)), ...);
+        assert(offset + size <= _size);
+        return profile_slice_type{*this, offset, size};
     }
 };
 
@@ -272,5 +286,45 @@ public:
     }
 };
 
+// A view of a contiguous part of a profile built over a longer sequence, which refers to the scores of the profile.
+template <typename score_t, size_t dimension>
+class _score_model_matrix_simd_1xN<score_t, dimension>::type::_interleaved_substitution_profile_slice
+{
+    using iterator = decltype(std::declval<_interleaved_substitution_profile const &>().begin());
+
+    _interleaved_substitution_profile const * _profile{};
+    size_t _offset{};
+    size_t _size{};
+
+public:
+
+    _interleaved_substitution_profile_slice() = default;
+    explicit _interleaved_substitution_profile_slice(_interleaved_substitution_profile const & profile,
+                                                     size_t const offset,
+                                                     size_t const size) noexcept :
+        _profile{std::addressof(profile)},
+        _offset{offset},
+        _size{size}
+    {}
+
+    iterator begin() const noexcept {
+        return iterator{*_profile, _offset};
+    }
+
+    iterator end() const noexcept {
+        return iterator{*_profile, _offset + _size};
+    }
+
+    constexpr auto operator[](size_t const offset) const noexcept
+    {
+        return (*_profile)[_offset + offset];
+    }
+
+    constexpr size_t size() const noexcept
+    {
+        return _size;
+    }
+};
+
 } // inline namespace v1
 }  // namespace seqan::pairwise_aligner
@@ -0,0 +1,83 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::score_model_matrix_simd_gather_NxN.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+
+#include <pairwise_aligner/simd/simd_base.hpp>
+#include <pairwise_aligner/simd/simd_gather_map.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief Substitution model for large alphabets that looks up the scores directly by the ranks of both symbols.
+ *
+ * The seqan::pairwise_aligner::score_model_matrix_simd_NxN stores only the upper triangular matrix, which is addressed
+ * by an offset of the same width as the scores. For 8-bit scores this limits the alphabet to 22 symbols.
+ * This model stores the full matrix instead and gathers the scores by the pair of ranks, supporting alphabets of up
+ * to 256 symbols, e.g. codons or structural alphabets.
+ * Accordingly, the sequences must be transformed into ranks only and not into the offsets of the triangular matrix.
+ */
+template <typename score_t, typename index_t, size_t dimension>
+struct _score_model_matrix_simd_gather_NxN
+{
+    class type;
+};
+
+template <typename score_t, typename index_t, size_t dimension>
+using score_model_matrix_simd_gather_NxN = typename _score_model_matrix_simd_gather_NxN<score_t,
+                                                                                        index_t,
+                                                                                        dimension>::type;
+
+template <typename score_t, typename index_t, size_t dimension>
+class _score_model_matrix_simd_gather_NxN<score_t, index_t, dimension>::type
+{
+private:
+
+    using scalar_score_t = typename score_t::value_type;
+    using scalar_index_t = typename index_t::value_type;
+    using map_t = simd_gather_map<scalar_score_t, scalar_index_t, dimension>;
+
+    static_assert(std::same_as<typename map_t::key_type, index_t>,
+                  "The index type must have the same number of elements as the score type.");
+
+    map_t _data{};
+
+public:
+    using score_type = score_t;
+    using index_type = index_t;
+
+    type() = default;
+
+    template <typename substitution_matrix_t>
+    explicit type(substitution_matrix_t const & matrix) : _data{matrix} // assume non-linearised matrix
+    {}
+
+    template <typename value1_t, typename value2_t>
+    score_type score(score_type const & last_diagonal, value1_t const & value1, value2_t const & value2) const noexcept
+    {
+        return last_diagonal + _data(value2, value1);
+    }
+
+    constexpr type make_substitution_scheme() const noexcept
+    {
+        return *this;
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
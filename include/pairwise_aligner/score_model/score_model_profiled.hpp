@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::score_model_profiled.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief A score model, which takes the profiles from a seqan::pairwise_aligner::profiled_sequence.
+ *
+ * The dp matrix builds the profile of every slice of the row sequence it computes with `initialise_profile`. If the
+ * row sequence is a profiled sequence, this model returns the part of the profile built over the whole sequence
+ * instead, which refers to the scores without copying them. The slices passed to `initialise_profile` must be
+ * contiguous parts of the profiled sequence.
+ *
+ * @tparam score_model_t The wrapped score model, which provides the profile type and its slices.
+ * @tparam symbol_t The type of the symbols of the profiled sequence.
+ */
+template <typename score_model_t, typename symbol_t>
+class score_model_profiled : public score_model_t
+{
+private:
+    using sequence_profile_t = typename score_model_t::profile_type;
+
+    sequence_profile_t const * _profile{};
+    symbol_t const * _symbols{};
+
+public:
+
+    using profile_type = typename score_model_t::profile_slice_type;
+
+    score_model_profiled() = default;
+    explicit score_model_profiled(score_model_t score_model,
+                                  profiled_sequence<symbol_t, sequence_profile_t> const & sequence) noexcept :
+        score_model_t{std::move(score_model)},
+        _profile{std::addressof(sequence.profile())},
+        _symbols{sequence.data()}
+    {}
+
+    //!\brief Returns the part of the sequence profile covering the given slice of the profiled sequence.
+    template <std::ranges::contiguous_range strip_t>
+    constexpr profile_type initialise_profile(strip_t && sequence_strip) const noexcept
+    {
+        assert(_profile != nullptr);
+        size_t const offset = std::ranges::data(sequence_strip) - _symbols;
+        return _profile->slice(offset, std::ranges::distance(sequence_strip));
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -14,6 +14,8 @@
 
 #include <array>
 #include <concepts>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include <pairwise_aligner/simd/simd_score_type.hpp>
@@ -86,5 +88,60 @@ static constexpr std::array<std::pair<char, std::array<score_t, 27>>, 27> blosum
     {'*', {-4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4,  1}} //*
 }};
 
+namespace detail
+{
+
+/**
+ * @brief Checks whether the given substitution matrix equals one of the built-in substitution matrices.
+ *
+ * @param matrix The substitution matrix to check.
+ * @returns `true` if the matrix equals seqan::pairwise_aligner::blosum62_standard or
+ *          seqan::pairwise_aligner::blosum62_extended with the same score type, otherwise `false`.
+ *
+ * The tables derived from a built-in matrix only depend on the matrix itself and can therefore be built once and kept
+ * in static storage.
+ */
+template <typename substitution_matrix_t>
+constexpr bool is_builtin_substitution_matrix(substitution_matrix_t const & matrix) noexcept
+{
+    using matrix_row_t = typename substitution_matrix_t::value_type;
+    using score_t = typename std::tuple_element_t<1, matrix_row_t>::value_type;
+
+    if constexpr (std::same_as<substitution_matrix_t, std::remove_cvref_t<decltype(blosum62_standard<score_t>)>>)
+        return matrix == blosum62_standard<score_t>;
+    else if constexpr (std::same_as<substitution_matrix_t, std::remove_cvref_t<decltype(blosum62_extended<score_t>)>>)
+        return matrix == blosum62_extended<score_t>;
+    else
+        return false;
+}
+
+//!\brief The score of aligning a padding symbol to itself, used by the score model configurations by default.
+inline constexpr int8_t default_match_padding_score{1};
+//!\brief The score of aligning a padding symbol to another symbol, used by the score model configurations by default.
+inline constexpr int8_t default_mismatch_padding_score{-1};
+
+/**
+ * @brief Checks whether the tables derived from the given substitution matrix and padding scores can be shared.
+ *
+ * @param matrix The substitution matrix to check.
+ * @param match_padding_score The score of aligning a padding symbol to itself.
+ * @param mismatch_padding_score The score of aligning a padding symbol to another symbol.
+ * @returns `true` if the matrix is a built-in substitution matrix and both padding scores are the defaults,
+ *          otherwise `false`.
+ *
+ * The tables built by the score model configurations only depend on these values. If this function returns `true`,
+ * they are equal for all aligners and are built only once.
+ */
+template <typename substitution_matrix_t, typename score_t>
+constexpr bool uses_builtin_tables(substitution_matrix_t const & matrix,
+                                   score_t const match_padding_score,
+                                   score_t const mismatch_padding_score) noexcept
+{
+    return is_builtin_substitution_matrix(matrix) &&
+           match_padding_score == static_cast<score_t>(default_match_padding_score) &&
+           mismatch_padding_score == static_cast<score_t>(default_mismatch_padding_score);
+}
+
+} // namespace detail
 } // inline namespace v1
 }  // namespace seqan::pairwise_aligner
@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::compute_all_vs_all.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/search/search_workers.hpp>
+#include <pairwise_aligner/search/triangular_score_matrix.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+//!\brief The options of seqan::pairwise_aligner::compute_all_vs_all.
+struct all_vs_all_options
+{
+    size_t thread_count{1}; //!< The number of threads preparing the bulks and computing the tiles.
+    size_t tile_bulk_count{8}; //!< The number of column bulks per tile.
+};
+
+namespace detail
+{
+
+// The upper triangle of bulks is split into tiles of one row bulk and up to `tile_bulk_count` column bulks starting
+// at or after the diagonal. Stores the number of tiles before every row bulk to map a tile index to its position.
+class all_vs_all_tiling
+{
+private:
+    std::vector<size_t> _first_tile{};
+    size_t _bulk_count{};
+    size_t _tile_bulk_count{};
+
+public:
+
+    all_vs_all_tiling(size_t const bulk_count, size_t const tile_bulk_count) :
+        _bulk_count{bulk_count},
+        _tile_bulk_count{tile_bulk_count}
+    {
+        _first_tile.reserve(bulk_count + 1);
+        _first_tile.push_back(0);
+        for (size_t row_bulk = 0; row_bulk < bulk_count; ++row_bulk)
+        {
+            size_t const column_bulk_count = bulk_count - row_bulk;
+            _first_tile.push_back(_first_tile.back() + (column_bulk_count + tile_bulk_count - 1) / tile_bulk_count);
+        }
+    }
+
+    size_t tile_count() const noexcept
+    {
+        return _first_tile.back();
+    }
+
+    // Returns the row bulk and the range of column bulks of the tile.
+    std::tuple<size_t, size_t, size_t> operator[](size_t const tile_idx) const noexcept
+    {
+        size_t const row_bulk = std::ranges::upper_bound(_first_tile, tile_idx) - _first_tile.begin() - 1;
+        size_t const first_column_bulk = row_bulk + (tile_idx - _first_tile[row_bulk]) * _tile_bulk_count;
+        return {row_bulk, first_column_bulk, std::min(first_column_bulk + _tile_bulk_count, _bulk_count)};
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Computes the scores of all pairs of the given sequences and stores them in the given triangular matrix.
+ *
+ * Only the upper triangle including the diagonal is computed; the scores are meant for symmetric configurations,
+ * i.e. with a symmetric substitution matrix and the same end gap settings for both sequences, where the score does
+ * not depend on the order of the pair.
+ *
+ * The sequences are sorted by their size and split into bulks of `aligner.bulk_size()` sequences, which are
+ * prepared once with `aligner.make_sequence_batch2`. The triangle of bulks is split into tiles of one row bulk and
+ * `options.tile_bulk_count` consecutive column bulks. A tile aligns every sequence of the row bulk against every
+ * column bulk with the one-to-many kernel of the aligner, e.g. one configured with
+ * seqan::pairwise_aligner::cfg::score_model_matrix_simd_saturated_1xN. The substitution profile of a column bulk is
+ * built once per tile with `aligner.make_profiled_sequence_batch2` and reused by all rows of the row bulk while it
+ * is cached. The threads take the tiles from the longest to the shortest sequences,
+ * such that the short tiles at the end balance the load. In the tiles of the diagonal the lanes of the pairs below
+ * the diagonal are computed but not stored.
+ *
+ * @param aligner A one-to-many aligner, which is copied for every thread.
+ * @param sequences The sequences to compare.
+ * @param scores The matrix the scores are written to; its sequence count must match the number of sequences.
+ * @param options The number of threads and the tile size.
+ *
+ * @throws std::invalid_argument if the matrix does not fit the sequences or the thread count or tile size is zero,
+ *         or the first exception thrown by the aligner.
+ */
+template <typename aligner_t, std::ranges::random_access_range sequence_collection_t>
+    requires std::ranges::forward_range<std::ranges::range_reference_t<sequence_collection_t>>
+void compute_all_vs_all(aligner_t const & aligner,
+                        sequence_collection_t && sequences,
+                        triangular_score_matrix & scores,
+                        all_vs_all_options const & options = {})
+{
+    using sequence_t = decltype(std::views::all(*std::ranges::begin(sequences)));
+    using batch_t = decltype(aligner.make_sequence_batch2(std::declval<std::vector<sequence_t> &>()));
+
+    size_t const sequence_count = std::ranges::distance(sequences);
+    if (scores.sequence_count() != sequence_count)
+        throw std::invalid_argument{"The score matrix does not match the number of sequences."};
+    if (options.thread_count == 0 || options.tile_bulk_count == 0)
+        throw std::invalid_argument{"The all-vs-all computation needs at least one thread and one bulk per tile."};
+
+    std::vector<size_t> sequence_order(sequence_count);
+    std::iota(sequence_order.begin(), sequence_order.end(), 0);
+    std::ranges::stable_sort(sequence_order, std::less<>{}, [&] (size_t const index) {
+        return std::ranges::distance(sequences[index]);
+    });
+
+    size_t const bulk_size = aligner.bulk_size();
+    size_t const bulk_count = (sequence_count + bulk_size - 1) / bulk_size;
+    auto bulk_begin = [&] (size_t const bulk_idx) { return bulk_idx * bulk_size; };
+    auto bulk_end = [&] (size_t const bulk_idx) { return std::min(bulk_begin(bulk_idx + 1), sequence_count); };
+
+    std::vector<batch_t> batches(bulk_count);
+    std::atomic<size_t> next_bulk{0};
+    detail::all_vs_all_tiling const tiling{bulk_count, options.tile_bulk_count};
+    std::atomic<size_t> remaining_tile_count{tiling.tile_count()};
+    size_t const thread_count = std::max<size_t>(std::min(options.thread_count, bulk_count), 1);
+
+    // Prepares every bulk once before any tile is computed.
+    detail::run_search_workers(thread_count, [&] (size_t, std::atomic<bool> const & failed) {
+        std::vector<sequence_t> bulk{};
+        for (size_t bulk_idx = next_bulk++; bulk_idx < bulk_count && !failed.load(std::memory_order_relaxed);
+             bulk_idx = next_bulk++)
+        {
+            bulk.clear();
+            for (size_t position = bulk_begin(bulk_idx); position < bulk_end(bulk_idx); ++position)
+                bulk.push_back(std::views::all(sequences[sequence_order[position]]));
+
+            batches[bulk_idx] = aligner.make_sequence_batch2(bulk);
+        }
+    });
+
+    detail::run_search_workers(thread_count, [&] (size_t, std::atomic<bool> const & failed) {
+        aligner_t thread_aligner{aligner};
+        auto workspace = thread_aligner.make_workspace();
+        std::vector<int32_t> bulk_scores(bulk_size);
+
+        for (size_t remaining = remaining_tile_count.load(std::memory_order_relaxed);
+             remaining > 0 && !failed.load(std::memory_order_relaxed);)
+        {
+            if (!remaining_tile_count.compare_exchange_weak(remaining, remaining - 1, std::memory_order_relaxed))
+                continue;
+
+            auto [row_bulk, first_column_bulk, last_column_bulk] = tiling[remaining - 1];
+            for (size_t column_bulk = first_column_bulk; column_bulk < last_column_bulk; ++column_bulk)
+            {
+                auto const profiled_batch = thread_aligner.make_profiled_sequence_batch2(batches[column_bulk]);
+                for (size_t row = bulk_begin(row_bulk); row < bulk_end(row_bulk); ++row)
+                {
+                    thread_aligner.compute(sequences[sequence_order[row]],
+                                           profiled_batch,
+                                           workspace,
+                                           bulk_scores.begin());
+
+                    // Only the pairs on or above the diagonal are stored.
+                    size_t const first_column = std::max(row, bulk_begin(column_bulk));
+                    for (size_t column = first_column; column < bulk_end(column_bulk); ++column)
+                        scores(sequence_order[row], sequence_order[column]) =
+                            bulk_scores[column - bulk_begin(column_bulk)];
+                }
+            }
+
+            remaining = remaining_tile_count.load(std::memory_order_relaxed);
+        }
+    });
+}
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
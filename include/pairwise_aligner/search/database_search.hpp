@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::search_database.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/search/search_workers.hpp>
+#include <pairwise_aligner/search/top_k_hits.hpp>
+#include <pairwise_aligner/sequence/sequence_database.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+//!\brief The options of seqan::pairwise_aligner::search_database.
+struct database_search_options
+{
+    size_t hit_count{10}; //!< The number of best hits to report.
+    size_t thread_count{1}; //!< The number of threads aligning the batches of the database.
+};
+
+/**
+ * @brief Aligns every query against every sequence of the database and returns the best hits of each query.
+ *
+ * The database batches are prepared when the database is written, i.e. they are streamed from the mapped file
+ * through the one-to-many kernel of the aligner without transposing or transforming the database sequences again.
+ * The substitution profile of a batch is built once with `aligner.make_profiled_sequence_batch2` and shared by all
+ * queries, such that many short queries, e.g. peptides, amortise loading the batch and building its profile. Every
+ * query is aligned in its own pass over the profiled batch, i.e. the queries are not packed into one column sequence.
+ * Every thread aligns with its own copy of the aligner and its own workspace and collects the hits of every query in
+ * its own seqan::pairwise_aligner::top_k_hits, whose threshold rejects most scores with a single comparison. The
+ * threads take the batches from the longest to the shortest, such that the short batches at the end balance the
+ * load. The collectors are merged after all batches are aligned.
+ *
+ * The hits are sorted by decreasing score; ties are ordered by the position of the sequence in the collection the
+ * database was built from, such that the result does not depend on the number of threads.
+ *
+ * @param aligner The aligner with the configuration the database was written with; see
+ *                seqan::pairwise_aligner::write_sequence_database.
+ * @param database The database to search.
+ * @param queries The sequences aligned against every sequence of the database as the first sequence.
+ * @param options The number of hits per query and the number of threads.
+ *
+ * @returns The hits of every query in the order of the queries.
+ *
+ * @throws std::invalid_argument if the thread count is zero, or the first exception thrown by the aligner.
+ */
+template <typename aligner_t, typename symbol_t, std::ranges::random_access_range query_collection_t>
+    requires std::ranges::forward_range<std::ranges::range_reference_t<query_collection_t const>>
+std::vector<std::vector<search_hit>> search_database(aligner_t const & aligner,
+                                                     sequence_database<symbol_t> const & database,
+                                                     query_collection_t const & queries,
+                                                     database_search_options const & options = {})
+{
+    if (options.thread_count == 0)
+        throw std::invalid_argument{"The database search needs at least one thread."};
+
+    size_t const query_count = std::ranges::distance(queries);
+    size_t const thread_count = std::max<size_t>(std::min(options.thread_count, database.size()), 1);
+    std::vector<std::vector<top_k_hits>> thread_hits(thread_count,
+                                                     std::vector<top_k_hits>(query_count,
+                                                                             top_k_hits{options.hit_count}));
+    std::atomic<size_t> remaining_batch_count{database.size()};
+
+    detail::run_search_workers(thread_count, [&] (size_t const thread_idx, std::atomic<bool> const & failed) {
+        std::vector<top_k_hits> & query_hits = thread_hits[thread_idx];
+        aligner_t thread_aligner{aligner};
+        auto workspace = thread_aligner.make_workspace();
+        std::vector<int32_t> scores(database.bulk_size());
+
+        for (size_t remaining = remaining_batch_count.load(std::memory_order_relaxed);
+             remaining > 0 && !failed.load(std::memory_order_relaxed);)
+        {
+            if (!remaining_batch_count.compare_exchange_weak(remaining, remaining - 1, std::memory_order_relaxed))
+                continue;
+
+            size_t const batch_idx = remaining - 1;
+            auto const batch = database[batch_idx];
+            auto const profiled_batch = thread_aligner.make_profiled_sequence_batch2(batch);
+            std::span<uint64_t const> const sequence_indices = database.sequence_indices(batch_idx);
+
+            for (size_t query_idx = 0; query_idx < query_count; ++query_idx)
+            {
+                top_k_hits & hits = query_hits[query_idx];
+                thread_aligner.compute(queries[query_idx], profiled_batch, workspace, scores.begin());
+
+                for (size_t result_idx = 0; result_idx < sequence_indices.size(); ++result_idx)
+                {
+                    if (scores[result_idx] < hits.threshold())
+                        continue;
+
+                    hits.insert(search_hit{scores[result_idx], sequence_indices[result_idx]});
+                }
+            }
+
+            remaining = remaining_batch_count.load(std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<std::vector<search_hit>> hits{};
+    hits.reserve(query_count);
+    for (size_t query_idx = 0; query_idx < query_count; ++query_idx)
+    {
+        for (size_t thread_idx = 1; thread_idx < thread_count; ++thread_idx)
+            thread_hits[0][query_idx].merge(thread_hits[thread_idx][query_idx]);
+
+        hits.push_back(thread_hits[0][query_idx].sorted_hits());
+    }
+    return hits;
+}
+
+/**
+ * @brief Aligns the query against every sequence of the database and returns the best hits.
+ *
+ * Searches the database with a single query; see the overload for many queries.
+ *
+ * @param aligner The aligner with the configuration the database was written with; see
+ *                seqan::pairwise_aligner::write_sequence_database.
+ * @param database The database to search.
+ * @param query The sequence aligned against every sequence of the database as the first sequence.
+ * @param options The number of hits and threads.
+ *
+ * @throws std::invalid_argument if the thread count is zero, or the first exception thrown by the aligner.
+ */
+template <typename aligner_t, typename symbol_t, std::ranges::forward_range query_t>
+    requires (!std::ranges::forward_range<std::ranges::range_reference_t<query_t const>>)
+std::vector<search_hit> search_database(aligner_t const & aligner,
+                                        sequence_database<symbol_t> const & database,
+                                        query_t const & query,
+                                        database_search_options const & options = {})
+{
+    return std::move(search_database(aligner, database, std::span<query_t const>{&query, 1}, options)[0]);
+}
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::detail::run_search_workers.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * @brief Calls `worker(thread_idx, failed)` on the given number of threads and waits until all workers returned.
+ *
+ * The calling thread runs the first worker. If a worker throws, `failed` is set, such that the other workers can
+ * stop taking new work, and the first exception is rethrown after all workers returned.
+ *
+ * @throws std::invalid_argument if the thread count is zero.
+ */
+template <typename worker_t>
+void run_search_workers(size_t const thread_count, worker_t && worker)
+{
+    if (thread_count == 0)
+        throw std::invalid_argument{"The search needs at least one thread."};
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error{};
+    std::mutex error_mutex{};
+
+    auto run_worker = [&] (size_t const thread_idx) {
+        try
+        {
+            worker(thread_idx, static_cast<std::atomic<bool> const &>(failed));
+        }
+        catch (...)
+        {
+            failed.store(true, std::memory_order_relaxed);
+            std::scoped_lock lock{error_mutex};
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads{};
+        threads.reserve(thread_count - 1);
+        for (size_t thread_idx = 1; thread_idx < thread_count; ++thread_idx)
+            threads.emplace_back(run_worker, thread_idx);
+
+        run_worker(0);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace detail
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
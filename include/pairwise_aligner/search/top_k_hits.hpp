@@ -0,0 +1,143 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::search_hit and seqan::pairwise_aligner::top_k_hits.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+//!\brief The score of a database sequence and its position in the collection the database was built from.
+struct search_hit
+{
+    int32_t score{}; //!< The score of the alignment with the query.
+    size_t sequence_index{}; //!< The position of the sequence in the original collection.
+
+    //!\brief Returns whether this hit ranks before the other: higher scores first, ties by the lower index.
+    constexpr bool ranks_before(search_hit const & other) const noexcept
+    {
+        return score > other.score || (score == other.score && sequence_index < other.sequence_index);
+    }
+
+    friend constexpr bool operator==(search_hit const &, search_hit const &) noexcept = default;
+};
+
+/**
+ * @brief Collects the k best hits of a search.
+ *
+ * The hits are kept in a heap whose top is the worst collected hit. Once k hits are collected, its score is the
+ * threshold a new hit must reach to be collected, such that most hits are rejected with a single comparison.
+ * Ties are broken by the lower sequence index, which makes the result independent of the order in which the hits
+ * are inserted; hence, collectors filled by different threads can be merged into the same result as a single
+ * collector.
+ */
+class top_k_hits
+{
+private:
+
+    std::vector<search_hit> _heap{};
+    size_t _k{};
+
+    // The heap order: the hit ranking last is at the top.
+    static constexpr auto _ranks_before = [] (search_hit const & lhs, search_hit const & rhs) noexcept {
+        return lhs.ranks_before(rhs);
+    };
+
+public:
+
+    top_k_hits() = default;
+
+    //!\brief Constructs an empty collector for at most `k` hits.
+    explicit top_k_hits(size_t const k) : _k{k}
+    {
+        _heap.reserve(k);
+    }
+
+    //!\brief Returns the maximal number of collected hits.
+    size_t k() const noexcept
+    {
+        return _k;
+    }
+
+    //!\brief Returns the number of collected hits.
+    size_t size() const noexcept
+    {
+        return _heap.size();
+    }
+
+    //!\brief Returns whether k hits are collected.
+    bool full() const noexcept
+    {
+        return _heap.size() == _k;
+    }
+
+    /**
+     * @brief Returns the lowest score a new hit must have to be collected.
+     *
+     * Until k hits are collected every score is accepted. A hit with exactly the threshold score is only collected
+     * if its sequence index is lower than the one of the worst collected hit.
+     */
+    int32_t threshold() const noexcept
+    {
+        return full() && _k > 0 ? _heap.front().score : std::numeric_limits<int32_t>::lowest();
+    }
+
+    //!\brief Collects the hit if it ranks before the worst collected hit and returns whether it was collected.
+    bool insert(search_hit const hit)
+    {
+        if (_heap.size() < _k)
+        {
+            _heap.push_back(hit);
+            std::ranges::push_heap(_heap, _ranks_before);
+            return true;
+        }
+
+        if (_k == 0 || !hit.ranks_before(_heap.front()))
+            return false;
+
+        std::ranges::pop_heap(_heap, _ranks_before);
+        _heap.back() = hit;
+        std::ranges::push_heap(_heap, _ranks_before);
+        return true;
+    }
+
+    //!\brief Collects the hits of the other collector.
+    void merge(top_k_hits const & other)
+    {
+        for (search_hit const & hit : other._heap)
+        {
+            if (hit.score < threshold())
+                continue;
+
+            insert(hit);
+        }
+    }
+
+    //!\brief Returns the collected hits from the best to the worst hit.
+    std::vector<search_hit> sorted_hits() const
+    {
+        std::vector<search_hit> hits{_heap};
+        std::ranges::sort(hits, _ranks_before);
+        return hits;
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
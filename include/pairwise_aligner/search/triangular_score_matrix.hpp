@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::triangular_score_matrix.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief The scores of all pairs of a sequence set stored as the upper triangle of the symmetric score matrix.
+ *
+ * The triangle includes the diagonal and is stored row by row: row `i` holds the scores of the pairs `(i, j)` with
+ * `i <= j < n`. Hence, the matrix stores `n * (n + 1) / 2` scores instead of `n * n`. The scores are either kept in
+ * memory or in a file mapped into memory, whose pages are written back by the operating system; for large sequence
+ * sets the triangle exceeds the main memory. The file contains only the scores as 32-bit integers in the byte
+ * order of the host, such that it can be mapped again with seqan::pairwise_aligner::mapped_file.
+ */
+class triangular_score_matrix
+{
+private:
+    std::vector<int32_t> _buffer{};
+    int32_t * _scores{};
+    size_t _sequence_count{};
+    size_t _mapped_bytes{};
+
+public:
+
+    triangular_score_matrix() = default;
+    triangular_score_matrix(triangular_score_matrix const &) = delete;
+    triangular_score_matrix(triangular_score_matrix && other) noexcept :
+        _buffer{std::move(other._buffer)},
+        _scores{std::exchange(other._scores, nullptr)},
+        _sequence_count{std::exchange(other._sequence_count, 0)},
+        _mapped_bytes{std::exchange(other._mapped_bytes, 0)}
+    {}
+
+    triangular_score_matrix & operator=(triangular_score_matrix const &) = delete;
+    triangular_score_matrix & operator=(triangular_score_matrix && other) noexcept
+    {
+        std::swap(_buffer, other._buffer);
+        std::swap(_scores, other._scores);
+        std::swap(_sequence_count, other._sequence_count);
+        std::swap(_mapped_bytes, other._mapped_bytes);
+        return *this;
+    }
+
+    ~triangular_score_matrix()
+    {
+        if (_mapped_bytes > 0)
+            ::munmap(_scores, _mapped_bytes);
+    }
+
+    //!\brief Allocates the triangle for the given number of sequences in memory.
+    explicit triangular_score_matrix(size_t const sequence_count) :
+        _buffer(entry_count(sequence_count)),
+        _scores{_buffer.data()},
+        _sequence_count{sequence_count}
+    {}
+
+    /**
+     * @brief Creates the file holding the triangle for the given number of sequences and maps it into memory.
+     *
+     * An existing file is overwritten.
+     *
+     * @throws std::runtime_error if the file cannot be created, resized or mapped.
+     */
+    triangular_score_matrix(size_t const sequence_count, std::filesystem::path const & file_path) :
+        _sequence_count{sequence_count}
+    {
+        int const file_descriptor = ::open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file_descriptor < 0)
+            throw std::runtime_error{"Could not create the score matrix file " + file_path.string() + "."};
+
+        size_t const byte_count = entry_count(sequence_count) * sizeof(int32_t);
+        if (::ftruncate(file_descriptor, byte_count) != 0)
+        {
+            ::close(file_descriptor);
+            throw std::runtime_error{"Could not resize the score matrix file " + file_path.string() + "."};
+        }
+
+        if (byte_count == 0) // Empty files cannot be mapped.
+        {
+            ::close(file_descriptor);
+            return;
+        }
+
+        void * data = ::mmap(nullptr, byte_count, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+        ::close(file_descriptor); // The mapping keeps the file open.
+        if (data == MAP_FAILED)
+            throw std::runtime_error{"Could not map the score matrix file " + file_path.string() + "."};
+
+        _scores = static_cast<int32_t *>(data);
+        _mapped_bytes = byte_count;
+    }
+
+    //!\brief Returns the number of scores stored for the given number of sequences.
+    static constexpr size_t entry_count(size_t const sequence_count) noexcept
+    {
+        return sequence_count * (sequence_count + 1) / 2;
+    }
+
+    //!\brief Returns the number of sequences.
+    size_t sequence_count() const noexcept
+    {
+        return _sequence_count;
+    }
+
+    //!\brief Returns the position of the score of the given pair in the triangle; the order of the pair is irrelevant.
+    size_t entry_index(size_t row, size_t column) const noexcept
+    {
+        if (row > column)
+            std::swap(row, column);
+
+        // The rows before `row` hold n + (n - 1) + ... + (n - row + 1) scores.
+        return row * (2 * _sequence_count - row + 1) / 2 + (column - row);
+    }
+
+    //!\brief Returns the score of the given pair; the order of the pair is irrelevant.
+    int32_t & operator()(size_t const row, size_t const column) noexcept
+    {
+        return _scores[entry_index(row, column)];
+    }
+
+    //!\copydoc operator()
+    int32_t operator()(size_t const row, size_t const column) const noexcept
+    {
+        return _scores[entry_index(row, column)];
+    }
+
+    //!\brief Returns the scores of the triangle row by row.
+    std::span<int32_t> scores() noexcept
+    {
+        return std::span{_scores, entry_count(_sequence_count)};
+    }
+
+    //!\copydoc scores
+    std::span<int32_t const> scores() const noexcept
+    {
+        return std::span{_scores, entry_count(_sequence_count)};
+    }
+
+    /**
+     * @brief Writes the mapped scores back to the file and waits until they are written.
+     *
+     * Does nothing if the scores are kept in memory.
+     *
+     * @throws std::runtime_error if the scores cannot be written.
+     */
+    void flush() const
+    {
+        if (_mapped_bytes > 0 && ::msync(_scores, _mapped_bytes, MS_SYNC) != 0)
+            throw std::runtime_error{"Could not write the score matrix file."};
+    }
+};
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
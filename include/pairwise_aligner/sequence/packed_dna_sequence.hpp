@@ -0,0 +1,308 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::packed_dna_sequence.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief A DNA sequence storing every nucleotide with two bits.
+ *
+ * The nucleotides A, C, G and T are encoded with the ranks 0 to 3, where 32 nucleotides are stored in one word with
+ * the first nucleotide in the lowest bits. Every other symbol is read as N. The positions of the N symbols are
+ * stored in a separate mask with one bit per position, which is only allocated if the sequence contains an N.
+ * The sequence is a random access range over the decoded symbols. If a bulk of packed sequences is given to the
+ * simd aligners, the sequences are decoded and transposed in one step instead; see
+ * seqan::pairwise_aligner::detail::unpack_and_transpose.
+ */
+class packed_dna_sequence
+{
+private:
+
+    class iterator;
+
+    std::vector<uint64_t> _words{};
+    std::vector<uint64_t> _unknown_mask{};
+    size_t _size{};
+
+public:
+
+    //!\brief The number of symbols stored in one word.
+    static constexpr size_t symbols_per_word = 32;
+    //!\brief The symbols encoded by the ranks 0 to 3.
+    static constexpr std::array<char, 4> symbols{'A', 'C', 'G', 'T'};
+    //!\brief The symbol of the positions set in the mask.
+    static constexpr char unknown_symbol = 'N';
+
+    packed_dna_sequence() = default;
+    template <std::ranges::input_range sequence_t>
+        requires std::convertible_to<std::ranges::range_reference_t<sequence_t>, char>
+    explicit packed_dna_sequence(sequence_t && sequence)
+    {
+        if constexpr (std::ranges::sized_range<sequence_t>)
+            _words.reserve((std::ranges::size(sequence) + symbols_per_word - 1) / symbols_per_word);
+
+        for (char const symbol : sequence)
+            push_back(symbol);
+    }
+
+    void push_back(char const symbol)
+    {
+        size_t const word_idx = _size / symbols_per_word;
+        size_t const shift = _size % symbols_per_word;
+        if (shift == 0)
+            _words.push_back(0);
+
+        uint64_t rank{};
+        switch (symbol)
+        {
+            case 'A': case 'a': rank = 0; break;
+            case 'C': case 'c': rank = 1; break;
+            case 'G': case 'g': rank = 2; break;
+            case 'T': case 't': case 'U': case 'u': rank = 3; break;
+            default:
+            {
+                _unknown_mask.resize(_words.size(), 0);
+                _unknown_mask[word_idx] |= uint64_t{1} << shift;
+            }
+        }
+        _words[word_idx] |= rank << (2 * shift);
+        ++_size;
+    }
+
+    char operator[](size_t const pos) const noexcept
+    {
+        size_t const word_idx = pos / symbols_per_word;
+        size_t const shift = pos % symbols_per_word;
+        if (word_idx < _unknown_mask.size() && ((_unknown_mask[word_idx] >> shift) & 1))
+            return unknown_symbol;
+
+        return symbols[(_words[word_idx] >> (2 * shift)) & 3];
+    }
+
+    size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+    //!\brief Returns the words storing the ranks.
+    std::span<uint64_t const> words() const noexcept
+    {
+        return _words;
+    }
+
+    //!\brief Returns the mask of the N symbols, which ends after the word of the last N symbol.
+    std::span<uint64_t const> unknown_mask() const noexcept
+    {
+        return _unknown_mask;
+    }
+};
+
+class packed_dna_sequence::iterator
+{
+private:
+    packed_dna_sequence const * _sequence{};
+    std::ptrdiff_t _position{};
+
+public:
+
+    using value_type = char;
+    using reference = char;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag; // The symbols are returned by value.
+    using iterator_concept = std::random_access_iterator_tag;
+
+    iterator() = default;
+    explicit iterator(packed_dna_sequence const & sequence, std::ptrdiff_t const position) noexcept :
+        _sequence{&sequence},
+        _position{position}
+    {}
+
+    reference operator*() const noexcept
+    {
+        return (*_sequence)[_position];
+    }
+
+    reference operator[](difference_type const offset) const noexcept
+    {
+        return (*_sequence)[_position + offset];
+    }
+
+    iterator & operator++() noexcept
+    {
+        ++_position;
+        return *this;
+    }
+
+    iterator operator++(int) noexcept
+    {
+        iterator tmp{*this};
+        ++_position;
+        return tmp;
+    }
+
+    iterator & operator--() noexcept
+    {
+        --_position;
+        return *this;
+    }
+
+    iterator operator--(int) noexcept
+    {
+        iterator tmp{*this};
+        --_position;
+        return tmp;
+    }
+
+    iterator & operator+=(difference_type const offset) noexcept
+    {
+        _position += offset;
+        return *this;
+    }
+
+    iterator & operator-=(difference_type const offset) noexcept
+    {
+        _position -= offset;
+        return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type const offset) noexcept
+    {
+        return it += offset;
+    }
+
+    friend iterator operator+(difference_type const offset, iterator it) noexcept
+    {
+        return it += offset;
+    }
+
+    friend iterator operator-(iterator it, difference_type const offset) noexcept
+    {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept
+    {
+        return lhs._position - rhs._position;
+    }
+
+    friend bool operator==(iterator const & lhs, iterator const & rhs) noexcept
+    {
+        return lhs._position == rhs._position;
+    }
+
+    friend std::strong_ordering operator<=>(iterator const & lhs, iterator const & rhs) noexcept
+    {
+        return lhs._position <=> rhs._position;
+    }
+};
+
+inline packed_dna_sequence::iterator packed_dna_sequence::begin() const noexcept
+{
+    return iterator{*this, 0};
+}
+
+inline packed_dna_sequence::iterator packed_dna_sequence::end() const noexcept
+{
+    return iterator{*this, static_cast<std::ptrdiff_t>(_size)};
+}
+
+template <typename sequence_collection_t>
+concept packed_dna_collection = std::ranges::forward_range<sequence_collection_t> &&
+                                std::same_as<std::ranges::range_value_t<sequence_collection_t>, packed_dna_sequence>;
+
+namespace detail
+{
+
+/**
+ * @brief Decodes a bulk of packed sequences directly into the transposed simd sequence.
+ *
+ * Instead of decoding every sequence into a buffer, which is then transposed, the words of all lanes at the same
+ * position are decoded together, such that the loops over the lanes can be vectorised.
+ * The positions after the end of a sequence and the lanes without sequence are filled with the padding symbol.
+ */
+template <typename simd_t, packed_dna_collection sequence_collection_t, typename simd_sequence_t>
+void unpack_and_transpose(sequence_collection_t && sequence_collection,
+                          typename simd_t::value_type const padding_symbol,
+                          simd_sequence_t & simd_sequence)
+{
+    using scalar_t = typename simd_t::value_type;
+    constexpr size_t lane_count = simd_t::size_v;
+    constexpr size_t symbols_per_word = packed_dna_sequence::symbols_per_word;
+
+    std::array<packed_dna_sequence const *, lane_count> sequences{};
+    std::array<uint64_t, lane_count> sequence_sizes{};
+    size_t max_sequence_size = 0;
+    size_t sequence_count = 0;
+    for (packed_dna_sequence const & sequence : sequence_collection)
+    {
+        sequences[sequence_count] = &sequence;
+        sequence_sizes[sequence_count] = sequence.size();
+        max_sequence_size = std::max<size_t>(max_sequence_size, sequence.size());
+        ++sequence_count;
+    }
+
+    simd_sequence.resize(max_sequence_size);
+
+    std::array<uint64_t, lane_count> words{};
+    std::array<uint64_t, lane_count> unknown_masks{};
+    alignas(simd_t) std::array<scalar_t, lane_count> lane_symbols{};
+
+    for (size_t word_idx = 0; word_idx * symbols_per_word < max_sequence_size; ++word_idx)
+    {
+        // Gather the current word of every lane; lanes without sequence or past their end read empty words.
+        for (size_t lane = 0; lane < lane_count; ++lane)
+        {
+            packed_dna_sequence const * sequence = sequences[lane];
+            bool const has_word = sequence != nullptr && word_idx < sequence->words().size();
+            words[lane] = has_word ? sequence->words()[word_idx] : 0;
+            unknown_masks[lane] = (has_word && word_idx < sequence->unknown_mask().size())
+                                ? sequence->unknown_mask()[word_idx]
+                                : 0;
+        }
+
+        size_t const first_position = word_idx * symbols_per_word;
+        size_t const last_position = std::min(first_position + symbols_per_word, max_sequence_size);
+        for (size_t position = first_position; position < last_position; ++position)
+        {
+            size_t const shift = position - first_position;
+            for (size_t lane = 0; lane < lane_count; ++lane)
+            {
+                uint64_t const rank = (words[lane] >> (2 * shift)) & 3;
+                scalar_t symbol = (rank == 0) ? 'A' : (rank == 1) ? 'C' : (rank == 2) ? 'G' : 'T';
+                symbol = ((unknown_masks[lane] >> shift) & 1) ? packed_dna_sequence::unknown_symbol : symbol;
+                lane_symbols[lane] = (position < sequence_sizes[lane]) ? symbol : padding_symbol;
+            }
+            simd_sequence[position].load(lane_symbols.data());
+        }
+    }
+}
+
+} // namespace detail
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
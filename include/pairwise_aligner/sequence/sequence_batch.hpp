@@ -0,0 +1,239 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::sequence_batch, seqan::pairwise_aligner::profiled_sequence_batch and
+ *        seqan::pairwise_aligner::prepared_sequence.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <seqan3/utility/container/aligned_allocator.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+/**
+ * @brief A sequence whose symbols were already transformed by all transformation layers of a dp vector.
+ *
+ * The transformation layers pass a prepared sequence unchanged to the dp vector they wrap.
+ */
+template <typename symbol_t>
+class prepared_sequence : public std::span<symbol_t const>
+{
+private:
+    using base_t = std::span<symbol_t const>;
+
+public:
+
+    prepared_sequence() = default;
+    explicit prepared_sequence(base_t symbols) noexcept : base_t{symbols}
+    {}
+};
+
+template <typename sequence_t>
+inline constexpr bool is_prepared_sequence_v = false;
+
+/**
+ * @brief A prepared sequence, which also refers to the substitution profile built over all of its symbols.
+ *
+ * The dp algorithm takes the profiles of the slices it computes from this profile instead of building them again.
+ */
+template <typename symbol_t, typename profile_t>
+class profiled_sequence : public prepared_sequence<symbol_t>
+{
+private:
+    using base_t = prepared_sequence<symbol_t>;
+
+    profile_t const * _profile{};
+
+public:
+
+    using profile_type = profile_t;
+
+    profiled_sequence() = default;
+    explicit profiled_sequence(base_t symbols, profile_t const & profile) noexcept :
+        base_t{std::move(symbols)},
+        _profile{std::addressof(profile)}
+    {}
+
+    //!\brief Returns the profile built over all symbols of the sequence.
+    profile_t const & profile() const noexcept
+    {
+        return *_profile;
+    }
+};
+
+template <typename symbol_t>
+inline constexpr bool is_prepared_sequence_v<prepared_sequence<symbol_t>> = true;
+
+template <typename symbol_t, typename profile_t>
+inline constexpr bool is_prepared_sequence_v<profiled_sequence<symbol_t, profile_t>> = true;
+
+template <typename sequence_t>
+inline constexpr bool is_profiled_sequence_v = false;
+
+template <typename symbol_t, typename profile_t>
+inline constexpr bool is_profiled_sequence_v<profiled_sequence<symbol_t, profile_t>> = true;
+
+template <typename sequence_t>
+concept prepared_sequence_range = std::ranges::forward_range<sequence_t> &&
+                                  is_prepared_sequence_v<std::remove_cvref_t<sequence_t>>;
+
+/**
+ * @brief A bulk of sequences, which is transposed, padded and transformed once for many alignments.
+ *
+ * The batch is created by the bulk interfaces of the aligner, e.g. with `make_sequence_batch2`, and can be passed
+ * instead of the sequence bulk to every call of compute. The symbols are stored as the interleaved and
+ * transformed sequence, which the dp vectors of the aligner would compute on every call otherwise.
+ * The original symbols are not kept. Instead every sequence of the batch is represented by the range of its
+ * positions, which provides the sequence sizes needed to extract the results.
+ *
+ * @tparam symbol_t The type of the transformed simd symbols.
+ * @tparam symbol_storage_t The type storing the symbols; a std::span refers to symbols stored elsewhere, e.g. in a
+ *                          memory mapped seqan::pairwise_aligner::sequence_database.
+ */
+template <typename symbol_t,
+          typename symbol_storage_t = std::vector<symbol_t, seqan3::aligned_allocator<symbol_t, alignof(symbol_t)>>>
+class sequence_batch
+{
+private:
+    using sequence_t = std::ranges::iota_view<size_t, size_t>;
+
+    symbol_storage_t _symbols{};
+    std::vector<sequence_t> _sequences{};
+
+public:
+
+    using symbol_type = symbol_t;
+    using value_type = sequence_t;
+    using reference = sequence_t const &;
+    using const_reference = sequence_t const &;
+
+    sequence_batch() = default;
+    template <std::ranges::input_range sequence_sizes_t>
+    explicit sequence_batch(symbol_storage_t symbols, sequence_sizes_t && sequence_sizes) :
+        _symbols{std::move(symbols)}
+    {
+        for (size_t sequence_size : sequence_sizes)
+            _sequences.emplace_back(size_t{0}, sequence_size);
+    }
+
+    const_reference operator[](size_t const index) const noexcept
+    {
+        return _sequences[index];
+    }
+
+    size_t size() const noexcept
+    {
+        return _sequences.size();
+    }
+
+    auto begin() const noexcept
+    {
+        return _sequences.begin();
+    }
+
+    auto end() const noexcept
+    {
+        return _sequences.end();
+    }
+
+    //!\brief Returns the transformed symbols, which are passed unchanged to the innermost dp vector.
+    prepared_sequence<symbol_t> symbols() const noexcept
+    {
+        return prepared_sequence<symbol_t>{std::span<symbol_t const>{_symbols}};
+    }
+};
+
+/**
+ * @brief A seqan::pairwise_aligner::sequence_batch together with the substitution profile built over its symbols.
+ *
+ * The one-to-many aligners build a profile of the substitution scores for every slice of the second sequences they
+ * compute, on every call of compute. A profiled batch, created with `make_profiled_sequence_batch2`, builds this
+ * profile once, such that aligning many first sequences against the same batch only reads it. The profile is
+ * shared by the copies of the batch and never modified, i.e. the batch can be used by many threads at the same time.
+ *
+ * @tparam batch_t The type of the wrapped seqan::pairwise_aligner::sequence_batch.
+ * @tparam profile_t The type of the profile of the substitution model.
+ */
+template <typename batch_t, typename profile_t>
+class profiled_sequence_batch : public batch_t
+{
+private:
+    std::shared_ptr<profile_t const> _profile{};
+
+public:
+
+    profiled_sequence_batch() = default;
+    explicit profiled_sequence_batch(batch_t batch, profile_t profile) :
+        batch_t{std::move(batch)},
+        _profile{std::make_shared<profile_t const>(std::move(profile))}
+    {}
+
+    //!\brief Returns the transformed symbols together with their profile.
+    auto symbols() const noexcept
+    {
+        using symbol_t = typename batch_t::symbol_type;
+        return profiled_sequence<symbol_t, profile_t>{batch_t::symbols(), *_profile};
+    }
+};
+
+template <typename sequence_t>
+inline constexpr bool is_sequence_batch_v = false;
+
+template <typename symbol_t, typename symbol_storage_t>
+inline constexpr bool is_sequence_batch_v<sequence_batch<symbol_t, symbol_storage_t>> = true;
+
+template <typename batch_t, typename profile_t>
+inline constexpr bool is_sequence_batch_v<profiled_sequence_batch<batch_t, profile_t>> = true;
+
+template <typename sequence_t>
+concept sequence_batch_range = std::ranges::forward_range<sequence_t> &&
+                               is_sequence_batch_v<std::remove_cvref_t<sequence_t>>;
+
+namespace detail
+{
+
+// Applies the transformations of the wrapped dp vector if it provides any, otherwise returns the given sequence.
+template <typename dp_vector_t, typename sequence_t>
+auto prepare_sequence(dp_vector_t const & dp_vector, sequence_t && sequence)
+{
+    if constexpr (requires { dp_vector.prepare(std::forward<sequence_t>(sequence)); })
+        return dp_vector.prepare(std::forward<sequence_t>(sequence));
+    else
+        return std::remove_cvref_t<sequence_t>{std::forward<sequence_t>(sequence)};
+}
+
+} // namespace detail
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
+
+// A prepared sequence is a view over the symbols stored in the sequence batch like the std::span it refines.
+template <typename symbol_t>
+inline constexpr bool std::ranges::enable_view<seqan::pairwise_aligner::prepared_sequence<symbol_t>> = true;
+
+template <typename symbol_t>
+inline constexpr bool std::ranges::enable_borrowed_range<seqan::pairwise_aligner::prepared_sequence<symbol_t>> = true;
+
+template <typename symbol_t, typename profile_t>
+inline constexpr bool std::ranges::enable_view<seqan::pairwise_aligner::profiled_sequence<symbol_t, profile_t>> = true;
+
+template <typename symbol_t, typename profile_t>
+inline constexpr bool
+    std::ranges::enable_borrowed_range<seqan::pairwise_aligner::profiled_sequence<symbol_t, profile_t>> = true;
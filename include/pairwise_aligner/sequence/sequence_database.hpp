@@ -0,0 +1,294 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::sequence_database and seqan::pairwise_aligner::write_sequence_database.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/io/mapped_file.hpp>
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace detail
+{
+
+// The file starts with the header, followed by the sizes and indices of the sequences and the symbols of every
+// batch. The table with one entry per batch is stored at the end, as the offsets are known only after writing the
+// batches. All values are stored in the byte order of the host.
+struct sequence_database_header
+{
+    std::array<char, 8> magic{};
+    uint64_t version{};
+    uint64_t symbol_size{};
+    uint64_t bulk_size{};
+    uint64_t sequence_count{};
+    uint64_t batch_count{};
+    uint64_t batch_table_offset{};
+};
+
+struct sequence_database_batch_entry
+{
+    uint64_t sequence_offset{}; // The sizes of the sequences followed by their indices in the original collection.
+    uint64_t sequence_count{};
+    uint64_t symbol_offset{};
+    uint64_t symbol_count{};
+};
+
+inline constexpr std::array<char, 8> sequence_database_magic{'P', 'A', 'S', 'E', 'Q', 'D', 'B', '\0'};
+inline constexpr uint64_t sequence_database_version = 1;
+// Aligns the symbols for the widest simd type; the mapped file starts at a page boundary.
+inline constexpr uint64_t sequence_database_alignment = 64;
+
+} // namespace detail
+
+/**
+ * @brief A memory mapped database of sequence batches written by seqan::pairwise_aligner::write_sequence_database.
+ *
+ * The batches refer to the mapped file, such that neither the sequences are parsed nor the symbols are copied when
+ * the database is opened or accessed. The sequences are sorted by their size before they are distributed into the
+ * batches. seqan::pairwise_aligner::sequence_database::sequence_indices maps the sequences of a batch back to their
+ * position in the original collection.
+ * The database can only be used with an aligner that uses the same configuration as the aligner that wrote it.
+ *
+ * @tparam symbol_t The type of the transformed symbols; see seqan::pairwise_aligner::sequence_batch::symbol_type.
+ */
+template <typename symbol_t>
+class sequence_database
+{
+private:
+    static_assert(std::is_trivially_copyable_v<symbol_t>, "The symbols must be stored as plain bytes.");
+
+    using header_t = detail::sequence_database_header;
+    using batch_entry_t = detail::sequence_database_batch_entry;
+
+    mapped_file _file{};
+    header_t _header{};
+
+public:
+
+    using batch_type = sequence_batch<symbol_t, std::span<symbol_t const>>;
+
+    sequence_database() = default;
+
+    /**
+     * @brief Maps the given database file into memory.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or was not written for this symbol type.
+     */
+    explicit sequence_database(std::filesystem::path const & file_path) : _file{file_path}
+    {
+        if (_file.size() < sizeof(header_t))
+            throw std::runtime_error{"The sequence database " + file_path.string() + " is too small."};
+
+        std::memcpy(&_header, _file.data(), sizeof(header_t));
+
+        if (_header.magic != detail::sequence_database_magic ||
+            _header.version != detail::sequence_database_version ||
+            _header.symbol_size != sizeof(symbol_t) ||
+            !fits(_header.batch_table_offset, _header.batch_count * sizeof(batch_entry_t)))
+        {
+            throw std::runtime_error{"The file " + file_path.string() + " is not a sequence database of the "
+                                     "expected symbol type."};
+        }
+    }
+
+    //!\brief Returns the number of batches.
+    size_t size() const noexcept
+    {
+        return _header.batch_count;
+    }
+
+    //!\brief Returns the number of sequences in all batches.
+    size_t sequence_count() const noexcept
+    {
+        return _header.sequence_count;
+    }
+
+    //!\brief Returns the number of sequences per batch, except for the last batch, which might contain less.
+    size_t bulk_size() const noexcept
+    {
+        return _header.bulk_size;
+    }
+
+    //!\brief Returns the batch at the given position, which refers to the mapped memory of the database.
+    batch_type operator[](size_t const batch_idx) const
+    {
+        batch_entry_t const entry = batch_entry(batch_idx);
+        symbol_t const * symbols = reinterpret_cast<symbol_t const *>(_file.data() + entry.symbol_offset);
+        return batch_type{std::span{symbols, entry.symbol_count}, sequence_data(entry).first(entry.sequence_count)};
+    }
+
+    //!\brief Returns the positions of the sequences of the given batch in the collection the database was built from.
+    std::span<uint64_t const> sequence_indices(size_t const batch_idx) const
+    {
+        batch_entry_t const entry = batch_entry(batch_idx);
+        return sequence_data(entry).subspan(entry.sequence_count);
+    }
+
+private:
+
+    bool fits(uint64_t const offset, uint64_t const byte_count) const noexcept
+    {
+        return offset <= _file.size() && byte_count <= _file.size() - offset;
+    }
+
+    batch_entry_t batch_entry(size_t const batch_idx) const
+    {
+        if (batch_idx >= size())
+            throw std::out_of_range{"The batch " + std::to_string(batch_idx) + " is not in the sequence database."};
+
+        batch_entry_t entry{};
+        std::memcpy(&entry,
+                    _file.data() + _header.batch_table_offset + batch_idx * sizeof(batch_entry_t),
+                    sizeof(entry));
+
+        if (!fits(entry.sequence_offset, 2 * entry.sequence_count * sizeof(uint64_t)) ||
+            !fits(entry.symbol_offset, entry.symbol_count * sizeof(symbol_t)))
+            throw std::runtime_error{"The batch " + std::to_string(batch_idx) +
+                                     " of the sequence database is corrupt."};
+
+        return entry;
+    }
+
+    // Returns the sizes followed by the indices of the sequences.
+    std::span<uint64_t const> sequence_data(batch_entry_t const & entry) const noexcept
+    {
+        uint64_t const * data = reinterpret_cast<uint64_t const *>(_file.data() + entry.sequence_offset);
+        return std::span{data, 2 * entry.sequence_count};
+    }
+};
+
+/**
+ * @brief Writes the given sequences as batches prepared by the given aligner to a sequence database.
+ *
+ * The sequences are sorted by their size, such that every batch holds sequences of similar size and the padding
+ * is minimised. Every batch is prepared with `aligner.make_sequence_batch2`, i.e. the database can be used as the
+ * second sequences of an aligner with the same configuration. Use the symbol type of the prepared batches to open
+ * the database again, e.g. with seqan::pairwise_aligner::open_sequence_database.
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ */
+template <typename aligner_t, std::ranges::random_access_range sequence_collection_t>
+    requires std::ranges::forward_range<std::ranges::range_reference_t<sequence_collection_t>>
+void write_sequence_database(std::filesystem::path const & file_path,
+                             aligner_t const & aligner,
+                             sequence_collection_t && sequences)
+{
+    using sequence_t = decltype(std::views::all(*std::ranges::begin(sequences)));
+    using batch_t = decltype(aligner.make_sequence_batch2(std::declval<std::vector<sequence_t> &>()));
+    using symbol_t = typename batch_t::symbol_type;
+    static_assert(std::is_trivially_copyable_v<symbol_t>, "The symbols must be stored as plain bytes.");
+
+    size_t const sequence_count = std::ranges::distance(sequences);
+    std::vector<uint64_t> sequence_order(sequence_count);
+    std::iota(sequence_order.begin(), sequence_order.end(), 0);
+    std::ranges::stable_sort(sequence_order, std::less<>{}, [&] (uint64_t const index) {
+        return std::ranges::distance(sequences[index]);
+    });
+
+    std::ofstream database_stream{file_path, std::ios::binary | std::ios::trunc};
+    if (!database_stream)
+        throw std::runtime_error{"Could not create the sequence database " + file_path.string() + "."};
+
+    auto write_bytes = [&] (void const * data, size_t const byte_count) {
+        database_stream.write(static_cast<char const *>(data), byte_count);
+    };
+
+    auto align_stream = [&] (uint64_t const alignment) -> uint64_t {
+        uint64_t position = database_stream.tellp();
+        for (; position % alignment != 0; ++position)
+            database_stream.put('\0');
+        return position;
+    };
+
+    detail::sequence_database_header header{};
+    write_bytes(&header, sizeof(header)); // Overwritten when all batches are written.
+
+    std::vector<detail::sequence_database_batch_entry> batch_table{};
+    std::vector<sequence_t> bulk{};
+    std::vector<uint64_t> sequence_sizes{};
+    for (size_t first = 0; first < sequence_count; first += aligner.bulk_size())
+    {
+        size_t const last = std::min(first + aligner.bulk_size(), sequence_count);
+        std::span const bulk_order{sequence_order.data() + first, last - first};
+
+        bulk.clear();
+        sequence_sizes.clear();
+        for (uint64_t const index : bulk_order)
+        {
+            bulk.push_back(std::views::all(sequences[index]));
+            sequence_sizes.push_back(std::ranges::distance(sequences[index]));
+        }
+
+        batch_t batch = aligner.make_sequence_batch2(bulk);
+
+        detail::sequence_database_batch_entry & entry = batch_table.emplace_back();
+        entry.sequence_count = bulk.size();
+        entry.sequence_offset = align_stream(detail::sequence_database_alignment);
+        write_bytes(sequence_sizes.data(), sequence_sizes.size() * sizeof(uint64_t));
+        write_bytes(bulk_order.data(), bulk_order.size() * sizeof(uint64_t));
+
+        entry.symbol_count = batch.symbols().size();
+        entry.symbol_offset = align_stream(detail::sequence_database_alignment);
+        write_bytes(batch.symbols().data(), batch.symbols().size_bytes());
+    }
+
+    header.magic = detail::sequence_database_magic;
+    header.version = detail::sequence_database_version;
+    header.symbol_size = sizeof(symbol_t);
+    header.bulk_size = aligner.bulk_size();
+    header.sequence_count = sequence_count;
+    header.batch_count = batch_table.size();
+    header.batch_table_offset = align_stream(alignof(detail::sequence_database_batch_entry));
+    write_bytes(batch_table.data(), batch_table.size() * sizeof(detail::sequence_database_batch_entry));
+
+    database_stream.seekp(0);
+    write_bytes(&header, sizeof(header));
+
+    if (!database_stream.flush())
+        throw std::runtime_error{"Could not write the sequence database " + file_path.string() + "."};
+}
+
+/**
+ * @brief Opens the sequence database written with the given aligner.
+ *
+ * Deduces the symbol type of seqan::pairwise_aligner::sequence_database from the batches prepared by the aligner.
+ *
+ * @throws std::runtime_error if the file cannot be mapped or was not written for this symbol type.
+ */
+template <typename aligner_t>
+auto open_sequence_database(std::filesystem::path const & file_path, aligner_t const & aligner)
+{
+    using batch_t = decltype(aligner.make_sequence_batch2(std::declval<std::vector<std::string> const &>()));
+    return sequence_database<typename batch_t::symbol_type>{file_path};
+}
+
+} // inline namespace v1
+}  // namespace seqan::pairwise_aligner
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <concepts>
+#include <functional>
 #include <type_traits>
 
 #include <pairwise_aligner/simd/host_simd_tag.hpp>
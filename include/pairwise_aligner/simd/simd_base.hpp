@@ -41,6 +41,12 @@ struct simd_selector;
 template <size_t operand_count, size_t operand_bit_width, size_t simd_bit_width>
 struct selector_tag;
 
+template <typename simd_key_t, typename gather_tag_t>
+struct simd_gather;
+
+template <size_t value_bit_width, size_t key_bit_width, size_t simd_bit_width>
+struct gather_tag;
+
 template <typename score_t, size_t simd_size, template <typename > typename ...policies_t>
 struct simd_score_base;
 
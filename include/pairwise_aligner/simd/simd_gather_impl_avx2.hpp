@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides implementation for avx2 gather.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <immintrin.h>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <pairwise_aligner/simd/simd_base.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// epi8
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Gathers 8-bit values from a row-major table using the AVX2 32-bit gather instruction.
+ *
+ * The 8-bit keys are widened to 32-bit table offsets in four chunks of eight lanes. Every chunk is gathered with
+ * a byte granular scale, such that each gathered 32-bit value contains the addressed byte in its lowest 8 bits.
+ * The table must therefore be padded by three bytes to keep the last access within the allocated memory.
+ * Finally, the masked values are packed back into a single 8-bit vector. As the pack instructions operate within
+ * the 128-bit lanes, the resulting double words are permuted to restore the original lane order.
+ */
+template <typename simd_key_t>
+struct simd_gather<simd_key_t, gather_tag<8, 8, 256>>
+{
+    static constexpr size_t table_padding = sizeof(int32_t) - 1;
+
+    template <typename simd_value_t, typename value_t>
+    static simd_value_t gather(value_t const * table,
+                               simd_key_t const & row_keys,
+                               simd_key_t const & column_keys,
+                               int32_t const row_stride) noexcept
+    {
+        static_assert(sizeof(value_t) == 1, "Only 8-bit values can be gathered.");
+
+        int const * base = reinterpret_cast<int const *>(table);
+        __m256i const & rows = to_native(row_keys);
+        __m256i const & columns = to_native(column_keys);
+        __m256i const stride = _mm256_set1_epi32(row_stride);
+
+        __m256i values01 = _mm256_packus_epi32(gather_chunk<0>(base, rows, columns, stride),
+                                               gather_chunk<1>(base, rows, columns, stride));
+        __m256i values23 = _mm256_packus_epi32(gather_chunk<2>(base, rows, columns, stride),
+                                               gather_chunk<3>(base, rows, columns, stride));
+        __m256i values = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(values01, values23),
+                                                     _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        return reinterpret_cast<simd_value_t const &>(values);
+    }
+
+private:
+
+    template <int chunk>
+    static __m256i gather_chunk(int const * base,
+                                __m256i const & rows,
+                                __m256i const & columns,
+                                __m256i const & stride) noexcept
+    {
+        __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(widen<chunk>(rows), stride), widen<chunk>(columns));
+        return _mm256_and_si256(_mm256_i32gather_epi32(base, offsets, 1), _mm256_set1_epi32(0xFF));
+    }
+
+    template <int chunk>
+    static __m256i widen(__m256i const & keys) noexcept
+    {
+        __m128i half{};
+        if constexpr (chunk < 2)
+            half = _mm256_castsi256_si128(keys);
+        else
+            half = _mm256_extracti128_si256(keys, 1);
+
+        if constexpr (chunk % 2 == 1)
+            half = _mm_srli_si128(half, 8);
+
+        return _mm256_cvtepu8_epi32(half);
+    }
+
+    static __m256i const & to_native(simd_key_t const & packed) noexcept
+    {
+        return reinterpret_cast<__m256i const &>(packed);
+    }
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
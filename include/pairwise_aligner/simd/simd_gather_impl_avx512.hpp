@@ -0,0 +1,90 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides implementation for avx512 gather.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <immintrin.h>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <pairwise_aligner/simd/simd_base.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// epi8
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Gathers 8-bit values from a row-major table using the AVX512 32-bit gather instruction.
+ *
+ * Works like the AVX2 version but gathers four chunks of sixteen lanes and truncates the gathered values with
+ * `vpmovdb`, which keeps the lane order such that no additional permutation is required.
+ */
+template <typename simd_key_t>
+struct simd_gather<simd_key_t, gather_tag<8, 8, 512>>
+{
+    static constexpr size_t table_padding = sizeof(int32_t) - 1;
+
+    template <typename simd_value_t, typename value_t>
+    static simd_value_t gather(value_t const * table,
+                               simd_key_t const & row_keys,
+                               simd_key_t const & column_keys,
+                               int32_t const row_stride) noexcept
+    {
+        static_assert(sizeof(value_t) == 1, "Only 8-bit values can be gathered.");
+
+        void const * base = reinterpret_cast<void const *>(table);
+        __m512i const & rows = to_native(row_keys);
+        __m512i const & columns = to_native(column_keys);
+        __m512i const stride = _mm512_set1_epi32(row_stride);
+
+        __m512i values = _mm512_castsi128_si512(gather_chunk<0>(base, rows, columns, stride));
+        values = _mm512_inserti32x4(values, gather_chunk<1>(base, rows, columns, stride), 1);
+        values = _mm512_inserti32x4(values, gather_chunk<2>(base, rows, columns, stride), 2);
+        values = _mm512_inserti32x4(values, gather_chunk<3>(base, rows, columns, stride), 3);
+        return reinterpret_cast<simd_value_t const &>(values);
+    }
+
+private:
+
+    template <int chunk>
+    static __m128i gather_chunk(void const * base,
+                                __m512i const & rows,
+                                __m512i const & columns,
+                                __m512i const & stride) noexcept
+    {
+        __m512i offsets = _mm512_add_epi32(_mm512_mullo_epi32(widen<chunk>(rows), stride), widen<chunk>(columns));
+        return _mm512_cvtepi32_epi8(_mm512_i32gather_epi32(offsets, base, 1));
+    }
+
+    template <int chunk>
+    static __m512i widen(__m512i const & keys) noexcept
+    {
+        return _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(keys, chunk));
+    }
+
+    static __m512i const & to_native(simd_key_t const & packed) noexcept
+    {
+        return reinterpret_cast<__m512i const &>(packed);
+    }
+};
+
+} // namespace detail
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
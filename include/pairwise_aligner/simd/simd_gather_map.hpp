@@ -0,0 +1,136 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise::simd_gather_map.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+#include <seqan3/utility/container/aligned_allocator.hpp>
+
+#include <pairwise_aligner/simd/simd_base.hpp>
+#include <pairwise_aligner/simd/simd_gather_impl_avx2.hpp>
+#include <pairwise_aligner/simd/simd_gather_impl_avx512.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+
+namespace detail {
+// ----------------------------------------------------------------------------
+// Default
+// ----------------------------------------------------------------------------
+template <typename simd_key_t, size_t value_bit_width, size_t key_bit_width, size_t simd_bit_width>
+struct simd_gather<simd_key_t, gather_tag<value_bit_width, key_bit_width, simd_bit_width>>
+{
+    static constexpr size_t table_padding = 0;
+
+    template <typename simd_value_t, typename value_t>
+    static constexpr simd_value_t gather(value_t const * table,
+                                         simd_key_t const & row_keys,
+                                         simd_key_t const & column_keys,
+                                         int32_t const row_stride) noexcept
+    {
+        simd_value_t tmp{};
+        for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(simd_value_t::size_v); ++i) {
+            tmp[i] = table[row_keys[i] * row_stride + column_keys[i]];
+        }
+        return tmp;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief A two-dimensional map addressed by two simd vectors of ranks.
+ *
+ * @tparam value_t The scalar type of the stored values.
+ * @tparam key_t The scalar type of the ranks.
+ * @tparam dimension_v The number of rows and columns of the map.
+ *
+ * In contrast to the seqan::pairwise_aligner::simd_index_map, the values are not addressed by a single linearised
+ * offset but by the pair of ranks, which are converted into a row-major offset within the gather operation.
+ * Thus, the size of the map is not limited by the value range of the key type and alphabets with up to 256 symbols
+ * can be addressed with 8-bit ranks.
+ * If supported by the target architecture, the values are gathered with the corresponding gather instruction and
+ * otherwise with a scalar loop over the lanes.
+ * The table is shared between the copies of the map, as it might grow up to 64KiB for the largest alphabets.
+ */
+template <std::integral value_t, std::integral key_t, std::ptrdiff_t dimension_v>
+    requires (dimension_v > 0 && dimension_v - 1 <= std::numeric_limits<key_t>::max())
+struct _simd_gather_map
+{
+    class type;
+};
+
+template <std::integral value_t, std::integral key_t, std::ptrdiff_t dimension_v>
+    requires (dimension_v > 0 && dimension_v - 1 <= std::numeric_limits<key_t>::max())
+using simd_gather_map = typename _simd_gather_map<value_t, key_t, dimension_v>::type;
+
+template <std::integral value_t, std::integral key_t, std::ptrdiff_t dimension_v>
+    requires (dimension_v > 0 && dimension_v - 1 <= std::numeric_limits<key_t>::max())
+class _simd_gather_map<value_t, key_t, dimension_v>::type
+{
+    using simd_value_t = simd_score<value_t>;
+    using simd_key_t = simd_score<key_t, simd_value_t::size_v>;
+
+    using gather_strategy_t = detail::simd_gather<simd_key_t,
+                                                  detail::gather_tag<sizeof(value_t) * 8,
+                                                                     sizeof(key_t) * 8,
+                                                                     detail::max_simd_size * 8>>;
+
+    static constexpr size_t table_size = dimension_v * dimension_v + gather_strategy_t::table_padding;
+
+    using table_t = std::vector<value_t, seqan3::aligned_allocator<value_t, detail::max_simd_size>>;
+
+    // The row-major table holding the data.
+    std::shared_ptr<table_t> _table_ptr{};
+
+public:
+    using value_type = simd_value_t;
+    using key_type = simd_key_t;
+
+    type() = default;
+    template <std::ranges::forward_range data_t>
+        requires std::ranges::forward_range<std::ranges::range_reference_t<data_t>>
+    explicit type(data_t && data)
+    {
+        assert(std::ranges::distance(data) == dimension_v);
+
+        table_t table{};
+        table.resize(table_size);
+        auto table_it = table.begin();
+        std::ranges::for_each(data, [&] (auto const & row) {
+            assert(std::ranges::distance(row) == dimension_v);
+            table_it = std::ranges::copy(row | std::views::transform([] (auto const value) {
+                return static_cast<value_t>(value);
+            }), table_it).out;
+        });
+
+        _table_ptr = std::make_shared<table_t>(std::move(table));
+    }
+
+    constexpr value_type operator()(key_type const & row_key, key_type const & column_key) const noexcept
+    {
+        assert(_table_ptr != nullptr);
+        return gather_strategy_t::template gather<value_type>(_table_ptr->data(), row_key, column_key, dimension_v);
+    }
+};
+
+} // v1
+} // namespace seqan::pairwise_aligner
@@ -49,6 +49,14 @@ protected:
         }
         return ranks;
     }
+
+    // Calls `fn(map_index, ranks)` with the ranks selected for the keys from every rank map of the given range.
+    template <std::ranges::random_access_range rank_maps_t, typename fn_t>
+    static void select_ranks_for(rank_maps_t const & rank_maps, key_t const & keys, fn_t && fn) noexcept
+    {
+        for (size_t map_index = 0; map_index < std::ranges::size(rank_maps); ++map_index)
+            fn(map_index, select_rank_for(rank_maps[map_index], keys));
+    }
 };
 
 template <typename index_t>
@@ -82,6 +82,29 @@ protected:
         return tmp;
     }
 
+    // Calls `fn(map_index, ranks)` with the ranks selected for the key from every rank map of the given range.
+    // The key is split only once for all rank maps.
+    template <std::ranges::random_access_range rank_maps_t, typename fn_t>
+    static void select_ranks_for(rank_maps_t const & rank_maps, key_t const & key, fn_t && fn) noexcept
+    {
+        auto [offset, key_low, key_high] = to_offset(key);
+
+        for (size_t map_index = 0; map_index < std::ranges::size(rank_maps); ++map_index) {
+            rank_map_t const & rank_map = rank_maps[map_index];
+            if (rank_map.size() == 1) { // All keys address the first chunk.
+                fn(map_index, select_rank_for_impl(rank_map[0], key_low, key_high));
+                continue;
+            }
+
+            key_t tmp{};
+            for (int32_t i = 0; i < std::ranges::ssize(rank_map); ++i) {
+                tmp |= blend(offset.eq(key_t{static_cast<scalar_t>(i)}),
+                             select_rank_for_impl(rank_map[i], key_low, key_high), key_t{});
+            }
+            fn(map_index, tmp);
+        }
+    }
+
 private:
     using offset_type = std::tuple<key_t, key_t, key_t>;
 
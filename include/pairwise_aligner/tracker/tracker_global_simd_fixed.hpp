@@ -12,8 +12,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
 #include <ranges>
+#include <type_traits>
 
 #include <pairwise_aligner/configuration/end_gap_policy.hpp>
 #include <pairwise_aligner/simd/simd_base.hpp>
@@ -25,6 +31,28 @@ inline namespace v1
 
 namespace tracker::global_simd_fixed {
 
+namespace detail
+{
+
+// The cells of every lane inside the last column or the last row of a bulk, which are scanned for the best score.
+// As the lanes are aligned at the bottom right corner of the dp matrix, the cells of a lane start at an offset inside
+// the dp vector, which scales the padding score gained in front of them. The own range holds the lane's cells of this
+// vector. The projected range holds the cells that continue the lane's end cells of the other dp vector beyond its
+// corner. The positions are kept at full width, as the dp vectors may be longer than the score type can count.
+template <typename score_t>
+struct end_cells
+{
+    using positions_type = std::array<size_t, score_t::size_v>;
+
+    positions_type own_begin{};
+    positions_type own_end{};
+    positions_type projected_begin{};
+    positions_type projected_end{};
+    score_t scale{};
+};
+
+} // namespace detail
+
 template <typename score_t>
 struct _tracker
 {
@@ -37,167 +65,191 @@ using tracker = typename _tracker<score_t>::type;
 template <typename score_t>
 class _tracker<score_t>::type
 {
+private:
+
+    using scalar_t = typename score_t::value_type;
+    using unsigned_scalar_t = std::make_unsigned_t<scalar_t>;
+    using offset_simd_t = simd_score<unsigned_scalar_t, score_t::size_v>;
+    using end_cells_t = detail::end_cells<score_t>;
+
+    // The number of cells whose positions relative to the first cell can be compared in the score width.
+    static constexpr size_t window_size = std::numeric_limits<unsigned_scalar_t>::max();
+
 public:
 
     score_t _padding_score;
     cfg::trailing_end_gap _end_gap;
+    // The best score of every lane is recorded while the last column and the last row are computed.
+    score_t _max_score{std::numeric_limits<scalar_t>::lowest()};
+    end_cells_t _column_end_cells{};
+    end_cells_t _row_end_cells{};
 
     constexpr score_t const & track(score_t const & score) const noexcept {
         return score; // no-op.
     }
 
     template <typename sequence1_t, typename sequences2_t, typename dp_column_t, typename dp_row_t>
-    constexpr score_t max_score(sequence1_t && sequence1,
-                                sequences2_t && sequences2,
-                                dp_column_t const & dp_column,
-                                dp_row_t const & dp_row) const noexcept
+    constexpr void initialise(sequence1_t && sequence1,
+                              sequences2_t && sequences2,
+                              dp_column_t const & dp_column,
+                              dp_row_t const & dp_row) noexcept
     {
-        std::vector<std::views::all_t<sequence1_t>> sequence1_bulk{};
-        sequence1_bulk.resize(std::ranges::distance(sequences2), sequence1 | std::views::all);
+        // Repeat the first sequence for every second sequence without allocating a bulk of views.
+        auto sequence1_bulk = std::views::iota(std::ptrdiff_t{0}, std::ranges::distance(sequences2))
+                            | std::views::transform([&] (std::ptrdiff_t) { return sequence1 | std::views::all; });
 
-        return max_score(std::move(sequence1_bulk), std::forward<sequences2_t>(sequences2), dp_column, dp_row);
+        initialise(std::move(sequence1_bulk), std::forward<sequences2_t>(sequences2), dp_column, dp_row);
     }
 
     template <typename sequences1_t, typename sequences2_t, typename dp_column_t, typename dp_row_t>
         requires std::ranges::range<std::ranges::range_reference_t<sequences1_t>>
-    constexpr score_t max_score(sequences1_t && sequences1,
-                                sequences2_t && sequences2,
-                                dp_column_t const & dp_column,
-                                dp_row_t const & dp_row) const noexcept
+    constexpr void initialise(sequences1_t && sequences1,
+                              sequences2_t && sequences2,
+                              dp_column_t const & dp_column,
+                              dp_row_t const & dp_row) noexcept
     {
         assert(dp_column.size() == 1);
         assert(dp_row.size() == 1);
 
-        if (_end_gap.last_column == cfg::end_gap::penalised && _end_gap.last_row == cfg::end_gap::penalised) {
-            score_t best_score{};
-            for (std::ptrdiff_t idx = 0; idx < std::ranges::distance(sequences1); ++idx) {
-                best_score[idx] = select_max_score(idx, sequences1[idx], sequences2[idx], dp_column[0], dp_row[0]);
-            }
-            return best_score;
+        size_t const column_size = dp_column[0].size();
+        size_t const row_size = dp_row[0].size();
+        for (std::ptrdiff_t idx = 0; idx < std::ranges::distance(sequences1); ++idx) {
+            size_t const sequence1_size = std::ranges::distance(sequences1[idx]);
+            size_t const sequence2_size = std::ranges::distance(sequences2[idx]);
+            assert(column_size > sequence1_size);
+            assert(row_size > sequence2_size);
+            size_t const column_offset = row_size - 1 - sequence2_size;
+            size_t const row_offset = column_size - 1 - sequence1_size;
+
+            // With penalised end gaps only the end cell of every lane is scored, which lies in the vector with the
+            // smaller offset.
+            initialise_end_cells(_column_end_cells, idx, sequence1_size, column_size, column_offset,
+                                 _end_gap.last_column, _end_gap.last_row, column_offset <= row_offset);
+            initialise_end_cells(_row_end_cells, idx, sequence2_size, row_size, row_offset,
+                                 _end_gap.last_row, _end_gap.last_column, row_offset < column_offset);
         }
+    }
 
-        score_t best_score{std::numeric_limits<typename score_t::value_type>::lowest()};
-        if (_end_gap.last_column == cfg::end_gap::free) {
-            best_score = find_max_score(sequences1, dp_column[0], sequences2, dp_row[0]);
-        }
+    // Records the last column once the block covering it is computed.
+    // The fixed engines compute the dp matrix as a single block, such that this tracker does not bound the active
+    // blocks of a column and every cell up to the longest lane is computed.
+    template <typename dp_column_t>
+    constexpr void track_last_column(dp_column_t const & dp_column, [[maybe_unused]] std::ptrdiff_t const index)
+        noexcept
+    {
+        assert(index == 0);
+        track_vector(dp_column[0], _column_end_cells);
+    }
 
-        if (_end_gap.last_row == cfg::end_gap::free) {
-            best_score = max(best_score, find_max_score(sequences2, dp_row[0], sequences1, dp_column[0]));
-        }
+    // Records the last row once the column covering it is computed.
+    template <typename dp_row_t>
+    constexpr void track_last_row(dp_row_t const & dp_row, [[maybe_unused]] std::ptrdiff_t const index) noexcept
+    {
+        assert(index == 0);
+        track_vector(dp_row[0], _row_end_cells);
+    }
 
-        return best_score;
+    template <typename ...args_t>
+    constexpr score_t max_score([[maybe_unused]] args_t && ...args) const noexcept
+    {
+        return _max_score;
     }
 
     // TODO: optimal_coordinate()
 
 private:
 
-
-    template <typename sequence_t, typename dp_vector_t>
-    constexpr auto get_offsets(sequence_t && sequence, dp_vector_t && dp_vector) const noexcept
+    constexpr void initialise_end_cells(end_cells_t & end_cells,
+                                        size_t const simd_idx,
+                                        size_t const sequence_size,
+                                        size_t const vector_size,
+                                        size_t const offset,
+                                        cfg::end_gap const own_end_gap,
+                                        cfg::end_gap const other_end_gap,
+                                        bool const has_end_cell) const noexcept
     {
-        size_t sequence_size = std::ranges::distance(sequence);
-        size_t dp_vector_size = dp_vector.size();
+        size_t const end_position = sequence_size + offset;
+
+        if (own_end_gap == cfg::end_gap::free) {
+            end_cells.own_begin[simd_idx] = offset;
+            end_cells.own_end[simd_idx] = std::min(end_position + 1, vector_size);
+        } else if (other_end_gap == cfg::end_gap::penalised && has_end_cell) {
+            end_cells.own_begin[simd_idx] = end_position;
+            end_cells.own_end[simd_idx] = end_position + 1;
+        }
 
-        assert(dp_vector_size > sequence_size);
-        size_t offset = dp_vector_size - 1 - sequence_size;
+        if (other_end_gap == cfg::end_gap::free) {
+            end_cells.projected_begin[simd_idx] = end_position;
+            end_cells.projected_end[simd_idx] = vector_size;
+        }
 
-        return std::tuple{sequence_size, dp_vector_size, offset};
+        end_cells.scale[simd_idx] = offset;
     }
 
-    template <typename sequence1_t, typename sequence2_t, typename dp_column_t, typename dp_row_t>
-    constexpr auto select_max_score(size_t const simd_idx,
-                                    sequence1_t && sequence1,
-                                    sequence2_t && sequence2,
-                                    dp_column_t const & dp_column,
-                                    dp_row_t const & dp_row) const noexcept
-        -> typename score_t::value_type
+    // Iterates over the own and the projected cells of every lane and subtracts the scaled padding score from the
+    // retrieved values. Every projected cell lies one more padding score beyond the corner of the lane.
+    // If both trailing gaps are penalised, only the end cell of every lane is read.
+    template <typename dp_vector_t>
+    constexpr void track_vector(dp_vector_t const & dp_vector, end_cells_t const & end_cells) noexcept
     {
-        auto [column_sequence_size, column_vector_size, row_offset] = get_offsets(sequence1, dp_column);
-        auto [row_sequence_size, row_vector_size, column_offset] = get_offsets(sequence2, dp_row);
-
-        using scalar_t = typename score_t::value_type;
-        size_t scale = std::min(column_offset, row_offset);
-        scalar_t best_score{};
-
-        if (scale == column_offset) {
-            best_score = score_at(dp_column[column_sequence_size + column_offset], simd_idx);
-        } else {
-            best_score = score_at(dp_row[row_sequence_size + row_offset], simd_idx);
+        score_t scale = _padding_score * end_cells.scale;
+        if (_end_gap.last_column == cfg::end_gap::penalised && _end_gap.last_row == cfg::end_gap::penalised) {
+            for (size_t simd_idx = 0; simd_idx < score_t::size_v; ++simd_idx) {
+                if (end_cells.own_begin[simd_idx] < end_cells.own_end[simd_idx])
+                    _max_score[simd_idx] = score_at(dp_vector[end_cells.own_begin[simd_idx]], simd_idx) -
+                                           scale[simd_idx];
+            }
+            return;
         }
 
-        return best_score - (_padding_score[simd_idx] * scale);
-    }
+        // The vector is scanned in windows, inside of which the positions fit into the score width.
+        for (size_t window_begin = 0; window_begin < dp_vector.size(); window_begin += window_size) {
+            size_t const window_end = std::min(window_begin + window_size, dp_vector.size());
+            offset_simd_t const own_begin = to_window(end_cells.own_begin, window_begin);
+            offset_simd_t const own_end = to_window(end_cells.own_end, window_begin);
+            for (size_t idx = window_begin; idx < window_end; ++idx) {
+                offset_simd_t simd_idx{static_cast<unsigned_scalar_t>(idx - window_begin)};
 
-    template <typename first_sequence_t, typename first_vector_t, typename second_sequence_t, typename second_vector_t>
-    constexpr auto find_max_score(first_sequence_t && first_sequence,
-                                  first_vector_t && first_vector,
-                                  second_sequence_t && second_sequence,
-                                  second_vector_t && second_vector) const noexcept
-    {
-        using scalar_t = typename score_t::value_type;
-        using unsigned_scalar_t = std::make_unsigned_t<scalar_t>;
-        using offset_simd_t = simd_score<unsigned_scalar_t, score_t::size_v>;
-
-        offset_simd_t start_offset_first{};
-        offset_simd_t end_offset_first{};
-        score_t scale_first{};
-
-        offset_simd_t start_offset_second{};
-        offset_simd_t end_offset_second{};
-        score_t scale_second{};
-
-        // Prepare the offsets.
-        for (std::ptrdiff_t idx = 0; idx < std::ranges::distance(first_sequence); ++idx) {
-            auto [first_sequence_size, first_vector_size, second_offset] = get_offsets(first_sequence[idx], first_vector);
-            auto [second_sequence_size, second_vector_size, first_offset] = get_offsets(second_sequence[idx], second_vector);
-
-            start_offset_first[idx] = first_offset;
-            end_offset_first[idx] = std::min<size_t>(first_offset + first_sequence_size + 1, first_vector_size);
-            scale_first[idx] = first_offset;
-
-            start_offset_second[idx] = second_sequence_size + second_offset;
-            end_offset_second[idx] = second_vector_size;
-            scale_second[idx] = second_offset;
+                auto mask = (own_begin.le(simd_idx) && simd_idx.lt(own_end));
+                _max_score = mask_max(_max_score, mask, _max_score, dp_vector[idx].score() - scale);
+            }
         }
 
-        // Iterate over the corresponding slice in the projected dp vector (first_vector) and subtract the scaled
-        // padding score from the retrieved values of the corresponding simd index.
-
-        score_t best_score{std::numeric_limits<scalar_t>::lowest()};
-        score_t scale = _padding_score * scale_first;
-        for (unsigned_scalar_t idx = 0; idx < first_vector.size(); ++idx) {
-            offset_simd_t simd_idx{idx};
+        for (size_t window_begin = 0; window_begin < dp_vector.size(); window_begin += window_size) {
+            size_t const window_end = std::min(window_begin + window_size, dp_vector.size());
+            offset_simd_t const projected_begin = to_window(end_cells.projected_begin, window_begin);
+            offset_simd_t const projected_end = to_window(end_cells.projected_end, window_begin);
+            for (size_t idx = window_begin; idx < window_end; ++idx) {
+                offset_simd_t simd_idx{static_cast<unsigned_scalar_t>(idx - window_begin)};
 
-            auto mask = (start_offset_first.le(simd_idx) && simd_idx.lt(end_offset_first));
-            best_score = mask_max(best_score, mask, best_score, first_vector[idx].score() - scale);
+                auto mask = (projected_begin.le(simd_idx) && simd_idx.lt(projected_end));
+                _max_score = mask_max(_max_score, mask, _max_score, dp_vector[idx].score() - scale);
+                scale = mask_add(scale, mask, scale, _padding_score);
+            }
         }
+    }
 
-        // Note if second_offset is less than first_offset, the last (first_offset - second_offset) elements of the
-        // second vector must be considered as well; these cells contain the values of the projected first vector, which
-        // breaks around the cell (n, m) of the extended simd matrix.
-        // This slice starts at the projected second vector cell.
-        scale = _padding_score * scale_second;
-        for (unsigned_scalar_t idx = 0; idx < second_vector.size(); ++idx) {
-            offset_simd_t simd_idx{idx};
-
-            auto mask = (start_offset_second.le(simd_idx) && simd_idx.lt(end_offset_second));
-            best_score = mask_max(best_score, mask, best_score, second_vector[idx].score() - scale);
-            scale = mask_add(scale, mask, scale, _padding_score);
+    // Clamps the positions to the window starting at the given position and makes them relative to its begin.
+    static constexpr offset_simd_t to_window(typename end_cells_t::positions_type const & positions,
+                                             size_t const window_begin) noexcept
+    {
+        offset_simd_t window_positions{};
+        for (size_t simd_idx = 0; simd_idx < score_t::size_v; ++simd_idx) {
+            size_t const position = std::max(positions[simd_idx], window_begin) - window_begin;
+            window_positions[simd_idx] = static_cast<unsigned_scalar_t>(std::min(position, window_size));
         }
-
-        return best_score;
+        return window_positions;
     }
 
     template <typename cell_t>
         requires requires (cell_t const & cell, size_t const idx){ { cell.score_at(idx) } -> std::integral; }
-    constexpr auto score_at(cell_t const & cell, size_t const idx) const noexcept
+    static constexpr auto score_at(cell_t const & cell, size_t const idx) noexcept
     {
         return cell.score_at(idx);
     }
 
     template <typename cell_t>
-    constexpr auto score_at(cell_t const & cell, size_t const idx) const noexcept
+    static constexpr auto score_at(cell_t const & cell, size_t const idx) noexcept
     {
         return cell.score()[idx];
     }
@@ -12,7 +12,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <tuple>
 
 #include <pairwise_aligner/configuration/end_gap_policy.hpp>
 #include <pairwise_aligner/simd/simd_score_type.hpp>
@@ -27,349 +32,160 @@ namespace tracker::global_simd_saturated {
 namespace detail
 {
 
-template <typename score_t, typename dp_column_t, typename dp_row_t>
-struct _saturated_max_score_finder
+// The cells of every lane inside the last column or the last row of a bulk, which are scanned for the best score.
+// As the lanes are aligned at the bottom right corner of the dp matrix, the cells of a lane start at an offset inside
+// the dp vector. The own range holds the lane's cells of this vector and is corrected by the constant padding score
+// gained in front of them. The projected range holds the cells that continue the lane's end cells of the other dp
+// vector beyond its corner, which gain one more padding score with every cell.
+template <typename score_t>
+struct end_cells
+{
+    score_t sequence_sizes{};
+    score_t offsets{};
+    score_t own_begin{};
+    score_t own_end{};
+    score_t projected_begin{};
+    score_t projected_end{};
+};
+
+} // namespace detail
+
+template <typename score_t>
+struct _tracker
 {
     class type;
 };
 
-template <typename score_t, typename dp_column_t, typename dp_row_t>
-using saturated_max_score_finder = typename _saturated_max_score_finder<score_t, dp_column_t, dp_row_t>::type;
+template <typename score_t>
+using tracker = typename _tracker<score_t>::type;
 
-template <typename score_t, typename dp_column_t, typename dp_row_t>
-class _saturated_max_score_finder<score_t, dp_column_t, dp_row_t>::type
+template <typename score_t>
+class _tracker<score_t>::type
 {
 private:
 
+    using scalar_t = typename score_t::value_type;
     using vec_int8_t = simd_score<int8_t>;
     using vec_uint8_t = simd_score<uint8_t>;
     using mask_uint8_t = typename vec_uint8_t::mask_type;
-    using scalar_t = typename score_t::value_type;
-
-    inline static constexpr size_t level1_max_size_v = (1ull << 8) - 1; // maximal size of sequence usable with level1
-    inline static constexpr size_t level2_max_size_v = (1ull << 16) - 1; // maximal size of sequence usable with level2
-    inline static constexpr size_t level3_max_size_v = (1ull << 24) - 1; // maximal size of sequence usable with level3
-
-    struct level_state {
-        score_t begin_position{};
-        score_t end_position{};
-        mask_uint8_t reached_first{~mask_uint8_t{}};
-        mask_uint8_t reached_last{~mask_uint8_t{}};
-
-        size_t chunk_idx{};
-        size_t chunk_position{};
-        size_t chunk_end{};
-    };
-
-    // Extracted parameters
-    score_t _sequence1_sizes{};
-    score_t _sequence2_sizes{};
-    dp_column_t _dp_column;
-    dp_row_t _dp_row;
-    size_t _chunk_size{};
-    size_t _dp_column_size{};
-    size_t _dp_row_size{};
+    using end_cells_t = detail::end_cells<score_t>;
 
 public:
-    type() = delete;
-
-    template <typename sequence1_bulk_t, typename sequence2_bulk_t>
-    constexpr explicit type(dp_column_t dp_column,
-                            dp_row_t dp_row,
-                            sequence1_bulk_t && sequence1_bulk,
-                            sequence2_bulk_t && sequence2_bulk,
-                            size_t const chink_size) :
-        _dp_column{std::forward<dp_column_t>(dp_column)},
-        _dp_row{std::forward<dp_row_t>(dp_row)},
-        _chunk_size{chink_size}
-    {
-        // Determine the maximal column and row size and store the sequence sizes in a simd vector.
-        auto get_size = [] (auto && sequence) { return std::ranges::distance(sequence); };
-        auto sequence1_sizes = sequence1_bulk | std::views::transform(get_size);
-        auto sequence2_sizes = sequence2_bulk | std::views::transform(get_size);
-
-        for (std::ptrdiff_t idx = 0; idx < std::ranges::distance(sequence1_sizes) ; ++idx) {
-            _sequence1_sizes[idx] = sequence1_sizes[idx];
-            _sequence2_sizes[idx] = sequence2_sizes[idx];
-            _dp_column_size = std::max<size_t>(_dp_column_size, sequence1_sizes[idx] + 1);
-            _dp_row_size = std::max<size_t>(_dp_row_size, sequence2_sizes[idx] + 1);
-        }
+    score_t _padding_score;
+    cfg::trailing_end_gap _end_gap;
+    // The best score of every lane is recorded while the last column and the last row are computed.
+    score_t _max_score{std::numeric_limits<scalar_t>::lowest()};
+    end_cells_t _column_end_cells{};
+    end_cells_t _row_end_cells{};
+    // The last row and the last column of every lane, which bound the blocks computed with penalised end gaps.
+    score_t _end_rows{};
+    score_t _end_columns{};
+    std::ptrdiff_t _lane_count{};
+    size_t _column_chunk_size{};
+    size_t _row_chunk_size{};
 
-        if (_dp_column_size > level3_max_size_v || _dp_row_size > level3_max_size_v)
-            throw std::runtime_error{"The given dynamic programming matrix exceeds the maximal allowed column and/or "
-                                     " row size of 2^24 - 1."};
+    template <typename saturated_score_t>
+    constexpr saturated_score_t const & track(saturated_score_t const & score) const noexcept {
+        return score; // no-op.
     }
 
-    constexpr auto in_column(score_t const & padding_score) const noexcept
+    template <typename sequence1_t, typename sequences2_t, typename dp_column_t, typename dp_row_t>
+    constexpr void initialise(sequence1_t && sequence1,
+                              sequences2_t && sequences2,
+                              dp_column_t const & dp_column,
+                              dp_row_t const & dp_row) noexcept
     {
-        auto [column_offsets, row_offsets] = get_offsets();
-        return max(run_first(_dp_column, _dp_column_size, _sequence1_sizes, column_offsets, padding_score),
-                   run_second(_dp_row, _dp_row_size, _sequence2_sizes, row_offsets, padding_score));
-    }
+        // Repeat the first sequence for every second sequence without allocating a bulk of views.
+        auto sequence1_bulk = std::views::iota(std::ptrdiff_t{0}, std::ranges::distance(sequences2))
+                            | std::views::transform([&] (std::ptrdiff_t) { return sequence1 | std::views::all; });
 
-    constexpr auto in_row(score_t const & padding_score) const noexcept
-    {
-        auto [column_offsets, row_offsets] = get_offsets();
-        return max(run_first(_dp_row, _dp_row_size, _sequence2_sizes, row_offsets, padding_score),
-                   run_second(_dp_column, _dp_column_size, _sequence1_sizes, column_offsets, padding_score));
+        initialise(std::move(sequence1_bulk), std::forward<sequences2_t>(sequences2), dp_column, dp_row);
     }
 
-private:
-
-    constexpr auto get_offsets() const noexcept
-    {
-        return std::pair{score_t{static_cast<scalar_t>(_dp_row_size - 1)} - _sequence2_sizes,
-                         score_t{static_cast<scalar_t>(_dp_column_size - 1)} - _sequence1_sizes};
-    }
-
-    template <typename dp_vector_t>
-    auto run_first(dp_vector_t const & dp_vector,
-                   size_t const dp_vector_size,
-                   score_t const & sequence_sizes,
-                   score_t const & vector_offsets,
-                   score_t const & padding_score) const noexcept
+    template <typename sequences1_t, typename sequences2_t, typename dp_column_t, typename dp_row_t>
+        requires std::ranges::range<std::ranges::range_reference_t<sequences1_t>>
+    constexpr void initialise(sequences1_t && sequences1,
+                              sequences2_t && sequences2,
+                              dp_column_t const & dp_column,
+                              dp_row_t const & dp_row) noexcept
     {
-        // Global states
-        score_t best_score{std::numeric_limits<scalar_t>::lowest()};
-        score_t const score_correction = padding_score * vector_offsets;
-        score_t const mask_infinity{std::numeric_limits<int8_t>::lowest()};
-        size_t const chunk_count = dp_vector.size();
-
-        vec_int8_t local_max_score{std::numeric_limits<int8_t>::lowest()};
-        mask_uint8_t reached_first{};
-        mask_uint8_t reached_last{};
-
-        auto find = [&] (level_state & state) -> bool {
-
-            if (state.chunk_position == state.chunk_end) {
-                // Get max best score.
-                auto in_range = mask_infinity.lt(score_t{local_max_score});
-                best_score = mask_max(best_score,
-                                      in_range,
-                                      best_score,
-                                      (score_t{local_max_score} + dp_vector[state.chunk_idx].offset()) -
-                                        score_correction);
-
-                if (++state.chunk_idx == chunk_count) {
-                    return false;
-                }
-
-                local_max_score = vec_int8_t{std::numeric_limits<int8_t>::lowest()};
-                state.chunk_end = dp_vector[state.chunk_idx].size() - (state.chunk_idx < chunk_count - 1);
-                state.chunk_position = 0;
-            }
+        auto get_size = [] (auto && sequence) { return std::ranges::distance(sequence); };
+        auto sequence1_sizes = sequences1 | std::views::transform(get_size);
+        auto sequence2_sizes = sequences2 | std::views::transform(get_size);
 
-            reached_first |= state.reached_first;
-            reached_last |= state.reached_last;
-            mask_uint8_t mask{reached_first & ~reached_last};
-
-            auto const & base_chunk = dp_vector[state.chunk_idx].base(); // TODO: No guarantee that base is what it is supposed to be!
-            local_max_score = mask_max(local_max_score, mask, local_max_score, base_chunk[state.chunk_position].score());
-            return true;
-        };
-
-        level_state state{
-            .begin_position = vector_offsets,
-            .end_position = min(vector_offsets + sequence_sizes + score_t{1},
-                                score_t{static_cast<scalar_t>(dp_vector_size)}),
-            .chunk_end = dp_vector[0].size() - (0 < chunk_count - 1)
-        };
-
-        if (dp_vector_size > level2_max_size_v) {
-            run_level3(state, find);
-        } else if (dp_vector_size > level1_max_size_v) {
-            run_level2(state, find);
-        } else {
-            run_level1(state, find);
+        _lane_count = std::ranges::distance(sequence1_sizes);
+        for (std::ptrdiff_t idx = 0; idx < _lane_count; ++idx) {
+            _column_end_cells.sequence_sizes[idx] = sequence1_sizes[idx];
+            _row_end_cells.sequence_sizes[idx] = sequence2_sizes[idx];
         }
 
-        return best_score;
+        score_t const column_size{static_cast<scalar_t>(vector_size(dp_column))};
+        score_t const row_size{static_cast<scalar_t>(vector_size(dp_row))};
+        _column_end_cells.offsets = row_size - score_t{1} - _row_end_cells.sequence_sizes;
+        _row_end_cells.offsets = column_size - score_t{1} - _column_end_cells.sequence_sizes;
+
+        // With penalised end gaps only the end cell of every lane is scored, which lies in the vector with the
+        // smaller offset.
+        initialise_end_cells(_column_end_cells,
+                             column_size,
+                             _end_gap.last_column,
+                             _end_gap.last_row,
+                             _column_end_cells.offsets.le(_row_end_cells.offsets));
+        initialise_end_cells(_row_end_cells,
+                             row_size,
+                             _end_gap.last_row,
+                             _end_gap.last_column,
+                             _row_end_cells.offsets.lt(_column_end_cells.offsets));
+
+        // The lanes are shifted along the diagonal until one of their ends meets the last row or column.
+        score_t const diagonal_offsets = min(_column_end_cells.offsets, _row_end_cells.offsets);
+        _end_rows = _column_end_cells.sequence_sizes + diagonal_offsets;
+        _end_columns = _row_end_cells.sequence_sizes + diagonal_offsets;
+        _column_chunk_size = dp_column[0].size() - 1;
+        _row_chunk_size = dp_row[0].size() - 1;
     }
 
-    template <typename dp_vector_t>
-    auto run_second(dp_vector_t const & dp_vector,
-                    size_t const dp_vector_size,
-                    score_t const & sequence_sizes,
-                    score_t const & vector_offsets,
-                    score_t const & padding_score) const noexcept
+    // Returns the number of leading blocks of the given column that contain cells of any lane.
+    // With penalised end gaps only the end cell of every lane is scored, such that the blocks beyond the last rows of
+    // all lanes reaching into this column are not computed. Their stale cells are neither read by a computed block nor
+    // by the tracker. With free end gaps, the scores are projected through all blocks to the last row and column.
+    // Whole columns are never skipped, since the lane with the longest second sequence ends in the last column.
+    constexpr std::ptrdiff_t active_row_count(std::ptrdiff_t const column_index,
+                                              std::ptrdiff_t const row_count) const noexcept
     {
-        // Global state!
-        score_t best_score{std::numeric_limits<scalar_t>::lowest()};
-        score_t const mask_infinity{std::numeric_limits<int8_t>::lowest()};
-        size_t const chunk_count = dp_vector.size();
+        if (_end_gap.last_column == cfg::end_gap::free || _end_gap.last_row == cfg::end_gap::free)
+            return row_count;
 
-        vec_int8_t local_max_score{std::numeric_limits<int8_t>::lowest()};
-        vec_int8_t const local_padding_score{padding_score};
-        vec_int8_t local_score_correction{0};
-        mask_uint8_t reached_first{};
-
-        auto find = [&] (level_state & state) -> bool {
-            if (state.chunk_position == state.chunk_end) {
-                auto in_range = mask_infinity.lt(score_t{local_max_score});
-                score_t score_correction =
-                    max(score_t{static_cast<scalar_t>(state.chunk_idx * _chunk_size)} - sequence_sizes, vector_offsets) *
-                        padding_score;
-                best_score = mask_max(best_score,
-                                      in_range,
-                                      best_score,
-                                      (score_t{local_max_score} + dp_vector[state.chunk_idx].offset() -
-                                        score_correction));
-
-                if (++state.chunk_idx == chunk_count)
-                    return false;
-
-                // Reinitialise loop variables.
-                state.chunk_end = dp_vector[state.chunk_idx].size() - 1;
-                local_max_score = vec_int8_t{std::numeric_limits<int8_t>::lowest()};
-                local_score_correction = vec_int8_t{0};
-                state.chunk_position = 0;
-            }
+        score_t const column_begin{static_cast<scalar_t>(column_index * _row_chunk_size)};
+        score_t const active_end_rows = blend(column_begin.le(_end_columns), _end_rows, score_t{0});
 
-            reached_first |= state.reached_first;
-            auto const & base_chunk = dp_vector[state.chunk_idx].base();
-            local_max_score = mask_max(local_max_score,
-                                       reached_first,
-                                       local_max_score,
-                                       base_chunk[state.chunk_position].score() - local_score_correction);
-            local_score_correction = mask_add(local_score_correction,
-                                              reached_first,
-                                              local_score_correction,
-                                              local_padding_score);
-            return true;
-        };
-
-        level_state state{
-            .begin_position = min(sequence_sizes + vector_offsets, score_t{static_cast<scalar_t>(dp_vector_size)}),
-            .chunk_end = dp_vector[0].size() - 1
-        };
-
-        if (dp_vector_size > level2_max_size_v) {
-            run_level3(state, find);
-        } else if (dp_vector_size > level1_max_size_v) {
-            run_level2(state, find);
-        } else {
-            run_level1(state, find);
-        }
+        scalar_t end_row{0};
+        for (std::ptrdiff_t idx = 0; idx < _lane_count; ++idx)
+            end_row = std::max(end_row, active_end_rows[idx]);
 
-        return best_score;
+        // The first cell of a block is the last cell of the block above, such that a block holding the end cell in its
+        // first row is still computed.
+        return std::min<std::ptrdiff_t>(row_count, end_row / std::max<size_t>(_column_chunk_size, 1) + 1);
     }
 
-    template <typename fn_t>
-    void run_level3(level_state & state, fn_t && fn) const noexcept
+    // Records the chunk of the last column once the block covering it is computed.
+    template <typename dp_column_t>
+    constexpr void track_last_column(dp_column_t const & dp_column, std::ptrdiff_t const index) noexcept
     {
-        vec_uint8_t begin_position = vec_uint8_t{state.begin_position >> 16};
-        vec_uint8_t end_position = vec_uint8_t{state.end_position >> 16};
-        vec_uint8_t vec_level3_idx{0};
-        for (vec_uint8_t vec_level3_idx{0};; ++vec_level3_idx) {
-            state.reached_first = begin_position.le(vec_level3_idx);
-            state.reached_last = end_position.le(vec_level3_idx);
-            if (!run_level2(state, std::forward<fn_t>(fn)))
-                break; // terminate.
-        }
+        track_chunk(dp_column, index, _column_end_cells);
     }
 
-    template <typename fn_t>
-    auto run_level2(level_state & state, fn_t && fn) const noexcept
+    // Records the chunk of the last row once the column covering it is computed.
+    template <typename dp_row_t>
+    constexpr void track_last_row(dp_row_t const & dp_row, std::ptrdiff_t const index) noexcept
     {
-        mask_uint8_t parent_reached_first = state.reached_first;
-        mask_uint8_t parent_reached_last = state.reached_last;
-        vec_uint8_t begin_position = vec_uint8_t{(state.begin_position >> 8) & score_t{static_cast<scalar_t>(255)}};
-        vec_uint8_t end_position = vec_uint8_t{(state.end_position >> 8) & score_t{static_cast<scalar_t>(255)}};
-        vec_uint8_t vec_level2_idx{0};
-        for (size_t idx = 0; idx < 256; ++idx, ++vec_level2_idx) {
-            state.reached_first = parent_reached_first & begin_position.le(vec_level2_idx);
-            state.reached_last = parent_reached_last & end_position.le(vec_level2_idx);
-
-            if (!run_level1(state, std::forward<fn_t>(fn)))
-                return false; // terminate.
-        }
-        return true;
+        track_chunk(dp_row, index, _row_end_cells);
     }
 
-    template <typename fn_t>
-    auto run_level1(level_state & state, fn_t && fn) const noexcept
+    template <typename ...args_t>
+    constexpr score_t max_score([[maybe_unused]] args_t && ...args) const noexcept
     {
-        mask_uint8_t parent_reached_first = state.reached_first;
-        mask_uint8_t parent_reached_last = state.reached_last;
-        vec_uint8_t begin_position = vec_uint8_t{state.begin_position & score_t{static_cast<scalar_t>(255)}};
-        vec_uint8_t end_position = vec_uint8_t{state.end_position & score_t{static_cast<scalar_t>(255)}};
-        for (size_t level1_idx = 0; level1_idx < 256; ++level1_idx, ++state.chunk_position) {
-            vec_uint8_t vec_level1_idx{static_cast<uint8_t>(level1_idx)};
-
-            // it is a mask and we later add the mask to it.
-            state.reached_first = parent_reached_first & begin_position.le(vec_level1_idx);
-            state.reached_last = parent_reached_last & end_position.le(vec_level1_idx);
-
-            if (!fn(state))
-                return false; // terminate.
-        }
-        return true;
-    }
-
-};
-
-} // namespace detail
-
-template <typename score_t>
-struct _tracker
-{
-    class type;
-};
-
-template <typename score_t>
-using tracker = typename _tracker<score_t>::type;
-
-template <typename score_t>
-class _tracker<score_t>::type
-{
-public:
-    score_t _padding_score;
-    cfg::trailing_end_gap _end_gap;
-    size_t _chunk_size{};
-
-    template <typename saturated_score_t>
-    constexpr saturated_score_t const & track(saturated_score_t const & score) const noexcept {
-        return score; // no-op.
-    }
-
-    template <typename sequence1_t, typename sequences2_t, typename dp_column_t, typename dp_row_t>
-    constexpr score_t max_score(sequence1_t && sequence1,
-                                sequences2_t && sequences2,
-                                dp_column_t const & dp_column,
-                                dp_row_t const & dp_row) const noexcept
-    {
-        std::vector<std::views::all_t<sequence1_t>> sequence1_bulk{};
-        sequence1_bulk.resize(std::ranges::distance(sequences2), sequence1 | std::views::all);
-
-        return max_score(std::move(sequence1_bulk), std::forward<sequences2_t>(sequences2), dp_column, dp_row);
-    }
-
-    template <typename sequences1_t, typename sequences2_t, typename dp_column_t, typename dp_row_t>
-        requires std::ranges::range<std::ranges::range_reference_t<sequences1_t>>
-    constexpr score_t max_score(sequences1_t && sequences1,
-                                sequences2_t && sequences2,
-                                dp_column_t const & dp_column,
-                                dp_row_t const & dp_row) const noexcept {
-        if (_end_gap.last_column == cfg::end_gap::penalised && _end_gap.last_row == cfg::end_gap::penalised) {
-            score_t best_score{};
-            for (std::ptrdiff_t idx = 0; idx < std::ranges::distance(sequences1); ++idx) {
-                best_score[idx] = select_max_score(idx, sequences1[idx], sequences2[idx], dp_column, dp_row);
-            }
-            return best_score;
-        }
-
-        using max_score_finder_t = detail::saturated_max_score_finder<score_t, dp_column_t const &, dp_row_t const &>;
-        max_score_finder_t max_score_finder{dp_column, dp_row, sequences1, sequences2, _chunk_size};
-
-        score_t best_score{std::numeric_limits<typename score_t::value_type>::lowest()};
-        if (_end_gap.last_column == cfg::end_gap::free) {
-            best_score = max_score_finder.in_column(_padding_score);
-        }
-
-        if (_end_gap.last_row == cfg::end_gap::free) {
-            best_score = max(best_score, max_score_finder.in_row(_padding_score));
-        }
-        return best_score;
+        return _max_score;
     }
 
     constexpr type & in_block_tracker(score_t const &) noexcept {
@@ -379,76 +195,132 @@ public:
 
 private:
 
-    template <typename sequence_t, typename dp_vector_t>
-    constexpr auto get_offsets(sequence_t && sequence, dp_vector_t && dp_vector) const noexcept
+    template <typename dp_vector_t>
+    static constexpr size_t vector_size(dp_vector_t const & dp_vector) noexcept
     {
         assert(dp_vector.size() != 0);
-        size_t sequence_size = std::ranges::distance(sequence);
-
-        size_t chunk_size = dp_vector[0].size() - 1;
+        // The last cell of a chunk is the first cell of the next chunk.
+        size_t const chunk_size = dp_vector[0].size() - 1;
         size_t const full_chunks = dp_vector.size() - 1;
-        size_t dp_vector_size = (full_chunks * chunk_size) + dp_vector[full_chunks].size();
-
-        assert(dp_vector_size > sequence_size);
-        size_t offset = dp_vector_size - 1 - sequence_size;
-
-        return std::tuple{sequence_size, dp_vector_size, offset};
+        return (full_chunks * chunk_size) + dp_vector[full_chunks].size();
     }
 
-
-    template <typename sequence1_t, typename sequence2_t, typename dp_column_t, typename dp_row_t>
-    constexpr auto select_max_score(size_t const simd_idx,
-                                    sequence1_t && sequence1,
-                                    sequence2_t && sequence2,
-                                    dp_column_t const & dp_column,
-                                    dp_row_t const & dp_row) const noexcept
-        -> typename score_t::value_type
+    template <typename mask_t>
+    constexpr void initialise_end_cells(end_cells_t & end_cells,
+                                        score_t const & vector_size,
+                                        cfg::end_gap const own_end_gap,
+                                        cfg::end_gap const other_end_gap,
+                                        mask_t const & has_end_cell) const noexcept
     {
-        auto [column_sequence_size, column_vector_size, row_offset] = get_offsets(sequence1, dp_column);
-        auto [row_sequence_size, row_vector_size, column_offset] = get_offsets(sequence2, dp_row);
-
-        using scalar_t = typename score_t::value_type;
-        size_t scale = std::min(column_offset, row_offset);
-        scalar_t best_score{};
-
-        size_t const chunk_size = dp_column[0].size() - 1;
-
-        if (scale == column_offset) {
-            auto [chunk_id, chunk_position] =
-                to_local_position(column_sequence_size + column_offset, chunk_size, dp_column.size());
-            best_score = score_at(dp_column[chunk_id][chunk_position], simd_idx);
-        } else {
-            auto [chunk_id, chunk_position] =
-                to_local_position(row_sequence_size + row_offset, chunk_size, dp_row.size());
-            best_score = score_at(dp_row[chunk_id][chunk_position], simd_idx);
+        score_t const zero{0};
+        score_t const one{1};
+        score_t const end_position = end_cells.sequence_sizes + end_cells.offsets;
+
+        if (own_end_gap == cfg::end_gap::free) {
+            end_cells.own_begin = end_cells.offsets;
+            end_cells.own_end = min(end_position + one, vector_size);
+        } else if (other_end_gap == cfg::end_gap::penalised) {
+            end_cells.own_begin = blend(has_end_cell, end_position, zero);
+            end_cells.own_end = blend(has_end_cell, end_position + one, zero);
         }
 
-        return best_score - (_padding_score[simd_idx] * scale);
+        if (other_end_gap == cfg::end_gap::free) {
+            end_cells.projected_begin = min(end_position, vector_size);
+            end_cells.projected_end = vector_size;
+        }
     }
 
-    template <typename cell_t>
-        requires requires (cell_t const & cell, size_t const idx){ { cell.score_at(idx) } -> std::integral; }
-    constexpr auto score_at(cell_t const & cell, size_t const idx) const noexcept
+    template <typename dp_vector_t>
+    constexpr void track_chunk(dp_vector_t const & dp_vector,
+                               std::ptrdiff_t const index,
+                               end_cells_t const & end_cells) noexcept
     {
-        return cell.score_at(idx);
-    }
+        auto const & chunk = dp_vector[index];
+        size_t const chunk_count = dp_vector.size();
+        size_t const chunk_begin = index * (dp_vector[0].size() - 1);
+        score_t const mask_infinity{std::numeric_limits<int8_t>::lowest()};
+        auto const & base_chunk = chunk.base();
+
+        { // Scan the own cells of every lane.
+            // The last cell of a chunk is the first cell of the next chunk.
+            size_t const chunk_end = chunk.size() - (static_cast<size_t>(index) < chunk_count - 1);
+            auto [first, last, overlaps] =
+                to_chunk_range(end_cells.own_begin, end_cells.own_end, chunk_begin, chunk_end);
+
+            vec_int8_t const lowest{std::numeric_limits<int8_t>::lowest()};
+            vec_int8_t local_max_score{lowest};
+            for (size_t chunk_position = 0; chunk_position < chunk_end; ++chunk_position) {
+                vec_uint8_t const position{static_cast<uint8_t>(chunk_position)};
+                mask_uint8_t mask{overlaps & first.le(position) & ~last.lt(position)};
+                // Blending before the maximum avoids an internal compiler error of gcc-12 for avx512bw, which fails
+                // on the masked maximum with a memory operand.
+                local_max_score = max(local_max_score, blend(mask, base_chunk[chunk_position].score(), lowest));
+            }
 
-    template <typename cell_t>
-    constexpr auto score_at(cell_t const & cell, size_t const idx) const noexcept
-    {
-        return cell.score()[idx];
+            auto in_range = mask_infinity.lt(score_t{local_max_score});
+            score_t const score_correction = _padding_score * end_cells.offsets;
+            _max_score = mask_max(_max_score,
+                                  in_range,
+                                  _max_score,
+                                  (score_t{local_max_score} + chunk.offset()) - score_correction);
+        }
+
+        { // Scan the projected cells of every lane.
+            size_t const chunk_end = chunk.size() - 1;
+            auto [first, last, overlaps] =
+                to_chunk_range(end_cells.projected_begin, end_cells.projected_end, chunk_begin, chunk_end);
+
+            vec_int8_t local_max_score{std::numeric_limits<int8_t>::lowest()};
+            vec_int8_t local_score_correction{0};
+            vec_int8_t const local_padding_score{_padding_score};
+            for (size_t chunk_position = 0; chunk_position < chunk_end; ++chunk_position) {
+                vec_uint8_t const position{static_cast<uint8_t>(chunk_position)};
+                mask_uint8_t mask{overlaps & first.le(position) & ~last.lt(position)};
+                local_max_score = mask_max(local_max_score,
+                                           mask,
+                                           local_max_score,
+                                           base_chunk[chunk_position].score() - local_score_correction);
+                local_score_correction = mask_add(local_score_correction,
+                                                  mask,
+                                                  local_score_correction,
+                                                  local_padding_score);
+            }
+
+            auto in_range = mask_infinity.lt(score_t{local_max_score});
+            score_t const score_correction =
+                max(score_t{static_cast<scalar_t>(chunk_begin)} - end_cells.sequence_sizes, end_cells.offsets) *
+                    _padding_score;
+            _max_score = mask_max(_max_score,
+                                  in_range,
+                                  _max_score,
+                                  (score_t{local_max_score} + chunk.offset()) - score_correction);
+        }
     }
 
-    constexpr std::pair<size_t, size_t> to_local_position(size_t const position, size_t const chunk_size, size_t const chunk_count)
-        const noexcept
+    // Maps the positions [begin_position, end_position) of every lane to the chunk covering the positions
+    // [chunk_begin, chunk_begin + chunk_end). Returns the first and the last local position and the mask of the lanes
+    // whose range overlaps the chunk. The chunks of a saturated dp vector have at most 256 cells, such that the local
+    // positions fit into 8 bit and the positions of the whole vector are only limited by the range of score_t.
+    static constexpr auto to_chunk_range(score_t const & begin_position,
+                                         score_t const & end_position,
+                                         size_t const chunk_begin,
+                                         size_t const chunk_end) noexcept
     {
-        size_t idx = position / chunk_size;
-        size_t offset = position % chunk_size;
-        // The last block has one more cell to account for the initialisation cell.
-        // If the last given position of the currently processed vector is a multiple of the chunk size, then
-        // it is the stored inside the last chunk. The respective index and offset are corrected accordingly.
-        size_t is_last_position = (idx == chunk_count);
-        return {idx - is_last_position, offset + (chunk_size * is_last_position)};
+        assert(chunk_end <= 256);
+
+        score_t const zero{0};
+        score_t const one{1};
+        score_t const chunk_first{static_cast<scalar_t>(chunk_begin)};
+        score_t const chunk_last{static_cast<scalar_t>(chunk_begin + chunk_end) - 1};
+        score_t const first = max(begin_position, chunk_first) - chunk_first;
+        score_t const last = min(end_position - one, chunk_last) - chunk_first;
+
+        mask_uint8_t const overlaps = vec_uint8_t{zero}.lt(vec_uint8_t{min(max(last - first + one, zero), one)});
+        // 255 is not representable by int8_t scores, whose positions never exceed the limit of the local positions.
+        constexpr scalar_t local_limit = std::min<int64_t>(255, std::numeric_limits<scalar_t>::max());
+        return std::tuple{vec_uint8_t{min(first, score_t{local_limit})},
+                          vec_uint8_t{max(last, zero)},
+                          overlaps};
     }
 };
 
@@ -467,10 +339,9 @@ struct _factory<score_t>::type
     // params for free end-gaps.
     score_t _padding_score{};
     cfg::trailing_end_gap _end_gap{};
-    size_t _chunk_size{};
 
     constexpr auto make_tracker() const noexcept {
-        return tracker<score_t>{_padding_score, _end_gap, _chunk_size};
+        return tracker<score_t>{_padding_score, _end_gap};
     }
 };
 
@@ -0,0 +1,46 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::detail::static_value.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace detail {
+
+/**
+ * @brief Invokes the factory only once and keeps the created value in static storage.
+ *
+ * @param factory The factory creating the value.
+ * @returns A reference to the value created by the first invocation.
+ *
+ * Every lambda expression has a distinct closure type, such that every call site, and every instantiation of the
+ * enclosing template, refers to its own value. The caller must guarantee that the factory creates the same value on
+ * every invocation, as all but the first invocation are ignored.
+ * The initialisation is thread-safe.
+ */
+template <typename factory_t>
+    requires std::invocable<factory_t>
+std::invoke_result_t<factory_t> const & static_value(factory_t && factory)
+{
+    static std::invoke_result_t<factory_t> const value = std::invoke(std::forward<factory_t>(factory));
+    return value;
+}
+
+} // namespace detail
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::tuning::profile.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+#include <pairwise_aligner/simd/simd_base.hpp>
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace tuning {
+
+/**
+ * @brief The default values of the tunable parameters of the alignment kernels.
+ *
+ * The parameters are compile-time constants, as they select the template instantiations of the kernels.
+ * A host specific profile can be generated with the `pairwise_aligner_tune` target of the benchmarks, which sweeps
+ * the parameters on the host. The generated header is used instead of this profile if its path is given by the
+ * macro `PAIRWISE_ALIGNER_TUNING_PROFILE`, e.g. by setting the cmake variable of the same name.
+ */
+struct default_profile
+{
+    //!\brief The number of columns computed per unrolled lane by all kernels but the saturated NxN kernel.
+    static constexpr size_t lane_width = (detail::max_simd_size == 64) ? 8 : 4;
+    //!\brief The number of columns computed per unrolled lane by the saturated NxN kernel.
+    static constexpr size_t saturated_NxN_lane_width = 4;
+    //!\brief The upper limit of the block size of the saturated kernels; the value range limits it anyway.
+    static constexpr size_t saturated_block_size_limit = std::numeric_limits<size_t>::max();
+    /**
+     * @brief Whether the saturated NxN kernel supports alphabets, whose triangular score matrix exceeds 256 entries.
+     *
+     * The scores of these alphabets are gathered by the ranks of both symbols, which is only native with AVX2 and
+     * AVX-512 and otherwise a scalar loop over the lanes.
+     */
+    static constexpr bool saturated_NxN_gather_by_rank = detail::max_simd_size >= 32;
+};
+
+} // namespace tuning
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
+
+#ifdef PAIRWISE_ALIGNER_TUNING_PROFILE
+    // Must define seqan::pairwise_aligner::tuning::host_profile.
+    #include PAIRWISE_ALIGNER_TUNING_PROFILE
+#else
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace tuning {
+
+using host_profile = default_profile;
+
+} // namespace tuning
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
+#endif // PAIRWISE_ALIGNER_TUNING_PROFILE
+
+namespace seqan::pairwise_aligner
+{
+inline namespace v1
+{
+namespace tuning {
+
+//!\brief The tuning profile used by the alignment kernels.
+using profile = host_profile;
+
+static_assert(std::same_as<decltype(profile::lane_width), size_t const> && profile::lane_width > 0,
+              "The tuning profile must define a positive lane_width.");
+static_assert(std::same_as<decltype(profile::saturated_NxN_lane_width), size_t const> &&
+              profile::saturated_NxN_lane_width > 0,
+              "The tuning profile must define a positive saturated_NxN_lane_width.");
+static_assert(std::same_as<decltype(profile::saturated_block_size_limit), size_t const> &&
+              profile::saturated_block_size_limit > 0,
+              "The tuning profile must define a positive saturated_block_size_limit.");
+static_assert(std::same_as<decltype(profile::saturated_NxN_gather_by_rank), bool const>,
+              "The tuning profile must define saturated_NxN_gather_by_rank.");
+
+} // namespace tuning
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
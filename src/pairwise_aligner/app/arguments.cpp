@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Implements seqan::pairwise_aligner::app::parse_arguments.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#include <charconv>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "batch_alignment.hpp"
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace app {
+
+namespace detail {
+
+template <typename number_t>
+number_t parse_number(std::string_view const option, std::string_view const value)
+{
+    number_t number{};
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (error != std::errc{} || end != value.data() + value.size())
+        throw std::invalid_argument{"The value " + std::string{value} + " of " + std::string{option} +
+                                    " is not a valid number."};
+    return number;
+}
+
+[[noreturn]] inline void throw_invalid_value(std::string_view const option, std::string_view const value)
+{
+    throw std::invalid_argument{"The value " + std::string{value} + " of " + std::string{option} + " is unknown."};
+}
+
+} // namespace detail
+
+batch_alignment_options parse_arguments(std::span<char const * const> arguments)
+{
+    using namespace runtime;
+
+    batch_alignment_options options{};
+    for (size_t argument_idx = 1; argument_idx < arguments.size(); ++argument_idx)
+    {
+        std::string_view const option{arguments[argument_idx]};
+
+        if (option == "--verbose")
+        {
+            options.verbose = true;
+            continue;
+        }
+
+        if (argument_idx + 1 == arguments.size())
+            throw std::invalid_argument{"The option " + std::string{option} + " requires a value."};
+
+        std::string_view const value{arguments[++argument_idx]};
+        if (option == "--queries")
+            options.queries = value;
+        else if (option == "--targets")
+            options.targets = value;
+        else if (option == "--pairs")
+            options.pairs = value;
+        else if (option == "--output")
+            options.output = value;
+        else if (option == "--format")
+        {
+            if (value == "tsv")
+                options.format = output_format::tsv;
+            else if (value == "paf")
+                options.format = output_format::paf;
+            else if (value == "binary")
+                options.format = output_format::binary;
+            else
+                detail::throw_invalid_value(option, value);
+        }
+        else if (option == "--method")
+        {
+            options.parameters.leading_end_gap = cfg::leading_end_gap{};
+            options.parameters.trailing_end_gap = cfg::trailing_end_gap{};
+            if (value == "global")
+            {
+                options.parameters.method = alignment_method::global;
+            }
+            else if (value == "semi-global") // The query is aligned completely, the ends of the target are free.
+            {
+                options.parameters.method = alignment_method::global;
+                options.parameters.leading_end_gap.first_row = cfg::end_gap::free;
+                options.parameters.trailing_end_gap.last_row = cfg::end_gap::free;
+            }
+            else if (value == "local")
+            {
+                options.parameters.method = alignment_method::local;
+            }
+            else
+            {
+                detail::throw_invalid_value(option, value);
+            }
+        }
+        else if (option == "--matrix")
+            options.parameters.substitution_matrix = value;
+        else if (option == "--gap-open")
+            options.parameters.gap_open_score = detail::parse_number<int32_t>(option, value);
+        else if (option == "--gap-extension")
+            options.parameters.gap_extension_score = detail::parse_number<int32_t>(option, value);
+        else if (option == "--engine")
+        {
+            if (value == "auto")
+                options.engine.reset();
+            else if (value == "scalar")
+                options.engine = alignment_engine::scalar;
+            else if (value == "simd_NxN")
+                options.engine = alignment_engine::simd_NxN;
+            else if (value == "simd_1xN")
+                options.engine = alignment_engine::simd_1xN;
+            else
+                detail::throw_invalid_value(option, value);
+        }
+        else if (option == "--precision")
+        {
+            if (value == "auto")
+                options.precision.reset();
+            else if (value == "int8_saturated")
+                options.precision = score_precision::int8_saturated;
+            else if (value == "int16")
+                options.precision = score_precision::int16;
+            else if (value == "int32")
+                options.precision = score_precision::int32;
+            else
+                detail::throw_invalid_value(option, value);
+        }
+        else if (option == "--threads")
+            options.thread_count = detail::parse_number<size_t>(option, value);
+        else if (option == "--prepare-threads")
+            options.prepare_thread_count = detail::parse_number<size_t>(option, value);
+        else if (option == "--decompression-threads")
+            options.decompression_thread_count = detail::parse_number<size_t>(option, value);
+        else if (option == "--batch-size")
+            options.batch_size = detail::parse_number<size_t>(option, value);
+        else if (option == "--queue-capacity")
+            options.queue_capacity = detail::parse_number<size_t>(option, value);
+        else
+            throw std::invalid_argument{"Unknown option " + std::string{option} + "."};
+    }
+
+    if (options.queries.empty() || options.targets.empty())
+        throw std::invalid_argument{"The options --queries and --targets are required."};
+
+    return options;
+}
+
+void print_usage(std::ostream & stream, std::string_view const program_name)
+{
+    stream << "Usage: " << program_name << " --queries FILE --targets FILE [OPTIONS]\n"
+           << "\n"
+           << "Aligns every query to every target, or the pairs of the pair list, and writes the scores.\n"
+           << "\n"
+           << "Input:\n"
+           << "  --queries FILE          FASTA or FASTQ file with the first sequences.\n"
+           << "  --targets FILE          FASTA or FASTQ file with the second sequences.\n"
+           << "                          Both files might be compressed with gzip or BGZF.\n"
+           << "  --pairs FILE            File with one query and target name per line.\n"
+           << "\n"
+           << "Output:\n"
+           << "  --output FILE           Output file; the standard output by default.\n"
+           << "  --format FORMAT         tsv (default), paf or binary.\n"
+           << "\n"
+           << "Alignment:\n"
+           << "  --method METHOD         global (default), semi-global or local.\n"
+           << "  --matrix NAME           blosum62 (default) or blosum62_extended.\n"
+           << "  --gap-open SCORE        Score for opening a gap; -10 by default.\n"
+           << "  --gap-extension SCORE   Score for extending a gap; -1 by default.\n"
+           << "  --engine ENGINE         auto (default), scalar, simd_NxN or simd_1xN.\n"
+           << "  --precision PRECISION   auto (default), int8_saturated, int16 or int32.\n"
+           << "\n"
+           << "Execution:\n"
+           << "  --threads COUNT         Number of aligning threads; 0 uses all cores. 1 by default.\n"
+           << "  --prepare-threads COUNT Number of threads transposing the sequences; 1 by default.\n"
+           << "  --decompression-threads COUNT\n"
+           << "                          Number of threads decompressing a BGZF file; 1 by default.\n"
+           << "  --batch-size COUNT      Number of pairs aligned by one thread at a time; 4096 by default.\n"
+           << "  --queue-capacity COUNT  Number of batches waiting per thread; 4 by default.\n"
+           << "  --verbose               Logs the selected kernel and the throughput of every stage.\n";
+}
+
+} // namespace app
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
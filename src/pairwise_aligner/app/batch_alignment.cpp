@@ -0,0 +1,621 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Implements seqan::pairwise_aligner::app::run_batch_alignment.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <semaphore>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/io/indexed_sequence_file.hpp>
+#include <pairwise_aligner/io/mapped_file.hpp>
+#include <pairwise_aligner/io/sequence_file_reader.hpp>
+#include <pairwise_aligner/pipeline/pipeline.hpp>
+#include <pairwise_aligner/runtime/planner.hpp>
+
+#include "batch_alignment.hpp"
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace app {
+
+namespace detail {
+
+// The number of records read at once from the sequence files.
+inline constexpr size_t record_batch_size = 1024;
+
+// The pairs computed by one thread at a time together with their results.
+struct work_item
+{
+    size_t sequence_number{}; // The position of the item in the output.
+    std::vector<std::shared_ptr<void const>> owners{}; // Keep the files and buffers referred to by the views alive.
+    std::vector<uint64_t> pair_positions{}; // The positions of the pairs in the pair list, if one is given.
+    std::vector<std::string_view> ids1{};
+    std::vector<std::string_view> ids2{};
+    std::vector<uint64_t> indices1{};
+    std::vector<uint64_t> indices2{};
+    std::vector<std::string_view> sequences1{};
+    std::vector<std::string_view> sequences2{};
+    runtime::prepared_pairs prepared{}; // The pairs transposed by the prepare stage.
+    std::vector<int32_t> scores{};
+
+    size_t size() const noexcept
+    {
+        return sequences1.size();
+    }
+
+    void add(std::string_view const id1, uint64_t const index1, std::string_view const sequence1,
+             std::string_view const id2, uint64_t const index2, std::string_view const sequence2)
+    {
+        ids1.push_back(id1);
+        indices1.push_back(index1);
+        sequences1.push_back(sequence1);
+        ids2.push_back(id2);
+        indices2.push_back(index2);
+        sequences2.push_back(sequence2);
+    }
+};
+
+// All records of a sequence file; the reader owns the mapped file and the batches own the joined multi-line records.
+struct sequence_store
+{
+    sequence_file_reader reader{};
+    std::vector<sequence_record_batch> batches{};
+    std::vector<std::string_view> ids{};
+    std::vector<std::string_view> sequences{};
+};
+
+// Returns the id up to the first whitespace, which is used as the name of the sequence.
+inline std::string_view sequence_name(std::string_view const id) noexcept
+{
+    return id.substr(0, id.find_first_of(" \t"));
+}
+
+inline std::shared_ptr<sequence_store const> read_sequences(std::filesystem::path const & file_path,
+                                                            size_t const decompression_thread_count)
+{
+    auto store = std::make_shared<sequence_store>();
+    store->reader = sequence_file_reader{file_path, record_batch_size, decompression_thread_count};
+    for (sequence_record_batch batch{}; store->reader.read_batch(batch); batch = sequence_record_batch{})
+    {
+        store->ids.insert(store->ids.end(), batch.ids().begin(), batch.ids().end());
+        store->sequences.insert(store->sequences.end(), batch.sequences().begin(), batch.sequences().end());
+        store->batches.push_back(std::move(batch)); // Moving the batch keeps its views valid.
+    }
+    return store;
+}
+
+// Aligns every query to every target, where the targets are streamed in batches.
+template <typename emit_t>
+void produce_all_pairs(batch_alignment_options const & options, emit_t && emit)
+{
+    std::shared_ptr<sequence_store const> queries = read_sequences(options.queries, options.decompression_thread_count);
+    size_t const query_count = queries->sequences.size();
+    if (query_count == 0)
+        return;
+
+    size_t const target_batch_size = std::max<size_t>(1, options.batch_size / query_count);
+    size_t const query_chunk_size = std::max<size_t>(1, options.batch_size / target_batch_size);
+
+    auto target_reader = std::make_shared<sequence_file_reader>(options.targets,
+                                                                target_batch_size,
+                                                                options.decompression_thread_count);
+    uint64_t target_offset = 0;
+    for (auto targets = std::make_shared<sequence_record_batch>();
+         target_reader->read_batch(*targets);
+         targets = std::make_shared<sequence_record_batch>())
+    {
+        for (size_t first_query = 0; first_query < query_count; first_query += query_chunk_size)
+        {
+            size_t const last_query = std::min(first_query + query_chunk_size, query_count);
+
+            work_item item{};
+            item.owners = {queries, target_reader, targets};
+            for (size_t query_idx = first_query; query_idx < last_query; ++query_idx)
+                for (size_t target_idx = 0; target_idx < targets->size(); ++target_idx)
+                    item.add(queries->ids[query_idx], query_idx, queries->sequences[query_idx],
+                             targets->ids()[target_idx], target_offset + target_idx, targets->sequences()[target_idx]);
+
+            if (!emit(std::move(item)))
+                return;
+        }
+        target_offset += targets->size();
+    }
+}
+
+// The sequences of an input file, which are referred to by their names.
+class named_sequences
+{
+private:
+    // Plain FASTA files are accessed through their index and all other files are read completely.
+    std::shared_ptr<indexed_sequence_file> _indexed_file{};
+    std::shared_ptr<sequence_store const> _store{};
+    std::unordered_map<std::string_view, uint64_t> _name_to_index{};
+
+public:
+
+    named_sequences(std::filesystem::path const & file_path, size_t const decompression_thread_count)
+    {
+        mapped_file const file{file_path};
+        std::string_view const content = file.view();
+        size_t const first_symbol = content.find_first_not_of("\r\n");
+        if (first_symbol != std::string_view::npos && content[first_symbol] == '>')
+        {
+            _indexed_file = std::make_shared<indexed_sequence_file>(file_path);
+            return;
+        }
+
+        _store = read_sequences(file_path, decompression_thread_count);
+        for (uint64_t index = 0; index < _store->ids.size(); ++index)
+            _name_to_index.emplace(sequence_name(_store->ids[index]), index);
+    }
+
+    uint64_t find(std::string_view const name) const
+    {
+        std::optional<uint64_t> index{};
+        if (_indexed_file != nullptr)
+        {
+            index = _indexed_file->find(name);
+        }
+        else if (auto it = _name_to_index.find(name); it != _name_to_index.end())
+        {
+            index = it->second;
+        }
+
+        if (!index)
+            throw std::runtime_error{"The pair list refers to the unknown sequence " + std::string{name} + "."};
+        return *index;
+    }
+
+    std::string_view name(uint64_t const index) const
+    {
+        return (_indexed_file != nullptr) ? _indexed_file->name(index) : sequence_name(_store->ids[index]);
+    }
+
+    size_t length(uint64_t const index) const
+    {
+        return (_indexed_file != nullptr) ? _indexed_file->length(index) : _store->sequences[index].size();
+    }
+
+    // Returns the sequence and the owner of a sequence joined from multiple lines.
+    indexed_sequence sequence(uint64_t const index) const
+    {
+        return (_indexed_file != nullptr) ? _indexed_file->sequence(index)
+                                          : indexed_sequence{_store->sequences[index], nullptr};
+    }
+};
+
+// The pairs of the pair list together with the sequences they refer to.
+struct pair_list
+{
+    struct pair
+    {
+        uint64_t query{};
+        uint64_t target{};
+    };
+
+    named_sequences queries;
+    named_sequences targets;
+    std::vector<pair> pairs{}; // In the order of the pair list.
+    std::vector<uint64_t> grouped_positions{}; // The positions of the pairs sorted by their target.
+};
+
+// Reads the pair list and groups the pairs by their target.
+inline std::shared_ptr<pair_list const> read_pair_list(batch_alignment_options const & options)
+{
+    auto list = std::make_shared<pair_list>(named_sequences{options.queries, options.decompression_thread_count},
+                                            named_sequences{options.targets, options.decompression_thread_count});
+
+    mapped_file const pair_file{options.pairs};
+    std::string_view content = pair_file.view();
+    pair_file.advise_sequential();
+    while (!content.empty())
+    {
+        size_t const line_end = std::min(content.find('\n'), content.size());
+        std::string_view line = content.substr(0, line_end);
+        content.remove_prefix(std::min(line_end + 1, content.size()));
+
+        size_t const query_begin = line.find_first_not_of(" \t\r");
+        if (query_begin == std::string_view::npos || line[query_begin] == '#') // Skip empty lines and comments.
+            continue;
+
+        line.remove_prefix(query_begin);
+        size_t const query_end = std::min(line.find_first_of(" \t"), line.size());
+        std::string_view const query_name = line.substr(0, query_end);
+        line.remove_prefix(query_end);
+        line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+        std::string_view const target_name = line.substr(0, std::min(line.find_first_of(" \t\r"), line.size()));
+        if (target_name.empty())
+            throw std::runtime_error{"The pair list contains a line without target: " + std::string{query_name}};
+
+        list->pairs.push_back({list->queries.find(query_name), list->targets.find(target_name)});
+    }
+
+    list->grouped_positions.resize(list->pairs.size());
+    std::iota(list->grouped_positions.begin(), list->grouped_positions.end(), 0);
+    std::ranges::stable_sort(list->grouped_positions, std::less<>{}, [&] (uint64_t const position) {
+        return list->pairs[position].target;
+    });
+    return list;
+}
+
+// Aligns the pairs of the pair list grouped by their target, which is loaded once per group.
+// The target is the first sequence, such that the simd_1xN engine transposes it only once for the whole group.
+template <typename emit_t>
+void produce_listed_pairs(std::shared_ptr<pair_list const> const & list, size_t const batch_size, emit_t && emit)
+{
+    auto make_item = [&] () {
+        work_item item{};
+        item.owners = {list};
+        return item;
+    };
+
+    work_item item = make_item();
+    uint64_t current_target = std::numeric_limits<uint64_t>::max();
+    indexed_sequence target{};
+    bool owns_target = false; // Whether the current item keeps the target alive.
+    for (uint64_t const position : list->grouped_positions)
+    {
+        pair_list::pair const & listed_pair = list->pairs[position];
+        if (listed_pair.target != current_target)
+        {
+            current_target = listed_pair.target;
+            target = list->targets.sequence(current_target);
+            owns_target = false;
+        }
+
+        if (!std::exchange(owns_target, true) && target.owner != nullptr)
+            item.owners.push_back(target.owner);
+
+        indexed_sequence query = list->queries.sequence(listed_pair.query);
+        if (query.owner != nullptr)
+            item.owners.push_back(std::move(query.owner));
+
+        item.sequences1.push_back(target.sequence);
+        item.sequences2.push_back(query.sequence);
+        item.pair_positions.push_back(position);
+
+        if (item.size() == batch_size)
+        {
+            if (!emit(std::exchange(item, make_item())))
+                return;
+            owns_target = false;
+        }
+    }
+
+    if (item.size() > 0)
+        emit(std::move(item));
+}
+
+// Swaps the end gaps of the rows and the columns, which computes the same scores with swapped sequences.
+inline runtime::aligner_parameters transpose_end_gaps(runtime::aligner_parameters parameters) noexcept
+{
+    std::swap(parameters.leading_end_gap.first_row, parameters.leading_end_gap.first_column);
+    std::swap(parameters.trailing_end_gap.last_row, parameters.trailing_end_gap.last_column);
+    return parameters;
+}
+
+// The result of one pair as it is written to the output.
+struct result_record
+{
+    std::string_view name1{};
+    size_t length1{};
+    uint64_t index1{};
+    std::string_view name2{};
+    size_t length2{};
+    uint64_t index2{};
+    int32_t score{};
+};
+
+// Formats the results in the requested format and writes them to the output.
+class result_writer
+{
+private:
+    output_format _format{};
+    runtime::alignment_method _method{};
+    std::ostream & _output;
+    std::string _buffer{};
+
+public:
+
+    explicit result_writer(output_format const format, runtime::alignment_method const method, std::ostream & output) :
+        _format{format},
+        _method{method},
+        _output{output}
+    {}
+
+    // Writes the results of all pairs of the item.
+    void write(work_item const & item)
+    {
+        for (size_t pair_idx = 0; pair_idx < item.size(); ++pair_idx)
+        {
+            append(result_record{.name1 = sequence_name(item.ids1[pair_idx]),
+                                 .length1 = item.sequences1[pair_idx].size(),
+                                 .index1 = item.indices1[pair_idx],
+                                 .name2 = sequence_name(item.ids2[pair_idx]),
+                                 .length2 = item.sequences2[pair_idx].size(),
+                                 .index2 = item.indices2[pair_idx],
+                                 .score = item.scores[pair_idx]});
+        }
+        flush();
+    }
+
+    // Formats the record into the buffer, which is written by the next call of flush.
+    void append(result_record const & record)
+    {
+        switch (_format)
+        {
+            case output_format::tsv: append_tsv(record); break;
+            case output_format::paf: append_paf(record); break;
+            case output_format::binary: append_binary(record); break;
+        }
+    }
+
+    void flush()
+    {
+        if (!_output.write(_buffer.data(), _buffer.size()))
+            throw std::runtime_error{"Could not write the results."};
+        _buffer.clear();
+    }
+
+private:
+
+    template <typename value_t>
+    void append_number(value_t const value)
+    {
+        char digits[24];
+        auto [end, error] = std::to_chars(std::begin(digits), std::end(digits), value);
+        _buffer.append(digits, end);
+    }
+
+    void append_tsv(result_record const & record)
+    {
+        _buffer.append(record.name1).push_back('\t');
+        append_number(record.length1);
+        _buffer.push_back('\t');
+        _buffer.append(record.name2).push_back('\t');
+        append_number(record.length2);
+        _buffer.push_back('\t');
+        append_number(record.score);
+        _buffer.push_back('\n');
+    }
+
+    void append_paf(result_record const & record)
+    {
+        _buffer.append(record.name1).push_back('\t');
+        append_number(record.length1);
+        _buffer.append("\t0\t");
+        append_number(record.length1);
+        _buffer.append("\t+\t");
+        _buffer.append(record.name2).push_back('\t');
+        append_number(record.length2);
+        _buffer.append("\t0\t");
+        append_number(record.length2);
+        _buffer.append("\t0\t");
+        append_number(std::max(record.length1, record.length2));
+        _buffer.append("\t255\tAS:i:");
+        append_number(record.score);
+        _buffer.append((_method == runtime::alignment_method::local) ? "\ttp:A:L\n" : "\ttp:A:G\n");
+    }
+
+    void append_binary(result_record const & record)
+    {
+        char bytes[2 * sizeof(uint64_t) + sizeof(int32_t)];
+        std::memcpy(bytes, &record.index1, sizeof(uint64_t));
+        std::memcpy(bytes + sizeof(uint64_t), &record.index2, sizeof(uint64_t));
+        std::memcpy(bytes + 2 * sizeof(uint64_t), &record.score, sizeof(int32_t));
+        _buffer.append(bytes, sizeof(bytes));
+    }
+};
+
+// Selects the engine and the precision which were not given by the options.
+inline runtime::aligner_parameters plan_parameters(batch_alignment_options const & options,
+                                                   runtime::aligner_parameters parameters,
+                                                   work_item const & first_item,
+                                                   std::ostream & log)
+{
+    if (!options.engine || !options.precision)
+    {
+        parameters = runtime::plan_aligner(parameters,
+                                           runtime::collect_batch_statistics(first_item.sequences1,
+                                                                             first_item.sequences2),
+                                           options.verbose ? &log : nullptr);
+    }
+
+    parameters.engine = options.engine.value_or(parameters.engine);
+    parameters.precision = options.precision.value_or(parameters.precision);
+    return parameters;
+}
+
+} // namespace detail
+
+void run_batch_alignment(batch_alignment_options const & options, std::ostream & output, std::ostream & log)
+{
+    using detail::work_item;
+
+    if (options.batch_size == 0 || options.queue_capacity == 0 || options.prepare_thread_count == 0)
+        throw std::invalid_argument{"The batch size, the queue capacity and the number of preparing threads must be "
+                                    "greater than zero."};
+
+    size_t const thread_count = (options.thread_count > 0) ? options.thread_count
+                                                           : std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t const capacity = thread_count * options.queue_capacity;
+
+    pipeline_channel<work_item> read_items{capacity};
+    pipeline_channel<work_item> prepared_items{capacity};
+    pipeline_channel<work_item> computed_items{capacity};
+    // The items between reading and writing; bounds the items waiting for a slower item to be written before them.
+    std::counting_semaphore<> free_slots{static_cast<std::ptrdiff_t>(capacity)};
+
+    // The pair list is grouped by target, which is the first sequence of the pairs; see produce_listed_pairs.
+    std::shared_ptr<detail::pair_list const> const pair_list =
+        options.pairs.empty() ? nullptr : detail::read_pair_list(options);
+    runtime::aligner_parameters const parameters_of_pairs =
+        options.pairs.empty() ? options.parameters : detail::transpose_end_gaps(options.parameters);
+
+    std::promise<runtime::aligner_parameters> planned_parameters{};
+    std::shared_future<runtime::aligner_parameters> parameters = planned_parameters.get_future().share();
+
+    pipeline pipe{};
+
+    // Reads the sequences and groups the pairs into items.
+    pipe.add_source("read", read_items, [&] (auto emit) {
+        size_t sequence_number = 0;
+        auto emit_item = [&] (work_item item) {
+            if (sequence_number == 0)
+                planned_parameters.set_value(detail::plan_parameters(options, parameters_of_pairs, item, log));
+
+            while (!free_slots.try_acquire_for(std::chrono::milliseconds{10}))
+            {
+                if (pipe.is_cancelled())
+                    return false;
+            }
+
+            item.sequence_number = sequence_number++;
+            return emit(std::move(item));
+        };
+
+        try
+        {
+            if (pair_list == nullptr)
+                detail::produce_all_pairs(options, emit_item);
+            else
+                detail::produce_listed_pairs(pair_list, options.batch_size, emit_item);
+        }
+        catch (...)
+        {
+            if (sequence_number == 0)
+                planned_parameters.set_exception(std::current_exception());
+            throw;
+        }
+
+        if (sequence_number == 0)
+            planned_parameters.set_value(parameters_of_pairs);
+    });
+
+    // Transforms and transposes the sequences into the layout of the kernel.
+    pipe.add_stage("prepare", options.prepare_thread_count, read_items, prepared_items, [&] () {
+        return [aligner = runtime::aligner{parameters.get()}] (work_item item) {
+            item.prepared = aligner.prepare(item.sequences1, item.sequences2);
+            return item;
+        };
+    });
+
+    // Aligns the prepared pairs; every thread uses its own aligner.
+    pipe.add_stage("align", thread_count, prepared_items, computed_items, [&] () {
+        return [aligner = runtime::aligner{parameters.get()}] (work_item item) mutable {
+            item.scores.resize(item.size());
+            aligner.compute(item.prepared, item.scores);
+            item.prepared = runtime::prepared_pairs{}; // Releases the prepared sequences before the item is written.
+            return item;
+        };
+    });
+
+    // Writes the results in the order of the items or in the order of the pair list.
+    size_t pair_count = 0;
+    detail::result_writer writer{options.format, options.parameters.method, output};
+    std::map<size_t, work_item> computed_out_of_order{};
+    size_t next_sequence_number = 0;
+    auto write_items = [&] (work_item item) {
+        computed_out_of_order.emplace(item.sequence_number, std::move(item));
+        for (auto it = computed_out_of_order.begin();
+             it != computed_out_of_order.end() && it->first == next_sequence_number;
+             it = computed_out_of_order.erase(it), ++next_sequence_number)
+        {
+            writer.write(it->second);
+            pair_count += it->second.size();
+            free_slots.release();
+        }
+    };
+
+    // Only the scores of the pairs are kept until all pairs listed before them are computed.
+    std::vector<int32_t> listed_scores(pair_list ? pair_list->pairs.size() : 0);
+    std::vector<bool> is_computed(listed_scores.size(), false);
+    size_t written_pair_count = 0;
+    auto write_listed_pairs = [&] (work_item item) {
+        for (size_t pair_idx = 0; pair_idx < item.size(); ++pair_idx)
+        {
+            listed_scores[item.pair_positions[pair_idx]] = item.scores[pair_idx];
+            is_computed[item.pair_positions[pair_idx]] = true;
+        }
+        pair_count += item.size();
+        item = work_item{}; // Releases the sequences before the slot is freed.
+        free_slots.release();
+
+        for (; written_pair_count < is_computed.size() && is_computed[written_pair_count]; ++written_pair_count)
+        {
+            detail::pair_list::pair const & listed_pair = pair_list->pairs[written_pair_count];
+            writer.append(detail::result_record{.name1 = pair_list->queries.name(listed_pair.query),
+                                                .length1 = pair_list->queries.length(listed_pair.query),
+                                                .index1 = listed_pair.query,
+                                                .name2 = pair_list->targets.name(listed_pair.target),
+                                                .length2 = pair_list->targets.length(listed_pair.target),
+                                                .index2 = listed_pair.target,
+                                                .score = listed_scores[written_pair_count]});
+        }
+        writer.flush();
+    };
+
+    pipe.add_sink("write", computed_items, [&] (work_item item) {
+        if (pair_list == nullptr)
+            write_items(std::move(item));
+        else
+            write_listed_pairs(std::move(item));
+    });
+
+    auto const start = std::chrono::steady_clock::now();
+    pipe.run();
+
+    if (!output.flush())
+        throw std::runtime_error{"Could not write the results."};
+
+    if (options.verbose)
+    {
+        std::chrono::duration<double> const seconds = std::chrono::steady_clock::now() - start;
+        log << "[batch_alignment] pairs=" << pair_count
+            << " threads=" << thread_count
+            << " seconds=" << seconds.count()
+            << " pairs_per_second=" << (pair_count / std::max(seconds.count(), 1e-9)) << '\n';
+
+        for (pipeline_stage_statistics const & stage : pipe.statistics())
+        {
+            log << "[batch_alignment] stage=" << stage.name
+                << " threads=" << stage.thread_count
+                << " batches=" << stage.item_count
+                << " busy_seconds=" << stage.busy_seconds
+                << " input_wait_seconds=" << stage.input_wait_seconds
+                << " output_wait_seconds=" << stage.output_wait_seconds
+                << " batches_per_second=" << stage.items_per_second() << '\n';
+        }
+    }
+}
+
+} // namespace app
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides seqan::pairwise_aligner::app::run_batch_alignment.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include <pairwise_aligner/runtime/aligner.hpp>
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace app {
+
+//!\brief The formats of the scores written by seqan::pairwise_aligner::app::run_batch_alignment.
+enum struct output_format
+{
+    tsv, //!< One line per pair with the ids and lengths of both sequences and the score.
+    //!\brief One PAF line per pair with the score in the `AS:i` tag.
+    //!\details The kernels compute only the scores, hence the coordinates span the whole sequences.
+    paf,
+    binary //!< One record per pair with the 64-bit indices of both sequences and the 32-bit score.
+};
+
+//!\brief The options of the batch alignment.
+struct batch_alignment_options
+{
+    //!\brief The FASTA or FASTQ file with the first sequences of the pairs; might be compressed with gzip or BGZF.
+    std::filesystem::path queries{};
+    //!\brief The FASTA or FASTQ file with the second sequences of the pairs; might be compressed like the queries.
+    std::filesystem::path targets{};
+    //!\brief The file with one pair of query and target id per line; if empty, all queries are aligned to all targets.
+    std::filesystem::path pairs{};
+    std::filesystem::path output{}; //!< The output file; if empty, the results are written to the standard output.
+    output_format format{output_format::tsv}; //!< The format of the output.
+    runtime::aligner_parameters parameters{}; //!< The parameters of the aligner.
+    //!\brief The engine of the aligner; if not set, it is selected by seqan::pairwise_aligner::runtime::plan_aligner.
+    std::optional<runtime::alignment_engine> engine{};
+    //!\brief The precision of the aligner; if not set, it is selected like the engine.
+    std::optional<runtime::score_precision> precision{};
+    size_t thread_count{1}; //!< The number of threads computing the alignments; 0 selects the number of cores.
+    size_t prepare_thread_count{1}; //!< The number of threads transposing the sequences for the aligning threads.
+    size_t decompression_thread_count{1}; //!< The number of threads decompressing every BGZF compressed input file.
+    size_t batch_size{4096}; //!< The maximal number of pairs computed by one thread at a time.
+    size_t queue_capacity{4}; //!< The maximal number of batches waiting per thread; bounds the memory.
+    bool verbose{false}; //!< Whether the planned parameters and the progress are logged.
+};
+
+/**
+ * @brief Parses the command line arguments.
+ *
+ * @throws std::invalid_argument if an argument is unknown, misses its value or has an invalid value.
+ */
+batch_alignment_options parse_arguments(std::span<char const * const> arguments);
+
+//!\brief Writes the description of the command line arguments to the stream.
+void print_usage(std::ostream & stream, std::string_view program_name);
+
+/**
+ * @brief Aligns the pairs selected by the options and writes the results to the stream.
+ *
+ * The sequence files are read, the sequences are transposed into the layout of the kernel, the pairs are aligned
+ * by the given number of threads and the results are written at the same time. The stages run as a
+ * seqan::pairwise_aligner::pipeline, whose bounded channels make a stage that is ahead of the others wait, such that
+ * at most `thread_count * queue_capacity` batches are held in memory. The results are written in the
+ * order of the pair list. Without a pair list, the targets are read in batches and the results are ordered by the
+ * batch of targets, then by query and then by target.
+ *
+ * With a pair list, plain FASTA files are accessed through their index, such that every sequence is loaded once and
+ * shared by all pairs referring to it. The pairs are aligned grouped by their target, which allows the simd_1xN
+ * engine to transpose the target only once per group; only the scores are kept until they can be written in order.
+ *
+ * @param options The options of the batch alignment.
+ * @param output The stream receiving the results; opened in binary mode for the binary format.
+ * @param log The stream receiving the log messages if the options enable them.
+ *
+ * @throws std::runtime_error if a file cannot be read or the pair list refers to unknown ids.
+ */
+void run_batch_alignment(batch_alignment_options const & options, std::ostream & output, std::ostream & log);
+
+} // namespace app
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief The command line application aligning the sequences of FASTA and FASTQ files.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include "batch_alignment.hpp"
+
+int main(int argc, char const ** argv)
+{
+    namespace app = seqan::pairwise_aligner::app;
+
+    std::span<char const * const> const arguments{argv, static_cast<size_t>(argc)};
+    std::string_view const program_name = arguments.empty() ? "pairwise_align" : arguments[0];
+    if (std::ranges::find(arguments, std::string_view{"--help"}) != arguments.end())
+    {
+        app::print_usage(std::cout, program_name);
+        return 0;
+    }
+
+    app::batch_alignment_options options{};
+    try
+    {
+        options = app::parse_arguments(arguments);
+    }
+    catch (std::invalid_argument const & error)
+    {
+        std::cerr << "[error] " << error.what() << "\n\n";
+        app::print_usage(std::cerr, program_name);
+        return 1;
+    }
+
+    try
+    {
+        if (options.output.empty())
+        {
+            std::ios::sync_with_stdio(false);
+            app::run_batch_alignment(options, std::cout, std::cerr);
+        }
+        else
+        {
+            std::ofstream output{options.output, std::ios::binary | std::ios::trunc};
+            if (!output)
+                throw std::runtime_error{"Could not create the output file " + options.output.string() + "."};
+
+            app::run_batch_alignment(options, output, std::cerr);
+        }
+    }
+    catch (std::exception const & error)
+    {
+        std::cerr << "[error] " << error.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Implements seqan::pairwise_aligner::runtime::aligner.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <pairwise_aligner/runtime/aligner.hpp>
+
+#include "kernel.hpp"
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime {
+
+namespace detail {
+
+// Sorts the pairs by their longest sequence, such that the lanes of a bulk finish at roughly the same time.
+// A bulk computes the matrix of the longest first and the longest second sequence of its lanes. If a lane with a long
+// first sequence shares the bulk with a lane with a long second sequence, the blocks beyond the ends of both lanes
+// contain only padding. Hence, the pairs are first split by which of their sequences is longer, and pairs with the
+// same longest sequence are ordered by their shorter one, such that the lanes of a bulk rarely extend in opposite
+// directions.
+inline std::vector<size_t> length_order(std::span<std::string_view const> sequences1,
+                                        std::span<std::string_view const> sequences2)
+{
+    std::vector<size_t> order(sequences1.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, std::less<>{}, [&] (size_t const index) {
+        size_t const size1 = sequences1[index].size();
+        size_t const size2 = sequences2[index].size();
+        return std::tuple{size1 > size2, std::max(size1, size2), std::min(size1, size2)};
+    });
+    return order;
+}
+
+inline std::vector<std::string_view> permute(std::span<std::string_view const> sequences,
+                                             std::vector<size_t> const & order)
+{
+    std::vector<std::string_view> permuted_sequences(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        permuted_sequences[i] = sequences[order[i]];
+    return permuted_sequences;
+}
+
+} // namespace detail
+
+prepared_pairs::prepared_pairs() = default;
+prepared_pairs::prepared_pairs(prepared_pairs &&) noexcept = default;
+prepared_pairs & prepared_pairs::operator=(prepared_pairs &&) noexcept = default;
+prepared_pairs::~prepared_pairs() = default;
+
+aligner::aligner(aligner_parameters const & parameters)
+{
+    switch (parameters.method)
+    {
+        case alignment_method::global: _kernel = detail::make_global_kernel(parameters); break;
+        case alignment_method::local: _kernel = detail::make_local_kernel(parameters); break;
+        default: throw std::invalid_argument{"Unknown alignment method."};
+    }
+
+    assert(_kernel != nullptr);
+    _group_by_length = parameters.group_by_length && parameters.engine == alignment_engine::simd_NxN;
+}
+
+aligner::aligner(aligner &&) noexcept = default;
+aligner & aligner::operator=(aligner &&) noexcept = default;
+aligner::~aligner() = default;
+
+size_t aligner::bulk_size() const noexcept
+{
+    assert(_kernel != nullptr);
+    return _kernel->bulk_size();
+}
+
+void aligner::compute(std::span<std::string_view const> sequences1,
+                      std::span<std::string_view const> sequences2,
+                      std::span<int32_t> scores)
+{
+    assert(_kernel != nullptr);
+
+    if (sequences1.size() != sequences2.size() || sequences1.size() != scores.size())
+        throw std::invalid_argument{"The number of first sequences, second sequences and scores must be equal."};
+
+    if (!_group_by_length)
+        return compute_in_order(sequences1, sequences2, scores);
+
+    std::vector<size_t> const order = detail::length_order(sequences1, sequences2);
+    std::vector<int32_t> sorted_scores(order.size());
+    compute_in_order(detail::permute(sequences1, order), detail::permute(sequences2, order), sorted_scores);
+
+    for (size_t i = 0; i < order.size(); ++i)
+        scores[order[i]] = sorted_scores[i];
+}
+
+std::vector<int32_t> aligner::compute(std::span<std::string_view const> sequences1,
+                                      std::span<std::string_view const> sequences2)
+{
+    std::vector<int32_t> scores(sequences1.size());
+    compute(sequences1, sequences2, scores);
+    return scores;
+}
+
+prepared_pairs aligner::prepare(std::span<std::string_view const> sequences1,
+                                std::span<std::string_view const> sequences2) const
+{
+    assert(_kernel != nullptr);
+
+    if (sequences1.size() != sequences2.size())
+        throw std::invalid_argument{"The number of first and second sequences must be equal."};
+
+    prepared_pairs pairs{};
+    pairs._size = sequences1.size();
+    if (!_group_by_length)
+    {
+        pairs._bulks = _kernel->prepare(sequences1, sequences2);
+    }
+    else
+    {
+        pairs._order = detail::length_order(sequences1, sequences2);
+        pairs._bulks = _kernel->prepare(detail::permute(sequences1, pairs._order),
+                                        detail::permute(sequences2, pairs._order));
+    }
+    return pairs;
+}
+
+void aligner::compute(prepared_pairs const & pairs, std::span<int32_t> scores)
+{
+    assert(_kernel != nullptr);
+
+    if (pairs.size() != scores.size())
+        throw std::invalid_argument{"The number of prepared pairs and scores must be equal."};
+
+    if (pairs.size() == 0)
+        return;
+
+    if (pairs._order.empty())
+        return _kernel->compute(*pairs._bulks, scores);
+
+    std::vector<int32_t> sorted_scores(pairs.size());
+    _kernel->compute(*pairs._bulks, sorted_scores);
+
+    for (size_t i = 0; i < pairs._order.size(); ++i)
+        scores[pairs._order[i]] = sorted_scores[i];
+}
+
+void aligner::compute_in_order(std::span<std::string_view const> sequences1,
+                               std::span<std::string_view const> sequences2,
+                               std::span<int32_t> scores)
+{
+    size_t const bulk_size = _kernel->bulk_size();
+    for (size_t offset = 0; offset < sequences1.size(); offset += bulk_size)
+    {
+        size_t const count = std::min(bulk_size, sequences1.size() - offset);
+        _kernel->compute(sequences1.subspan(offset, count),
+                         sequences2.subspan(offset, count),
+                         scores.subspan(offset, count));
+    }
+}
+
+} // namespace runtime
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the interface of the precompiled kernels of the seqan::pairwise_aligner::runtime::aligner.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <pairwise_aligner/runtime/aligner.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime::detail {
+
+//!\brief The interface of the pairs prepared by a kernel; see seqan::pairwise_aligner::runtime::prepared_pairs.
+struct prepared_bulk_base
+{
+    virtual ~prepared_bulk_base() = default;
+};
+
+//!\brief The interface of the precompiled kernels.
+struct kernel_base
+{
+    virtual ~kernel_base() = default;
+
+    //!\brief The maximal number of pairs passed to a single call of compute().
+    virtual size_t bulk_size() const noexcept = 0;
+
+    //!\brief Computes the scores of at most bulk_size() pairs.
+    virtual void compute(std::span<std::string_view const> sequences1,
+                         std::span<std::string_view const> sequences2,
+                         std::span<int32_t> scores) = 0;
+
+    //!\brief Transforms and transposes any number of pairs in bulks of at most bulk_size() pairs.
+    virtual std::unique_ptr<prepared_bulk_base> prepare(std::span<std::string_view const> sequences1,
+                                                        std::span<std::string_view const> sequences2) const = 0;
+
+    /**
+     * @brief Computes the scores of the pairs prepared by a kernel of the same type.
+     *
+     * @throws std::invalid_argument if the pairs were prepared by a kernel of another type.
+     */
+    virtual void compute(prepared_bulk_base const & prepared_bulk, std::span<int32_t> scores) = 0;
+};
+
+//!\brief Casts the prepared pairs to the type of the kernel computing them.
+template <typename prepared_bulk_t>
+prepared_bulk_t const & prepared_bulk_cast(prepared_bulk_base const & prepared_bulk)
+{
+    auto const * typed_bulk = dynamic_cast<prepared_bulk_t const *>(&prepared_bulk);
+    if (typed_bulk == nullptr)
+        throw std::invalid_argument{"The pairs were prepared by an aligner with another engine or precision."};
+
+    return *typed_bulk;
+}
+
+/**
+ * @brief Invokes the callable with the built-in substitution matrix of the given name.
+ *
+ * @tparam score_t The score type of the substitution matrix.
+ * @param name The name of the substitution matrix.
+ * @param fn The callable invoked with the substitution matrix.
+ *
+ * @throws std::invalid_argument if the name does not refer to a built-in substitution matrix.
+ */
+template <typename score_t, typename fn_t>
+auto visit_substitution_matrix(std::string_view const name, fn_t && fn)
+{
+    if (name == "blosum62")
+        return fn(blosum62_standard<score_t>);
+    else if (name == "blosum62_extended")
+        return fn(blosum62_extended<score_t>);
+    else
+        throw std::invalid_argument{"Unknown substitution matrix: " + std::string{name}};
+}
+
+//!\brief Instantiates the global kernel for the given parameters; defined in kernel_global.cpp.
+std::unique_ptr<kernel_base> make_global_kernel(aligner_parameters const & parameters);
+//!\brief Instantiates the local kernel for the given parameters; defined in kernel_local.cpp.
+std::unique_ptr<kernel_base> make_local_kernel(aligner_parameters const & parameters);
+
+} // namespace runtime::detail
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,354 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the factory instantiating the precompiled kernels for a configured method.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/saturated_block_handler.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
+#include <pairwise_aligner/simd/simd_base.hpp>
+
+#include "kernel.hpp"
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime::detail {
+
+// ----------------------------------------------------------------------------
+// Kernels
+// ----------------------------------------------------------------------------
+
+//!\brief Wraps a configured aligner computing a single pair at a time.
+template <typename aligner_t>
+class kernel_one_to_one_single final : public kernel_base
+{
+    aligner_t _aligner;
+    decltype(std::declval<aligner_t const &>().make_workspace()) _workspace;
+
+public:
+    explicit kernel_one_to_one_single(aligner_t aligner) :
+        _aligner{std::move(aligner)},
+        _workspace{_aligner.make_workspace()}
+    {}
+
+    size_t bulk_size() const noexcept override
+    {
+        return 1;
+    }
+
+    void compute(std::span<std::string_view const> sequences1,
+                 std::span<std::string_view const> sequences2,
+                 std::span<int32_t> scores) override
+    {
+        assert(sequences1.size() == sequences2.size());
+        assert(sequences1.size() == scores.size());
+
+        for (size_t i = 0; i < sequences1.size(); ++i)
+            scores[i] = static_cast<int32_t>(_aligner.compute(sequences1[i], sequences2[i], _workspace).score());
+    }
+
+    std::unique_ptr<prepared_bulk_base> prepare(std::span<std::string_view const> sequences1,
+                                                std::span<std::string_view const> sequences2) const override
+    {
+        assert(sequences1.size() == sequences2.size());
+
+        // The scalar aligner transforms the symbols while computing, hence only the pairs are stored.
+        auto prepared_bulk = std::make_unique<prepared_pairs_t>();
+        prepared_bulk->sequences1.assign(sequences1.begin(), sequences1.end());
+        prepared_bulk->sequences2.assign(sequences2.begin(), sequences2.end());
+        return prepared_bulk;
+    }
+
+    void compute(prepared_bulk_base const & prepared_bulk, std::span<int32_t> scores) override
+    {
+        prepared_pairs_t const & pairs = prepared_bulk_cast<prepared_pairs_t>(prepared_bulk);
+        compute(pairs.sequences1, pairs.sequences2, scores);
+    }
+
+private:
+    struct prepared_pairs_t final : public prepared_bulk_base
+    {
+        std::vector<std::string_view> sequences1{};
+        std::vector<std::string_view> sequences2{};
+    };
+};
+
+//!\brief Wraps a configured aligner computing bulks of at most `bulk_size_v` independent pairs.
+template <typename aligner_t, size_t bulk_size_v>
+class kernel_one_to_one_bulk final : public kernel_base
+{
+    aligner_t _aligner;
+    decltype(std::declval<aligner_t const &>().make_workspace()) _workspace;
+
+public:
+    explicit kernel_one_to_one_bulk(aligner_t aligner) :
+        _aligner{std::move(aligner)},
+        _workspace{_aligner.make_workspace()}
+    {}
+
+    size_t bulk_size() const noexcept override
+    {
+        return bulk_size_v;
+    }
+
+    void compute(std::span<std::string_view const> sequences1,
+                 std::span<std::string_view const> sequences2,
+                 std::span<int32_t> scores) override
+    {
+        assert(sequences1.size() <= bulk_size_v);
+        assert(sequences1.size() == sequences2.size());
+        assert(sequences1.size() == scores.size());
+
+        _aligner.compute(sequences1, sequences2, _workspace, scores.begin());
+    }
+
+    std::unique_ptr<prepared_bulk_base> prepare(std::span<std::string_view const> sequences1,
+                                                std::span<std::string_view const> sequences2) const override
+    {
+        assert(sequences1.size() == sequences2.size());
+
+        auto prepared_bulk = std::make_unique<prepared_bulks_t>();
+        for (size_t offset = 0; offset < sequences1.size(); offset += bulk_size_v)
+        {
+            size_t const count = std::min(bulk_size_v, sequences1.size() - offset);
+            prepared_bulk->bulks.emplace_back(_aligner.make_sequence_batch1(sequences1.subspan(offset, count)),
+                                              _aligner.make_sequence_batch2(sequences2.subspan(offset, count)));
+        }
+        return prepared_bulk;
+    }
+
+    void compute(prepared_bulk_base const & prepared_bulk, std::span<int32_t> scores) override
+    {
+        size_t offset = 0;
+        for (auto const & [batch1, batch2] : prepared_bulk_cast<prepared_bulks_t>(prepared_bulk).bulks)
+        {
+            assert(offset + batch1.size() <= scores.size());
+            _aligner.compute(batch1, batch2, _workspace, scores.subspan(offset, batch1.size()).begin());
+            offset += batch1.size();
+        }
+    }
+
+private:
+    using sequence_bulk_t = std::span<std::string_view const>;
+    using batch1_t = decltype(std::declval<aligner_t const &>().make_sequence_batch1(std::declval<sequence_bulk_t>()));
+    using batch2_t = decltype(std::declval<aligner_t const &>().make_sequence_batch2(std::declval<sequence_bulk_t>()));
+
+    // The transposed and transformed sequences of every bulk.
+    struct prepared_bulks_t final : public prepared_bulk_base
+    {
+        std::vector<std::pair<batch1_t, batch2_t>> bulks{};
+    };
+};
+
+// Whether both views refer to the same sequence. Only the data pointer and the size are compared, such that the runs
+// are found in constant time per pair and equal but distinct sequences are not joined.
+inline bool is_same_sequence(std::string_view const lhs, std::string_view const rhs) noexcept
+{
+    return lhs.data() == rhs.data() && lhs.size() == rhs.size();
+}
+
+/**
+ * @brief Wraps a configured aligner computing one first sequence against a bulk of at most `bulk_size_v` second
+ *        sequences.
+ *
+ * Consecutive pairs viewing the same first sequence are computed together, such that arbitrary pairs can be passed
+ * but only runs of views of the same first sequence benefit from this kernel.
+ */
+template <typename aligner_t, size_t bulk_size_v>
+class kernel_one_to_many_bulk final : public kernel_base
+{
+    aligner_t _aligner;
+    decltype(std::declval<aligner_t const &>().make_workspace()) _workspace;
+
+public:
+    explicit kernel_one_to_many_bulk(aligner_t aligner) :
+        _aligner{std::move(aligner)},
+        _workspace{_aligner.make_workspace()}
+    {}
+
+    size_t bulk_size() const noexcept override
+    {
+        return bulk_size_v;
+    }
+
+    void compute(std::span<std::string_view const> sequences1,
+                 std::span<std::string_view const> sequences2,
+                 std::span<int32_t> scores) override
+    {
+        assert(sequences1.size() <= bulk_size_v);
+        assert(sequences1.size() == sequences2.size());
+        assert(sequences1.size() == scores.size());
+
+        for (size_t run_begin = 0, run_end = 0; run_begin < sequences1.size(); run_begin = run_end)
+        {
+            std::string_view const sequence1 = sequences1[run_begin];
+            for (run_end = run_begin + 1;
+                 run_end < sequences1.size() && is_same_sequence(sequences1[run_end], sequence1);
+                 ++run_end)
+            {}
+
+            size_t const count = run_end - run_begin;
+            _aligner.compute(sequence1,
+                             sequences2.subspan(run_begin, count),
+                             _workspace,
+                             scores.subspan(run_begin, count).begin());
+        }
+    }
+
+    std::unique_ptr<prepared_bulk_base> prepare(std::span<std::string_view const> sequences1,
+                                                std::span<std::string_view const> sequences2) const override
+    {
+        assert(sequences1.size() == sequences2.size());
+
+        // Only the second sequences are transposed; the runs are split at the same positions as in compute.
+        auto prepared_bulk = std::make_unique<prepared_runs_t>();
+        for (size_t offset = 0; offset < sequences1.size(); offset += bulk_size_v)
+        {
+            size_t const bulk_end = std::min(offset + bulk_size_v, sequences1.size());
+            for (size_t run_begin = offset, run_end = offset; run_begin < bulk_end; run_begin = run_end)
+            {
+                std::string_view const sequence1 = sequences1[run_begin];
+                for (run_end = run_begin + 1;
+                     run_end < bulk_end && is_same_sequence(sequences1[run_end], sequence1);
+                     ++run_end)
+                {}
+
+                sequence_bulk_t const run_sequences2 = sequences2.subspan(run_begin, run_end - run_begin);
+                prepared_bulk->runs.emplace_back(sequence1, _aligner.make_sequence_batch2(run_sequences2));
+            }
+        }
+        return prepared_bulk;
+    }
+
+    void compute(prepared_bulk_base const & prepared_bulk, std::span<int32_t> scores) override
+    {
+        size_t offset = 0;
+        for (auto const & [sequence1, batch2] : prepared_bulk_cast<prepared_runs_t>(prepared_bulk).runs)
+        {
+            assert(offset + batch2.size() <= scores.size());
+            _aligner.compute(sequence1, batch2, _workspace, scores.subspan(offset, batch2.size()).begin());
+            offset += batch2.size();
+        }
+    }
+
+private:
+    using sequence_bulk_t = std::span<std::string_view const>;
+    using batch2_t = decltype(std::declval<aligner_t const &>().make_sequence_batch2(std::declval<sequence_bulk_t>()));
+
+    // The first sequence and the transposed second sequences of every run.
+    struct prepared_runs_t final : public prepared_bulk_base
+    {
+        std::vector<std::pair<std::string_view, batch2_t>> runs{};
+    };
+};
+
+template <template <typename, size_t> typename kernel_t, size_t bulk_size_v, typename aligner_t>
+std::unique_ptr<kernel_base> make_kernel(aligner_t aligner)
+{
+    return std::make_unique<kernel_t<aligner_t, bulk_size_v>>(std::move(aligner));
+}
+
+// ----------------------------------------------------------------------------
+// Factory
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Instantiates the kernels of all engines and precisions for the given method.
+ *
+ * @param make_method A callable returning the configured method.
+ * @param parameters The runtime parameters selecting the kernel.
+ *
+ * The method is passed as a factory, such that every configuration chain is built from temporaries only and the
+ * configured aligner does not refer to any local state of this function.
+ * The scalar engine always computes with 32-bit scores.
+ */
+template <typename method_factory_t>
+std::unique_ptr<kernel_base> make_kernel_for(method_factory_t && make_method, aligner_parameters const & parameters)
+{
+    std::string_view const matrix_name = parameters.substitution_matrix;
+
+    switch (parameters.engine)
+    {
+        case alignment_engine::scalar:
+        {
+            return visit_substitution_matrix<int32_t>(matrix_name, [&] (auto const & matrix) {
+                auto aligner = cfg::configure_aligner(cfg::score_model_matrix(make_method(), matrix));
+                using kernel_t = kernel_one_to_one_single<decltype(aligner)>;
+                return std::unique_ptr<kernel_base>{std::make_unique<kernel_t>(std::move(aligner))};
+            });
+        }
+        case alignment_engine::simd_NxN:
+        {
+            switch (parameters.precision)
+            {
+                case score_precision::int8_saturated:
+                    return visit_substitution_matrix<int32_t>(matrix_name, [&] (auto const & matrix)
+                        -> std::unique_ptr<kernel_base>
+                    {
+                        using matrix_t = std::remove_cvref_t<decltype(matrix)>;
+                        if constexpr (cfg::detail::saturated_block_handler::is_NxN_alphabet_supported(
+                                        std::tuple_size_v<matrix_t>))
+                            return make_kernel<kernel_one_to_one_bulk, simd_score<int8_t>::size_v>(
+                                cfg::configure_aligner(cfg::score_model_matrix_simd_saturated_NxN(make_method(),
+                                                                                                  matrix)));
+                        else
+                            throw std::invalid_argument{"The saturated simd_NxN engine does not support the "
+                                                        "substitution matrix on this target."};
+                    });
+                case score_precision::int16:
+                    return visit_substitution_matrix<int16_t>(matrix_name, [&] (auto const & matrix) {
+                        return make_kernel<kernel_one_to_one_bulk, simd_score<int16_t>::size_v>(
+                            cfg::configure_aligner(cfg::score_model_matrix_simd_NxN(make_method(), matrix)));
+                    });
+                case score_precision::int32:
+                    return visit_substitution_matrix<int32_t>(matrix_name, [&] (auto const & matrix) {
+                        return make_kernel<kernel_one_to_one_bulk, simd_score<int32_t>::size_v>(
+                            cfg::configure_aligner(cfg::score_model_matrix_simd_NxN(make_method(), matrix)));
+                    });
+            }
+            break;
+        }
+        case alignment_engine::simd_1xN:
+        {
+            // The profiled scores of the 1xN models are 8-bit, such that only the saturated model can widen them.
+            if (parameters.precision != score_precision::int8_saturated)
+                throw std::invalid_argument{"The simd_1xN engine only supports the int8_saturated precision."};
+
+            return visit_substitution_matrix<int32_t>(matrix_name, [&] (auto const & matrix) {
+                return make_kernel<kernel_one_to_many_bulk, simd_score<int8_t>::size_v>(
+                    cfg::configure_aligner(cfg::score_model_matrix_simd_saturated_1xN(make_method(), matrix)));
+            });
+        }
+    }
+
+    throw std::invalid_argument{"Unknown engine or score precision."};
+}
+
+} // namespace runtime::detail
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,30 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Instantiates the precompiled local kernels of the seqan::pairwise_aligner::runtime::aligner.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#include <pairwise_aligner/configuration/method_local.hpp>
+
+#include "kernel_factory.hpp"
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime::detail {
+
+std::unique_ptr<kernel_base> make_local_kernel(aligner_parameters const & parameters)
+{
+    return make_kernel_for([&] () {
+        return cfg::method_local(cfg::gap_model_affine(parameters.gap_open_score, parameters.gap_extension_score));
+    }, parameters);
+}
+
+} // namespace runtime::detail
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
@@ -0,0 +1,205 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Implements seqan::pairwise_aligner::runtime::plan_aligner.
+ * \author Rene Rahn <rahn AT molgen.mpg.de>
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include <pairwise_aligner/configuration/saturated_block_handler.hpp>
+#include <pairwise_aligner/runtime/planner.hpp>
+#include <pairwise_aligner/simd/simd_base.hpp>
+
+#include "kernel.hpp"
+
+namespace seqan::pairwise_aligner {
+inline namespace v1 {
+namespace runtime {
+
+namespace detail {
+
+// The smallest saturated block size for which the rescaling between the blocks is amortised.
+inline constexpr size_t minimal_saturated_block_size = 8;
+// The simd engines pay off once at least this fraction of the lanes is occupied.
+inline constexpr size_t minimal_lane_occupancy_divisor = 8;
+// The relative standard deviation of the lengths above which the pairs are grouped by length.
+inline constexpr double group_by_length_threshold = 0.2;
+
+inline size_t lane_count(alignment_engine const engine, score_precision const precision) noexcept
+{
+    switch (engine)
+    {
+        case alignment_engine::scalar: return 1;
+        case alignment_engine::simd_1xN: return simd_score<int8_t>::size_v;
+        case alignment_engine::simd_NxN:
+        {
+            switch (precision)
+            {
+                case score_precision::int8_saturated: return simd_score<int8_t>::size_v;
+                case score_precision::int16: return simd_score<int16_t>::size_v;
+                case score_precision::int32: return simd_score<int32_t>::size_v;
+            }
+        }
+    }
+    return 1;
+}
+
+inline std::string_view to_string(alignment_engine const engine) noexcept
+{
+    switch (engine)
+    {
+        case alignment_engine::scalar: return "scalar";
+        case alignment_engine::simd_NxN: return "simd_NxN";
+        case alignment_engine::simd_1xN: return "simd_1xN";
+    }
+    return "unknown";
+}
+
+inline std::string_view to_string(score_precision const precision) noexcept
+{
+    switch (precision)
+    {
+        case score_precision::int8_saturated: return "int8_saturated";
+        case score_precision::int16: return "int16";
+        case score_precision::int32: return "int32";
+    }
+    return "unknown";
+}
+
+} // namespace detail
+
+batch_statistics collect_batch_statistics(std::span<std::string_view const> sequences1,
+                                          std::span<std::string_view const> sequences2)
+{
+    if (sequences1.size() != sequences2.size())
+        throw std::invalid_argument{"The number of first and second sequences must be equal."};
+
+    batch_statistics statistics{};
+    statistics.pair_count = sequences1.size();
+
+    if (sequences1.empty())
+        return statistics;
+
+    statistics.min_length = std::numeric_limits<size_t>::max();
+    statistics.one_vs_many = true;
+
+    double sum{};
+    double square_sum{};
+    auto account = [&] (std::string_view const sequence) {
+        statistics.min_length = std::min(statistics.min_length, sequence.size());
+        statistics.max_length = std::max(statistics.max_length, sequence.size());
+        sum += sequence.size();
+        square_sum += static_cast<double>(sequence.size()) * sequence.size();
+    };
+
+    for (size_t i = 0; i < sequences1.size(); ++i)
+    {
+        account(sequences1[i]);
+        account(sequences2[i]);
+        // The one-to-many kernel only joins views of the same sequence; see kernel_one_to_many_bulk.
+        statistics.one_vs_many &= (sequences1[i].data() == sequences1.front().data() &&
+                                   sequences1[i].size() == sequences1.front().size());
+    }
+
+    double const count = 2.0 * sequences1.size();
+    statistics.mean_length = sum / count;
+    statistics.length_deviation = std::sqrt(std::max(0.0, square_sum / count -
+                                                          statistics.mean_length * statistics.mean_length));
+    return statistics;
+}
+
+aligner_parameters plan_aligner(aligner_parameters parameters,
+                                batch_statistics const & statistics,
+                                std::ostream * log)
+{
+    auto [min_score, max_score, symbol_count] = detail::visit_substitution_matrix<int32_t>(
+                                                    parameters.substitution_matrix,
+                                                    [] (auto const & matrix) {
+        int32_t min_score = std::numeric_limits<int32_t>::max();
+        int32_t max_score = std::numeric_limits<int32_t>::lowest();
+        for (auto const & [symbol, row] : matrix)
+        {
+            auto [row_min, row_max] = std::ranges::minmax(row);
+            min_score = std::min<int32_t>(min_score, row_min);
+            max_score = std::max<int32_t>(max_score, row_max);
+        }
+        return std::tuple{min_score, max_score, matrix.size()};
+    });
+
+    // Select the precision.
+    int32_t const gap_open = std::abs(parameters.gap_open_score);
+    int32_t const gap_extension = std::abs(parameters.gap_extension_score);
+    bool const is_saturated_viable =
+        cfg::detail::saturated_block_handler::is_viable_block_size(max_score,
+                                                                   min_score,
+                                                                   gap_open,
+                                                                   gap_extension,
+                                                                   detail::minimal_saturated_block_size);
+
+    int64_t const max_cell_score = std::max({std::abs(max_score), std::abs(min_score), gap_extension});
+    int64_t const score_bound = 2 * (static_cast<int64_t>(statistics.max_length) * max_cell_score + gap_open);
+
+    score_precision const wide_precision = (score_bound <= std::numeric_limits<int16_t>::max())
+                                         ? score_precision::int16
+                                         : score_precision::int32;
+    parameters.precision = is_saturated_viable ? score_precision::int8_saturated : wide_precision;
+
+    // Select the engine.
+    // The simd_1xN engine only computes saturated 8-bit scores.
+    parameters.engine = (statistics.one_vs_many && statistics.pair_count > 1 &&
+                         parameters.precision == score_precision::int8_saturated) ? alignment_engine::simd_1xN
+                                                                                  : alignment_engine::simd_NxN;
+
+    // Without gathers the saturated NxN kernel can not address the scores of large alphabets.
+    if (parameters.engine == alignment_engine::simd_NxN &&
+        parameters.precision == score_precision::int8_saturated &&
+        !cfg::detail::saturated_block_handler::is_NxN_alphabet_supported(symbol_count))
+        parameters.precision = wide_precision;
+
+    if (statistics.pair_count * detail::minimal_lane_occupancy_divisor <
+        detail::lane_count(parameters.engine, parameters.precision))
+        parameters.engine = alignment_engine::scalar;
+
+    // Select the batching.
+    double const relative_length_deviation = (statistics.mean_length > 0)
+                                           ? statistics.length_deviation / statistics.mean_length
+                                           : 0.0;
+    parameters.group_by_length = parameters.engine == alignment_engine::simd_NxN &&
+                                 relative_length_deviation > detail::group_by_length_threshold;
+
+    if (log != nullptr)
+    {
+        *log << "[planner] pairs=" << statistics.pair_count
+             << " lengths=[" << statistics.min_length << ", " << statistics.max_length << "]"
+             << " mean=" << statistics.mean_length
+             << " deviation=" << statistics.length_deviation
+             << " one_vs_many=" << statistics.one_vs_many
+             << " scores=[" << min_score << ", " << max_score << "]"
+             << " saturated_viable=" << is_saturated_viable
+             << " -> engine=" << detail::to_string(parameters.engine)
+             << " precision=" << detail::to_string(parameters.precision)
+             << " lanes=" << detail::lane_count(parameters.engine, parameters.precision)
+             << " group_by_length=" << parameters.group_by_length << '\n';
+    }
+
+    return parameters;
+}
+
+} // namespace runtime
+} // inline namespace v1
+} // namespace seqan::pairwise_aligner
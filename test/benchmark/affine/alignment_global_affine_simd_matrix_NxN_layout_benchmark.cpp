@@ -0,0 +1,83 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Compares the array-of-structures with the structure-of-arrays layout of the dp vectors for the fixed and the
+// saturated simd engines.
+
+#include <seqan3/alphabet/aminoacid/aa20.hpp>
+#include <seqan3/alignment/configuration/align_config_method.hpp>
+#include <seqan3/core/configuration/configuration.hpp>
+
+#include <pairwise_aligner/configuration/dp_vector_layout.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
+
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+#include "alignment_benchmark_fixture.hpp"
+
+namespace aligner::benchmark::layout {
+namespace pa = seqan::pairwise_aligner;
+
+using score_t = int16_t;
+
+DEFINE_BENCHMARK_VALUES(fixed_aos,
+    .configurator = pa::cfg::gap_model_affine(pa::cfg::score_model_matrix_simd_NxN(pa::blosum62_standard<score_t>,
+                                                                                   pa::cfg::array_of_structures{}),
+                                              -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<score_t>::size_v
+)
+
+DEFINE_BENCHMARK_VALUES(fixed_soa,
+    .configurator = pa::cfg::gap_model_affine(pa::cfg::score_model_matrix_simd_NxN(pa::blosum62_standard<score_t>,
+                                                                                   pa::cfg::structure_of_arrays{}),
+                                              -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<score_t>::size_v
+)
+
+DEFINE_BENCHMARK_VALUES(saturated_aos,
+    .configurator = pa::cfg::gap_model_affine(
+                        pa::cfg::score_model_matrix_simd_saturated_NxN(pa::blosum62_standard<score_t>,
+                                                                       pa::cfg::array_of_structures{}),
+                        -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<int8_t>::size_v
+)
+
+DEFINE_BENCHMARK_VALUES(saturated_soa,
+    .configurator = pa::cfg::gap_model_affine(
+                        pa::cfg::score_model_matrix_simd_saturated_NxN(pa::blosum62_standard<score_t>,
+                                                                       pa::cfg::structure_of_arrays{}),
+                        -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<int8_t>::size_v
+)
+
+ALIGNER_BENCHMARK(layout, fixed_aos)
+ALIGNER_BENCHMARK(layout, fixed_soa)
+ALIGNER_BENCHMARK(layout, saturated_aos)
+ALIGNER_BENCHMARK(layout, saturated_soa)
+
+} // namespace aligner::benchmark::layout
+
+BENCHMARK_MAIN();
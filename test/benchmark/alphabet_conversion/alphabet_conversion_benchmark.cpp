@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <random>
 #include <ranges>
+#include <string>
 #include <string_view>
 #include <tuple>
 
@@ -23,6 +24,7 @@
 #include <pairwise_aligner/simd/simd_score_type.hpp>
 #include <pairwise_aligner/alphabet_conversion/alphabet_rank_map_scalar.hpp>
 #include <pairwise_aligner/alphabet_conversion/alphabet_rank_map_simd.hpp>
+#include <pairwise_aligner/sequence/packed_dna_sequence.hpp>
 
 inline constexpr size_t sequence_count = seqan::pairwise_aligner::detail::max_simd_size;
 using rank_t = int8_t;
@@ -146,6 +148,75 @@ void alphabet_conversion_seqan3(benchmark::State& state, args_t&&... args) {
     state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(state.range(0)) * int64_t(sequence_count));
 }
 
+// Measures the transposition of the sequences together with the rank conversion, as done by the bulk aligners.
+template <typename ...args_t>
+void alphabet_conversion_simd_transpose(benchmark::State& state, args_t&&... args) {
+    std::string_view symbol_list = get<0>(std::make_tuple(std::move(args)...));
+    size_t const sequence_size = state.range(0);
+
+    // Generate sequences over the symbols of the alphabet.
+    auto sequence_collection = generate(sequence_size, symbol_list);
+    std::ranges::for_each(sequence_collection, [&] (std::string & sequence) {
+        std::ranges::for_each(sequence, [&] (char & symbol) { symbol = symbol_list[symbol]; });
+    });
+
+    using simd_t = seqan::pairwise_aligner::simd_score<int8_t>;
+    using native_simd_t = typename simd_t::native_simd_type;
+
+    std::vector<simd_t, seqan3::aligned_allocator<simd_t, alignof(simd_t)>> sequences{};
+    sequences.reserve(sequence_size);
+
+    // Initialise rank map.
+    seqan::pairwise_aligner::alphabet_rank_map_simd<simd_t> rank_map{symbol_list};
+
+    for (auto _ : state) {
+        sequences.clear();
+        for (auto && simd_vector_chunk : sequence_collection | seqan3::views::to_simd<native_simd_t>()) {
+            for (auto && simd_vector : simd_vector_chunk) {
+                sequences.emplace_back(std::move(simd_vector));
+                sequences.back() = rank_map[sequences.back()];
+            }
+        }
+        benchmark::DoNotOptimize(sequences.data());
+    }
+
+    // Output bytes per second.
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(state.range(0)) * int64_t(sequence_count));
+}
+
+// Measures the decoding of 2-bit packed sequences fused with the transposition and the rank conversion.
+template <typename ...args_t>
+void alphabet_conversion_simd_packed(benchmark::State& state, args_t&&... args) {
+    std::string_view symbol_list = get<0>(std::make_tuple(std::move(args)...));
+    size_t const sequence_size = state.range(0);
+
+    // Generate sequences over the symbols of the alphabet and pack them.
+    auto sequence_collection = generate(sequence_size, symbol_list);
+    std::vector<seqan::pairwise_aligner::packed_dna_sequence> packed_collection{};
+    std::ranges::for_each(sequence_collection, [&] (std::string const & sequence) {
+        packed_collection.emplace_back(sequence | std::views::transform([&] (char symbol) {
+            return symbol_list[symbol];
+        }));
+    });
+
+    using simd_t = seqan::pairwise_aligner::simd_score<int8_t>;
+
+    std::vector<simd_t, seqan3::aligned_allocator<simd_t, alignof(simd_t)>> sequences{};
+    sequences.reserve(sequence_size);
+
+    // Initialise rank map.
+    seqan::pairwise_aligner::alphabet_rank_map_simd<simd_t> rank_map{symbol_list};
+
+    for (auto _ : state) {
+        seqan::pairwise_aligner::detail::unpack_and_transpose<simd_t>(packed_collection, 'N', sequences);
+        std::ranges::for_each(sequences, [&] (simd_t & symbol) { symbol = rank_map[symbol]; });
+        benchmark::DoNotOptimize(sequences.data());
+    }
+
+    // Output bytes per second.
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(state.range(0)) * int64_t(sequence_count));
+}
+
 
 inline constexpr std::string_view dna5_symbols{"ACGTN"};
 inline constexpr std::string_view aa20_symbols{"ACDEFGHIKLMNPQRSTVWY"};
@@ -165,3 +236,6 @@ BENCHMARK_CAPTURE(alphabet_conversion_simd, printable_char, printable_symbols)->
 BENCHMARK_CAPTURE(alphabet_conversion_seqan3, dna5, dna5_symbols, seqan3::dna5{})->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
 BENCHMARK_CAPTURE(alphabet_conversion_seqan3, aa20, aa20_symbols, seqan3::aa20{})->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
 BENCHMARK_CAPTURE(alphabet_conversion_seqan3, aa27, aa27_symbols, seqan3::aa27{})->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+
+BENCHMARK_CAPTURE(alphabet_conversion_simd_transpose, dna5, dna5_symbols)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
+BENCHMARK_CAPTURE(alphabet_conversion_simd_packed, dna5, dna5_symbols)->Arg(100)->Arg(250)->Arg(500)->Arg(1000);
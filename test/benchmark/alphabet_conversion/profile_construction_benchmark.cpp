@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <ranges>
+#include <vector>
+
+#include <seqan3/utility/container/aligned_allocator.hpp>
+
+#include <pairwise_aligner/simd/simd_score_type.hpp>
+#include <pairwise_aligner/score_model/score_model_matrix_simd_1xN.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+using simd_score_t = pa::simd_score<int8_t>;
+
+template <size_t dimension>
+using score_model_t = pa::score_model_matrix_simd_1xN<simd_score_t, dimension>;
+
+template <size_t dimension>
+using simd_index_t = typename score_model_t<dimension>::index_type;
+
+template <typename simd_t>
+using simd_buffer_t = std::vector<simd_t, seqan3::aligned_allocator<simd_t, alignof(simd_t)>>;
+
+template <size_t dimension>
+inline auto generate_matrix()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> score_distribution(-4, 11);
+
+    std::array<std::array<int8_t, dimension>, dimension> matrix{};
+    for (size_t row = 0; row < dimension; ++row) {
+        for (size_t column = row; column < dimension; ++column) {
+            matrix[row][column] = score_distribution(gen);
+            matrix[column][row] = matrix[row][column];
+        }
+    }
+    return matrix;
+}
+
+template <size_t dimension>
+inline auto generate_ranks(size_t const sequence_size)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> rank_distribution(0, dimension - 1);
+
+    simd_buffer_t<simd_index_t<dimension>> ranks{};
+    ranks.resize(sequence_size);
+    std::ranges::for_each(ranks, [&] (simd_index_t<dimension> & rank) {
+        for (size_t i = 0; i < simd_index_t<dimension>::size_v; ++i)
+            rank[i] = rank_distribution(gen);
+    });
+    return ranks;
+}
+
+// Builds the interleaved profile of the score model, which selects the scores of all symbols per position at once.
+template <size_t dimension>
+void profile_construction(benchmark::State& state) {
+    size_t const sequence_size = state.range(0);
+
+    score_model_t<dimension> score_model{generate_matrix<dimension>()};
+    auto ranks = generate_ranks<dimension>(sequence_size);
+
+    for (auto _ : state) {
+        auto profile = score_model.initialise_profile(ranks);
+        benchmark::DoNotOptimize(profile[0][0]);
+    }
+
+    // Output number of profile entries per second.
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sequence_size) * int64_t(dimension));
+}
+
+// Builds the same profile layout with scalar lookups.
+template <size_t dimension>
+void profile_construction_scalar(benchmark::State& state) {
+    size_t const sequence_size = state.range(0);
+
+    auto matrix = generate_matrix<dimension>();
+    auto ranks = generate_ranks<dimension>(sequence_size);
+
+    simd_buffer_t<simd_index_t<dimension>> profile{};
+    profile.resize(sequence_size * dimension);
+
+    for (auto _ : state) {
+        for (size_t rank = 0; rank < dimension; ++rank)
+            for (size_t i = 0; i < sequence_size; ++i)
+                for (size_t k = 0; k < simd_index_t<dimension>::size_v; ++k)
+                    profile[rank * sequence_size + i][k] = matrix[rank][ranks[i][k]];
+
+        benchmark::DoNotOptimize(profile.data());
+    }
+
+    // Output number of profile entries per second.
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sequence_size) * int64_t(dimension));
+}
+
+// dna5 + padding, aa20 + padding, aa27; a short target and a 30 kbp target.
+BENCHMARK_TEMPLATE(profile_construction, 6)->Arg(1000)->Arg(30000);
+BENCHMARK_TEMPLATE(profile_construction, 21)->Arg(1000)->Arg(30000);
+BENCHMARK_TEMPLATE(profile_construction, 27)->Arg(1000)->Arg(30000);
+
+BENCHMARK_TEMPLATE(profile_construction_scalar, 6)->Arg(1000)->Arg(30000);
+BENCHMARK_TEMPLATE(profile_construction_scalar, 21)->Arg(1000)->Arg(30000);
+BENCHMARK_TEMPLATE(profile_construction_scalar, 27)->Arg(1000)->Arg(30000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,165 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <ranges>
+#include <vector>
+
+#include <seqan3/utility/container/aligned_allocator.hpp>
+
+#include <pairwise_aligner/simd/simd_score_type.hpp>
+#include <pairwise_aligner/simd/simd_gather_map.hpp>
+#include <pairwise_aligner/simd/simd_index_map.hpp>
+#include <pairwise_aligner/score_model/score_model_matrix_simd_NxN.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+using simd_score_t = pa::simd_score<int8_t>;
+using simd_rank_t = pa::detail::make_unsigned_t<simd_score_t>;
+
+template <typename simd_t>
+using simd_buffer_t = std::vector<simd_t, seqan3::aligned_allocator<simd_t, alignof(simd_t)>>;
+
+template <size_t dimension>
+inline auto generate_matrix()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> score_distribution(-4, 11);
+
+    std::array<std::array<int8_t, dimension>, dimension> matrix{};
+    for (size_t row = 0; row < dimension; ++row) {
+        for (size_t column = row; column < dimension; ++column) {
+            matrix[row][column] = score_distribution(gen);
+            matrix[column][row] = matrix[row][column];
+        }
+    }
+    return matrix;
+}
+
+template <size_t dimension>
+inline auto generate_ranks(size_t const sequence_size)
+{
+    std::random_device rd;  //Will be used to obtain a seed for the random number engine
+    std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
+    std::uniform_int_distribution<int> rank_distribution(0, dimension - 1);
+
+    simd_buffer_t<simd_rank_t> ranks{};
+    ranks.resize(sequence_size);
+    std::ranges::for_each(ranks, [&] (simd_rank_t & rank) {
+        for (size_t i = 0; i < simd_rank_t::size_v; ++i)
+            rank[i] = rank_distribution(gen);
+    });
+    return ranks;
+}
+
+// Selects the scores from the triangular matrix using the offsets as done by score_model_matrix_simd_NxN.
+template <size_t dimension>
+void substitution_select(benchmark::State& state) {
+    size_t const sequence_size = state.range(0);
+    constexpr size_t matrix_size = (dimension * (dimension + 1)) / 2;
+
+    auto matrix = generate_matrix<dimension>();
+    pa::score_model_matrix_simd_NxN<simd_score_t, simd_rank_t, dimension> score_model{matrix};
+    pa::offset_transform offset_fn{dimension, matrix_size};
+
+    auto column_ranks = generate_ranks<dimension>(sequence_size);
+    auto row_ranks = generate_ranks<dimension>(sequence_size);
+    auto transform = [&] (auto const & ranks) {
+        std::vector<std::pair<simd_rank_t, simd_rank_t>> offsets{};
+        std::ranges::transform(ranks, std::back_inserter(offsets), offset_fn);
+        return offsets;
+    };
+    auto column_offsets = transform(column_ranks);
+    auto row_offsets = transform(row_ranks);
+
+    simd_buffer_t<simd_score_t> scores{};
+    scores.resize(sequence_size);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < sequence_size; ++i)
+            scores[i] = score_model.score(scores[i], column_offsets[i], row_offsets[i]);
+
+        benchmark::DoNotOptimize(scores.data());
+    }
+
+    // Output number of looked up scores per second.
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sequence_size) * int64_t(simd_score_t::size_v));
+}
+
+// Gathers the scores from the full matrix using the ranks.
+template <size_t dimension>
+void substitution_gather(benchmark::State& state) {
+    size_t const sequence_size = state.range(0);
+
+    pa::simd_gather_map<int8_t, uint8_t, dimension> map{generate_matrix<dimension>()};
+
+    auto column_ranks = generate_ranks<dimension>(sequence_size);
+    auto row_ranks = generate_ranks<dimension>(sequence_size);
+
+    simd_buffer_t<simd_score_t> scores{};
+    scores.resize(sequence_size);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < sequence_size; ++i)
+            scores[i] += map(row_ranks[i], column_ranks[i]);
+
+        benchmark::DoNotOptimize(scores.data());
+    }
+
+    // Output number of looked up scores per second.
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sequence_size) * int64_t(simd_score_t::size_v));
+}
+
+// Looks up the scores one by one.
+template <size_t dimension>
+void substitution_scalar(benchmark::State& state) {
+    size_t const sequence_size = state.range(0);
+
+    auto matrix = generate_matrix<dimension>();
+    auto column_ranks = generate_ranks<dimension>(sequence_size);
+    auto row_ranks = generate_ranks<dimension>(sequence_size);
+
+    simd_buffer_t<simd_score_t> scores{};
+    scores.resize(sequence_size);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < sequence_size; ++i)
+            for (size_t k = 0; k < simd_score_t::size_v; ++k)
+                scores[i][k] += matrix[row_ranks[i][k]][column_ranks[i][k]];
+
+        benchmark::DoNotOptimize(scores.data());
+    }
+
+    // Output number of looked up scores per second.
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sequence_size) * int64_t(simd_score_t::size_v));
+}
+
+// dna5 + padding, aa20 + padding, aa27 - 6 (largest triangular matrix addressable with 8-bit offsets)
+BENCHMARK_TEMPLATE(substitution_select, 6)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_select, 21)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_select, 22)->Arg(1000);
+
+BENCHMARK_TEMPLATE(substitution_gather, 6)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_gather, 21)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_gather, 22)->Arg(1000);
+// codons + padding, structural alphabets, full byte range
+BENCHMARK_TEMPLATE(substitution_gather, 65)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_gather, 128)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_gather, 256)->Arg(1000);
+
+BENCHMARK_TEMPLATE(substitution_scalar, 6)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_scalar, 21)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_scalar, 22)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_scalar, 65)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_scalar, 128)->Arg(1000);
+BENCHMARK_TEMPLATE(substitution_scalar, 256)->Arg(1000);
+
+BENCHMARK_MAIN();
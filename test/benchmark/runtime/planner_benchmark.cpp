@@ -0,0 +1,228 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Checks the choices of the planner against an exhaustive sweep over all engines and precisions.
+// For every workload all kernels are benchmarked, followed by the kernel selected by the planner.
+// After all benchmarks have run, a summary compares the planned kernel with the fastest kernel of the sweep.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/runtime/aligner.hpp>
+#include <pairwise_aligner/runtime/planner.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+namespace rt = seqan::pairwise_aligner::runtime;
+
+struct workload
+{
+    std::string name;
+    size_t pair_count;
+    size_t min_length;
+    size_t max_length;
+    bool one_vs_many{false};
+    int32_t gap_open_score{-10};
+    int32_t gap_extension_score{-1};
+
+    std::string query{};
+    std::vector<std::string> sequences1{};
+    std::vector<std::string> sequences2{};
+
+    void generate()
+    {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<size_t> size_distribution{min_length, max_length};
+        std::uniform_int_distribution<size_t> symbol_distribution{0, pa::blosum62_standard<int32_t>.size() - 1};
+
+        auto generate_sequence = [&] () {
+            std::string sequence(size_distribution(random_engine), ' ');
+            std::ranges::generate(sequence, [&] () {
+                return pa::blosum62_standard<int32_t>[symbol_distribution(random_engine)].first;
+            });
+            return sequence;
+        };
+
+        query = generate_sequence();
+        for (size_t i = 0; i < pair_count; ++i)
+        {
+            if (!one_vs_many)
+                sequences1.push_back(generate_sequence());
+            sequences2.push_back(generate_sequence());
+        }
+    }
+
+    // The first sequences of a one-vs-many workload view the same query, such that they are computed together.
+    std::vector<std::string_view> first_sequences() const
+    {
+        if (one_vs_many)
+            return std::vector<std::string_view>(pair_count, query);
+
+        return std::vector<std::string_view>(sequences1.begin(), sequences1.end());
+    }
+
+    rt::aligner_parameters parameters() const
+    {
+        rt::aligner_parameters parameters{};
+        parameters.gap_open_score = gap_open_score;
+        parameters.gap_extension_score = gap_extension_score;
+        return parameters;
+    }
+};
+
+std::string to_string(rt::alignment_engine const engine)
+{
+    switch (engine)
+    {
+        case rt::alignment_engine::scalar: return "scalar";
+        case rt::alignment_engine::simd_NxN: return "simd_NxN";
+        case rt::alignment_engine::simd_1xN: return "simd_1xN";
+    }
+    return "unknown";
+}
+
+std::string to_string(rt::score_precision const precision)
+{
+    switch (precision)
+    {
+        case rt::score_precision::int8_saturated: return "int8_saturated";
+        case rt::score_precision::int16: return "int16";
+        case rt::score_precision::int32: return "int32";
+    }
+    return "unknown";
+}
+
+void run(::benchmark::State & state, workload const & load, rt::aligner_parameters const & parameters)
+{
+    std::vector<std::string_view> sequences1 = load.first_sequences();
+    std::vector<std::string_view> sequences2(load.sequences2.begin(), load.sequences2.end());
+    std::vector<int32_t> scores(sequences1.size());
+
+    rt::aligner aligner{parameters};
+    for (auto _ : state)
+    {
+        aligner.compute(sequences1, sequences2, scores);
+        ::benchmark::DoNotOptimize(scores.data());
+    }
+
+    double cells{};
+    for (size_t i = 0; i < sequences1.size(); ++i)
+        cells += static_cast<double>(sequences1[i].size()) * sequences2[i].size();
+
+    state.counters["lanes"] = aligner.bulk_size();
+    state.counters["CUPS"] = ::benchmark::Counter(cells, ::benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Collects the CUPS of all runs and prints the comparison between the planned and the fastest kernel.
+class planner_reporter : public ::benchmark::ConsoleReporter
+{
+    std::map<std::string, std::map<std::string, double>> _cups{};
+
+public:
+    void ReportRuns(std::vector<Run> const & runs) override
+    {
+        ::benchmark::ConsoleReporter::ReportRuns(runs);
+
+        for (Run const & run : runs)
+        {
+            std::string const name = run.benchmark_name();
+            size_t const separator = name.find('/');
+            auto counter = run.counters.find("CUPS");
+            if (separator != std::string::npos && counter != run.counters.end())
+                _cups[name.substr(0, separator)][name.substr(separator + 1)] = counter->second.value;
+        }
+    }
+
+    void print_summary(std::ostream & stream) const
+    {
+        stream << "\nworkload                  fastest                        planned/fastest\n";
+        for (auto const & [load_name, kernels] : _cups)
+        {
+            auto planned = kernels.find("planned");
+            if (planned == kernels.end())
+                continue;
+
+            std::string fastest_name{};
+            double fastest_cups{};
+            for (auto const & [kernel_name, cups] : kernels)
+            {
+                if (kernel_name != "planned" && cups > fastest_cups)
+                {
+                    fastest_name = kernel_name;
+                    fastest_cups = cups;
+                }
+            }
+
+            stream << std::left << std::setw(26) << load_name << std::setw(31) << fastest_name
+                   << std::fixed << std::setprecision(2) << planned->second / fastest_cups << '\n';
+        }
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    std::vector<workload> workloads{
+        {.name = "short_uniform", .pair_count = 2048, .min_length = 100, .max_length = 100},
+        {.name = "long_uniform", .pair_count = 256, .min_length = 1000, .max_length = 1000},
+        {.name = "variable", .pair_count = 1024, .min_length = 50, .max_length = 1000},
+        {.name = "one_vs_many", .pair_count = 1024, .min_length = 200, .max_length = 400, .one_vs_many = true},
+        {.name = "few_pairs", .pair_count = 3, .min_length = 500, .max_length = 500},
+        {.name = "large_gap_scores", .pair_count = 512, .min_length = 200, .max_length = 200,
+         .gap_open_score = -60, .gap_extension_score = -12},
+    };
+
+    for (workload & load : workloads)
+        load.generate();
+
+    for (workload const & load : workloads)
+    {
+        for (auto engine : {rt::alignment_engine::scalar,
+                            rt::alignment_engine::simd_NxN,
+                            rt::alignment_engine::simd_1xN})
+        {
+            for (auto precision : {rt::score_precision::int8_saturated,
+                                   rt::score_precision::int16,
+                                   rt::score_precision::int32})
+            {
+                // The scalar engine ignores the precision.
+                if (engine == rt::alignment_engine::scalar && precision != rt::score_precision::int32)
+                    continue;
+
+                rt::aligner_parameters parameters = load.parameters();
+                parameters.engine = engine;
+                parameters.precision = precision;
+
+                std::string const name = load.name + "/" + to_string(engine) + ":" + to_string(precision);
+                ::benchmark::RegisterBenchmark(name.c_str(), run, load, parameters);
+            }
+        }
+
+        std::vector<std::string_view> sequences1 = load.first_sequences();
+        std::vector<std::string_view> sequences2(load.sequences2.begin(), load.sequences2.end());
+        rt::aligner_parameters planned = rt::plan_aligner(load.parameters(),
+                                                          rt::collect_batch_statistics(sequences1, sequences2),
+                                                          &std::clog);
+        ::benchmark::RegisterBenchmark((load.name + "/planned").c_str(), run, load, planned);
+    }
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    planner_reporter reporter{};
+    ::benchmark::RunSpecifiedBenchmarks(&reporter);
+    reporter.print_summary(std::cout);
+    return 0;
+}
@@ -0,0 +1,84 @@
+# -----------------------------------------------------------------------------------------------------
+# Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+# Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+# This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+# shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+# -----------------------------------------------------------------------------------------------------
+
+# Runs all candidates of the tuning benchmark and writes the fastest profile.
+# Expects:
+#   TUNING_CANDIDATES  - ','-separated list of <executable>:<lane_width>:<block_size_limit>.
+#   TUNING_MIN_TIME    - the value of --benchmark_min_time.
+#   TUNING_TEMPLATE    - the tuning_profile.hpp.in template.
+#   TUNING_OUTPUT      - the generated profile.
+#
+# The lane width of all but the saturated NxN kernel is chosen by the summed CUPS of the simd_NxN and simd_1xN
+# kernels, which do not depend on the block size limit. The lane width of the saturated NxN kernel and the block size
+# limit are chosen by the CUPS of the saturated_NxN and saturated_1xN kernels.
+
+cmake_minimum_required (VERSION 3.12)
+
+string (REPLACE "," ";" candidates "${TUNING_CANDIDATES}")
+
+set (best_lane_width_cups 0)
+set (best_saturated_cups 0)
+
+foreach (candidate ${candidates})
+    # The executable may contain ':' on Windows, hence the fields are taken from the end.
+    string (REGEX MATCH "^(.*):([0-9]+):([0-9]+)$" match "${candidate}")
+    set (executable "${CMAKE_MATCH_1}")
+    set (lane_width "${CMAKE_MATCH_2}")
+    set (block_size_limit "${CMAKE_MATCH_3}")
+
+    get_filename_component (candidate_name "${executable}" NAME_WE)
+    set (result_file "${CMAKE_CURRENT_BINARY_DIR}/${candidate_name}.tsv")
+    file (REMOVE "${result_file}")
+
+    message (STATUS "Running ${candidate_name}")
+    execute_process (COMMAND "${executable}" "--benchmark_min_time=${TUNING_MIN_TIME}" "--tuning_out=${result_file}"
+                     RESULT_VARIABLE result
+                     OUTPUT_QUIET)
+    if (NOT result EQUAL 0 OR NOT EXISTS "${result_file}")
+        message (WARNING "Skipping ${candidate_name}: the benchmark failed.")
+        continue ()
+    endif ()
+
+    set (lane_width_cups 0)
+    set (saturated_cups 0)
+    file (STRINGS "${result_file}" lines)
+    foreach (line ${lines})
+        string (REGEX MATCH "^([A-Za-z0-9_]+)\t([0-9]+)$" match "${line}")
+        if (CMAKE_MATCH_1 STREQUAL "simd_NxN" OR CMAKE_MATCH_1 STREQUAL "simd_1xN")
+            math (EXPR lane_width_cups "${lane_width_cups} + ${CMAKE_MATCH_2}")
+        elseif (CMAKE_MATCH_1 STREQUAL "saturated_NxN" OR CMAKE_MATCH_1 STREQUAL "saturated_1xN")
+            math (EXPR saturated_cups "${saturated_cups} + ${CMAKE_MATCH_2}")
+        endif ()
+    endforeach ()
+    message (STATUS "  lane_width=${lane_width} block_size_limit=${block_size_limit}: "
+                    "simd CUPS=${lane_width_cups} saturated CUPS=${saturated_cups}")
+
+    if (lane_width_cups GREATER best_lane_width_cups)
+        set (best_lane_width_cups ${lane_width_cups})
+        set (TUNING_LANE_WIDTH ${lane_width})
+    endif ()
+    if (saturated_cups GREATER best_saturated_cups)
+        set (best_saturated_cups ${saturated_cups})
+        set (TUNING_SATURATED_NXN_LANE_WIDTH ${lane_width})
+        set (best_block_size_limit ${block_size_limit})
+    endif ()
+endforeach ()
+
+if (NOT DEFINED TUNING_LANE_WIDTH OR NOT DEFINED TUNING_SATURATED_NXN_LANE_WIDTH)
+    message (FATAL_ERROR "No tuning candidate finished successfully.")
+endif ()
+
+if (best_block_size_limit EQUAL 0)
+    set (TUNING_SATURATED_BLOCK_SIZE_LIMIT "default_profile::saturated_block_size_limit")
+else ()
+    set (TUNING_SATURATED_BLOCK_SIZE_LIMIT ${best_block_size_limit})
+endif ()
+
+configure_file ("${TUNING_TEMPLATE}" "${TUNING_OUTPUT}" @ONLY)
+message (STATUS "Selected lane_width=${TUNING_LANE_WIDTH} saturated_NxN_lane_width=${TUNING_SATURATED_NXN_LANE_WIDTH} "
+                "saturated_block_size_limit=${best_block_size_limit}")
+message (STATUS "Wrote ${TUNING_OUTPUT}; configure with -DPAIRWISE_ALIGNER_TUNING_PROFILE=${TUNING_OUTPUT} to use it.")
@@ -0,0 +1,146 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Benchmarks the kernels affected by the tuning profile.
+// The pairwise_aligner_tune target builds this benchmark once per candidate profile. With --tuning_out=<file> the
+// CUPS of every kernel are written as "<kernel>\t<cups>" lines to the given file, which are compared by
+// run_tuning.cmake to select the host profile.
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <seqan3/alphabet/aminoacid/aa20.hpp>
+#include <seqan3/alignment/configuration/align_config_method.hpp>
+#include <seqan3/core/configuration/configuration.hpp>
+
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_1xN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+#include "../affine/alignment_benchmark_fixture.hpp"
+
+namespace aligner::benchmark::tuning {
+namespace pa = seqan::pairwise_aligner;
+
+using score_t = int16_t;
+
+DEFINE_BENCHMARK_VALUES(simd_NxN,
+    .configurator = pa::cfg::gap_model_affine(pa::cfg::score_model_matrix_simd_NxN(pa::blosum62_standard<score_t>),
+                                              -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<score_t>::size_v
+)
+
+// The fixed 1xN score model only supports 8-bit scores.
+DEFINE_BENCHMARK_VALUES(simd_1xN,
+    .configurator = pa::cfg::gap_model_affine(pa::cfg::score_model_matrix_simd_1xN(pa::blosum62_standard<int8_t>),
+                                              -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .one_vs_many = std::true_type{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<int8_t>::size_v
+)
+
+DEFINE_BENCHMARK_VALUES(saturated_NxN,
+    .configurator = pa::cfg::gap_model_affine(
+                        pa::cfg::score_model_matrix_simd_saturated_NxN(pa::blosum62_standard<score_t>), -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<int8_t>::size_v
+)
+
+DEFINE_BENCHMARK_VALUES(saturated_1xN,
+    .configurator = pa::cfg::gap_model_affine(
+                        pa::cfg::score_model_matrix_simd_saturated_1xN(pa::blosum62_standard<score_t>), -10, -1),
+    .seqan_configurator = seqan3::configuration{} | seqan3::align_cfg::method_global{},
+    .alphabet = seqan3::aa20{},
+    .one_vs_many = std::true_type{},
+    .sequence_size_mean = aligner::benchmark::sequence_size,
+    .sequence_size_variance = 0,
+    .sequence_count = pa::simd_score<int8_t>::size_v
+)
+
+ALIGNER_BENCHMARK(tuning, simd_NxN)
+ALIGNER_BENCHMARK(tuning, simd_1xN)
+ALIGNER_BENCHMARK(tuning, saturated_NxN)
+ALIGNER_BENCHMARK(tuning, saturated_1xN)
+
+} // namespace aligner::benchmark::tuning
+
+// Collects the CUPS of all runs by the name of the benchmarked kernel.
+class tuning_reporter : public ::benchmark::ConsoleReporter
+{
+    std::map<std::string, double> _cups{};
+
+public:
+    void ReportRuns(std::vector<Run> const & runs) override
+    {
+        ::benchmark::ConsoleReporter::ReportRuns(runs);
+
+        for (Run const & run : runs)
+        {
+            std::string const name = run.benchmark_name();
+            size_t const separator = name.find("tuning_");
+            auto counter = run.counters.find("CUPS");
+            if (separator != std::string::npos && counter != run.counters.end())
+                _cups[name.substr(separator + std::string_view{"tuning_"}.size())] = counter->second.value;
+        }
+    }
+
+    // Writes the CUPS as integers, since cmake can only compare integral values.
+    void write(std::ostream & stream) const
+    {
+        for (auto const & [kernel_name, cups] : _cups)
+            stream << kernel_name << '\t' << static_cast<uint64_t>(cups) << '\n';
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    // Remove the option of the tuning harness before the remaining options are parsed by the benchmark library.
+    std::string tuning_out{};
+    std::string_view const tuning_out_option{"--tuning_out="};
+    int remaining_argc = 0;
+    for (int i = 0; i < argc; ++i)
+    {
+        std::string_view const argument{argv[i]};
+        if (argument.starts_with(tuning_out_option))
+            tuning_out = argument.substr(tuning_out_option.size());
+        else
+            argv[remaining_argc++] = argv[i];
+    }
+    argc = remaining_argc;
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    tuning_reporter reporter{};
+    ::benchmark::RunSpecifiedBenchmarks(&reporter);
+
+    if (!tuning_out.empty())
+    {
+        std::ofstream stream{tuning_out};
+        reporter.write(stream);
+    }
+    return 0;
+}
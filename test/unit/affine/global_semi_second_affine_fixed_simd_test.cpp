@@ -102,6 +102,49 @@ using variable_size_types =
         pairwise_aligner::test::fixture<&variable_size_16>,
         pairwise_aligner::test::fixture<&variable_size_8>
     >;
+
+// ----------------------------------------------------------------------------
+// Long size
+// ----------------------------------------------------------------------------
+
+// Pairs a short first sequence with a second sequence whose row holds more cells than the score type can count. The
+// free last row is scanned beyond the positions representable in the score width.
+template <typename score_t>
+inline void expect_long_size_scores(size_t const short_size, size_t const long_size, unsigned const seed)
+{
+    std::mt19937 random_engine{seed};
+    std::uniform_int_distribution<size_t> short_size_distribution{1, short_size};
+    std::uniform_int_distribution<size_t> long_size_distribution{long_size, long_size + 100};
+    std::uniform_int_distribution<size_t> symbol_distribution{0, 3};
+    auto generate_sequence = [&] (size_t const size) {
+        std::string sequence(size, 'A');
+        std::ranges::generate(sequence, [&] () { return "ACGT"[symbol_distribution(random_engine)]; });
+        return sequence;
+    };
+
+    std::vector<std::string> sequences1{};
+    std::vector<std::string> sequences2{};
+    for (size_t i = 0; i < aligner::simd_score<score_t>::size_v; ++i) {
+        sequences1.push_back(generate_sequence(short_size_distribution(random_engine)));
+        sequences2.push_back(generate_sequence(long_size_distribution(random_engine)));
+    }
+
+    auto scalar_aligner =
+        aligner::cfg::configure_aligner(aligner::cfg::score_model_unitary(base_config, int32_t{4}, int32_t{-5}));
+    auto simd_aligner = aligner::cfg::configure_aligner(
+        aligner::cfg::score_model_unitary_simd(base_config, score_t{4}, score_t{-5}));
+
+    size_t index = 0;
+    for (auto result : simd_aligner.compute(sequences1, sequences2)) {
+        EXPECT_EQ(static_cast<int32_t>(result.score()),
+                  static_cast<int32_t>(scalar_aligner.compute(result.sequence1(), result.sequence2()).score()))
+            << "index: " << index << "\n"
+            << "s1: (" << result.sequence1().size() << ")\n"
+            << "s2: (" << result.sequence2().size() << ")\n";
+        ++index;
+    }
+}
+
 } // global::affine::fixed_simd
 
 INSTANTIATE_TYPED_TEST_SUITE_P(equal_size_test,
@@ -111,3 +154,13 @@ INSTANTIATE_TYPED_TEST_SUITE_P(equal_size_test,
 INSTANTIATE_TYPED_TEST_SUITE_P(variable_size_test,
                                test_suite,
                                global::semi_second::affine::fixed_simd::variable_size_types,);
+
+TEST(long_size_test, score_16)
+{
+    global::semi_second::affine::fixed_simd::expect_long_size_scores<int16_t>(40, 65600, 42);
+}
+
+TEST(long_size_test, score_8)
+{
+    global::semi_second::affine::fixed_simd::expect_long_size_scores<int8_t>(10, 300, 42);
+}
@@ -12,6 +12,7 @@
 #include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
 
 #include <pairwise_aligner/score_model/substitution_matrix.hpp>
+#include <pairwise_aligner/utility/tuning_profile.hpp>
 
 #include "alignment_simd_test_template.hpp"
 
@@ -121,6 +122,48 @@ using variable_size_types =
         pairwise_aligner::test::fixture<&variable_size_8>,
         pairwise_aligner::test::fixture<&sequence_size_1000_variable_32>
     >;
+
+// ----------------------------------------------------------------------------
+// Extended alphabet
+// ----------------------------------------------------------------------------
+
+// The triangular matrix of the extended alphabet exceeds 256 entries, such that the scores are gathered by rank.
+template <typename score_t>
+void expect_extended_alphabet_scores(size_t const min_size, size_t const max_size)
+{
+    if constexpr (aligner::tuning::profile::saturated_NxN_gather_by_rank) {
+        auto const & matrix = aligner::blosum62_extended<score_t>;
+
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<size_t> size_distribution{min_size, max_size};
+        std::uniform_int_distribution<size_t> symbol_distribution{0, matrix.size() - 1};
+        auto generate_sequences = [&] () {
+            std::vector<std::string> sequences(sequence_count);
+            for (std::string & sequence : sequences) {
+                sequence.resize(size_distribution(random_engine));
+                std::ranges::generate(sequence, [&] () { return matrix[symbol_distribution(random_engine)].first; });
+            }
+            return sequences;
+        };
+        std::vector<std::string> sequences1 = generate_sequences();
+        std::vector<std::string> sequences2 = generate_sequences();
+
+        auto scalar_aligner = aligner::cfg::configure_aligner(aligner::cfg::score_model_matrix(base_config, matrix));
+        auto simd_aligner =
+            aligner::cfg::configure_aligner(aligner::cfg::score_model_matrix_simd_saturated_NxN(base_config, matrix));
+
+        size_t index = 0;
+        for (auto result : simd_aligner.compute(sequences1, sequences2)) {
+            EXPECT_EQ(static_cast<int32_t>(result.score()),
+                      static_cast<int32_t>(scalar_aligner.compute(result.sequence1(), result.sequence2()).score()))
+                << "index: " << index;
+            ++index;
+        }
+    } else {
+        GTEST_SKIP() << "The tuning profile does not enable the saturated NxN kernel for large alphabets.";
+    }
+}
+
 } // global::affine::saturated_simd
 
 INSTANTIATE_TYPED_TEST_SUITE_P(equal_size_test,
@@ -130,3 +173,13 @@ INSTANTIATE_TYPED_TEST_SUITE_P(equal_size_test,
 INSTANTIATE_TYPED_TEST_SUITE_P(variable_size_test,
                                test_suite,
                                global::standard::affine::saturated_simd::matrix::NxN::variable_size_types,);
+
+TEST(extended_alphabet_test, equal_size)
+{
+    global::standard::affine::saturated_simd::matrix::NxN::expect_extended_alphabet_scores<int32_t>(150, 150);
+}
+
+TEST(extended_alphabet_test, variable_size)
+{
+    global::standard::affine::saturated_simd::matrix::NxN::expect_extended_alphabet_scores<int16_t>(11, 200);
+}
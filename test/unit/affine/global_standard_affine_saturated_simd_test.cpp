@@ -117,6 +117,50 @@ using variable_size_types =
         pairwise_aligner::test::fixture<&variable_size_8>,
         pairwise_aligner::test::fixture<&sequence_size_1000_variable_32>
     >;
+
+// ----------------------------------------------------------------------------
+// Skewed size
+// ----------------------------------------------------------------------------
+
+// Pairs a long with a short sequence in every lane and alternates which of them is long. Most blocks lie beyond the
+// ends of all lanes and are skipped.
+inline void expect_skewed_size_scores(unsigned const seed)
+{
+    std::mt19937 random_engine{seed};
+    std::uniform_int_distribution<size_t> long_size_distribution{700, 1000};
+    std::uniform_int_distribution<size_t> short_size_distribution{1, 40};
+    std::uniform_int_distribution<size_t> symbol_distribution{0, 3};
+    auto generate_sequence = [&] (size_t const size) {
+        std::string sequence(size, 'A');
+        std::ranges::generate(sequence, [&] () { return "ACGT"[symbol_distribution(random_engine)]; });
+        return sequence;
+    };
+
+    std::vector<std::string> sequences1{};
+    std::vector<std::string> sequences2{};
+    for (size_t i = 0; i < sequence_count; ++i) {
+        size_t const long_size = long_size_distribution(random_engine);
+        size_t const short_size = short_size_distribution(random_engine);
+        sequences1.push_back(generate_sequence((i % 2 == 0) ? long_size : short_size));
+        sequences2.push_back(generate_sequence((i % 2 == 0) ? short_size : long_size));
+    }
+
+    auto scalar_aligner =
+        aligner::cfg::configure_aligner(aligner::cfg::score_model_unitary(base_config, int32_t{4}, int32_t{-5}));
+    auto simd_aligner = aligner::cfg::configure_aligner(
+        aligner::cfg::score_model_unitary_simd_saturated(base_config, int32_t{4}, int32_t{-5}));
+
+    size_t index = 0;
+    for (auto result : simd_aligner.compute(sequences1, sequences2)) {
+        EXPECT_EQ(static_cast<int32_t>(result.score()),
+                  static_cast<int32_t>(scalar_aligner.compute(result.sequence1(), result.sequence2()).score()))
+            << "index: " << index << "\n"
+            << "s1: (" << result.sequence1().size() << ")\n"
+            << "s2: (" << result.sequence2().size() << ")\n";
+        ++index;
+    }
+}
+
 } // global::affine::saturated_simd
 
 INSTANTIATE_TYPED_TEST_SUITE_P(equal_size_test,
@@ -126,3 +170,9 @@ INSTANTIATE_TYPED_TEST_SUITE_P(equal_size_test,
 INSTANTIATE_TYPED_TEST_SUITE_P(variable_size_test,
                                test_suite,
                                global::standard::affine::saturated_simd::variable_size_types,);
+
+TEST(skewed_size_test, score)
+{
+    global::standard::affine::saturated_simd::expect_skewed_size_scores(42);
+    global::standard::affine::saturated_simd::expect_skewed_size_scores(7);
+}
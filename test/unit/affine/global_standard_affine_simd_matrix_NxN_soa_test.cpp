@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <utility>
+
+#include <pairwise_aligner/configuration/dp_vector_layout.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
+
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+#include "alignment_simd_test_template.hpp"
+
+namespace global::standard::affine::simd::matrix::NxN::soa {
+
+namespace aligner = seqan::pairwise_aligner;
+
+inline constexpr auto base_config =
+    aligner::cfg::method_global(
+        aligner::cfg::gap_model_affine(-10, -1),
+        aligner::cfg::leading_end_gap{}, aligner::cfg::trailing_end_gap{}
+    );
+
+inline constexpr auto fixed_soa = [] (auto && predecessor, auto const & substitution_matrix) {
+    return aligner::cfg::score_model_matrix_simd_NxN(std::forward<decltype(predecessor)>(predecessor),
+                                                     substitution_matrix,
+                                                     aligner::cfg::structure_of_arrays{});
+};
+
+inline constexpr auto saturated_soa = [] (auto && predecessor, auto const & substitution_matrix) {
+    return aligner::cfg::score_model_matrix_simd_saturated_NxN(std::forward<decltype(predecessor)>(predecessor),
+                                                               substitution_matrix,
+                                                               aligner::cfg::structure_of_arrays{});
+};
+
+// ----------------------------------------------------------------------------
+// Fixed
+// ----------------------------------------------------------------------------
+
+DEFINE_TEST_VALUES(fixed_equal_size_16,
+    .base_configurator = base_config,
+    .score_configurator = fixed_soa,
+    .substitution_scores = alignment::test::simd::matrix_model{aligner::blosum62_standard<int16_t>},
+    .sequence_generation_param{aligner::simd_score<int16_t>::size_v, 150, 150}
+)
+
+DEFINE_TEST_VALUES(fixed_variable_size_16,
+    .base_configurator = base_config,
+    .score_configurator = fixed_soa,
+    .substitution_scores = alignment::test::simd::matrix_model{aligner::blosum62_standard<int16_t>},
+    .sequence_generation_param{aligner::simd_score<int16_t>::size_v, 11, 200}
+)
+
+using fixed_types =
+    ::testing::Types<
+        pairwise_aligner::test::fixture<&fixed_equal_size_16>,
+        pairwise_aligner::test::fixture<&fixed_variable_size_16>
+    >;
+
+// ----------------------------------------------------------------------------
+// Saturated
+// ----------------------------------------------------------------------------
+
+DEFINE_TEST_VALUES(saturated_equal_size_32,
+    .base_configurator = base_config,
+    .score_configurator = saturated_soa,
+    .substitution_scores = alignment::test::simd::matrix_model{aligner::blosum62_standard<int32_t>},
+    .sequence_generation_param{aligner::simd_score<int8_t>::size_v, 210, 210},
+)
+
+DEFINE_TEST_VALUES(saturated_variable_size_32,
+    .base_configurator = base_config,
+    .score_configurator = saturated_soa,
+    .substitution_scores = alignment::test::simd::matrix_model{aligner::blosum62_standard<int32_t>},
+    .sequence_generation_param{aligner::simd_score<int8_t>::size_v, 900, 1100},
+)
+
+using saturated_types =
+    ::testing::Types<
+        pairwise_aligner::test::fixture<&saturated_equal_size_32>,
+        pairwise_aligner::test::fixture<&saturated_variable_size_32>
+    >;
+} // global::standard::affine::simd::matrix::NxN::soa
+
+INSTANTIATE_TYPED_TEST_SUITE_P(fixed_soa_test,
+                               test_suite,
+                               global::standard::affine::simd::matrix::NxN::soa::fixed_types,);
+
+INSTANTIATE_TYPED_TEST_SUITE_P(saturated_soa_test,
+                               test_suite,
+                               global::standard::affine::simd::matrix::NxN::soa::saturated_types,);
@@ -0,0 +1,201 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/runtime/aligner.hpp>
+
+#include "batch_alignment.hpp"
+
+namespace pa = seqan::pairwise_aligner;
+
+struct batch_alignment_test : public ::testing::Test
+{
+    std::filesystem::path queries_path{std::filesystem::temp_directory_path() / "batch_alignment_test_queries.fa"};
+    std::filesystem::path targets_path{std::filesystem::temp_directory_path() / "batch_alignment_test_targets.fa"};
+    std::filesystem::path pairs_path{std::filesystem::temp_directory_path() / "batch_alignment_test_pairs.txt"};
+    std::vector<std::string> queries{};
+    std::vector<std::string> targets{};
+
+    void SetUp() override
+    {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<size_t> size_distribution{5, 60};
+        std::string_view const symbols{"ARNDCQEGHILKMFPSTWYV"};
+        std::uniform_int_distribution<size_t> symbol_distribution{0, symbols.size() - 1};
+
+        auto write_sequences = [&] (std::filesystem::path const & file_path,
+                                    std::string_view const prefix,
+                                    std::vector<std::string> & sequences,
+                                    size_t const count) {
+            std::ofstream file_stream{file_path};
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::string & sequence = sequences.emplace_back(size_distribution(random_engine), ' ');
+                for (char & symbol : sequence)
+                    symbol = symbols[symbol_distribution(random_engine)];
+
+                // Split the sequences into lines of 40 symbols.
+                file_stream << '>' << prefix << i << " description\n";
+                for (size_t offset = 0; offset < sequence.size(); offset += 40)
+                    file_stream << sequence.substr(offset, 40) << '\n';
+            }
+        };
+
+        write_sequences(queries_path, "query", queries, 3);
+        write_sequences(targets_path, "target", targets, 77);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(queries_path);
+        std::filesystem::remove(targets_path);
+        std::filesystem::remove(pairs_path);
+    }
+
+    pa::app::batch_alignment_options options() const
+    {
+        pa::app::batch_alignment_options options{};
+        options.queries = queries_path;
+        options.targets = targets_path;
+        options.thread_count = 3;
+        options.batch_size = 16;
+        options.queue_capacity = 1;
+        return options;
+    }
+
+    int32_t expected_score(size_t const query_idx, size_t const target_idx) const
+    {
+        pa::runtime::aligner_parameters parameters{};
+        parameters.engine = pa::runtime::alignment_engine::scalar;
+        parameters.precision = pa::runtime::score_precision::int32;
+        pa::runtime::aligner aligner{parameters};
+
+        std::vector<std::string_view> sequences1{queries[query_idx]};
+        std::vector<std::string_view> sequences2{targets[target_idx]};
+        return aligner.compute(sequences1, sequences2)[0];
+    }
+};
+
+TEST_F(batch_alignment_test, all_pairs_tsv)
+{
+    std::ostringstream output{};
+    std::ostringstream log{};
+    pa::app::run_batch_alignment(options(), output, log);
+
+    std::vector<bool> found(queries.size() * targets.size(), false);
+    std::istringstream result_stream{output.str()};
+    std::string query_name{};
+    std::string target_name{};
+    size_t query_length{};
+    size_t target_length{};
+    int32_t score{};
+    while (result_stream >> query_name >> query_length >> target_name >> target_length >> score)
+    {
+        size_t const query_idx = std::stoul(query_name.substr(5));
+        size_t const target_idx = std::stoul(target_name.substr(6));
+        EXPECT_EQ(query_length, queries[query_idx].size());
+        EXPECT_EQ(target_length, targets[target_idx].size());
+        EXPECT_EQ(score, expected_score(query_idx, target_idx));
+        found[query_idx * targets.size() + target_idx] = true;
+    }
+
+    EXPECT_TRUE(std::ranges::all_of(found, std::identity{}));
+}
+
+TEST_F(batch_alignment_test, listed_pairs_binary)
+{
+    std::vector<std::pair<size_t, size_t>> const pairs{{2, 76}, {0, 0}, {1, 13}, {2, 76}, {0, 42}};
+    {
+        std::ofstream pairs_stream{pairs_path};
+        pairs_stream << "# query target\n";
+        for (auto [query_idx, target_idx] : pairs)
+            pairs_stream << "query" << query_idx << "\ttarget" << target_idx << '\n';
+    }
+
+    pa::app::batch_alignment_options binary_options = options();
+    binary_options.pairs = pairs_path;
+    binary_options.format = pa::app::output_format::binary;
+    binary_options.batch_size = 2;
+
+    std::ostringstream output{};
+    std::ostringstream log{};
+    pa::app::run_batch_alignment(binary_options, output, log);
+
+    std::string const records = output.str();
+    size_t const record_size = 2 * sizeof(uint64_t) + sizeof(int32_t);
+    ASSERT_EQ(records.size(), pairs.size() * record_size);
+    for (size_t pair_idx = 0; pair_idx < pairs.size(); ++pair_idx)
+    {
+        uint64_t query_idx{};
+        uint64_t target_idx{};
+        int32_t score{};
+        std::memcpy(&query_idx, records.data() + pair_idx * record_size, sizeof(uint64_t));
+        std::memcpy(&target_idx, records.data() + pair_idx * record_size + sizeof(uint64_t), sizeof(uint64_t));
+        std::memcpy(&score, records.data() + pair_idx * record_size + 2 * sizeof(uint64_t), sizeof(int32_t));
+
+        EXPECT_EQ(query_idx, pairs[pair_idx].first);
+        EXPECT_EQ(target_idx, pairs[pair_idx].second);
+        EXPECT_EQ(score, expected_score(query_idx, target_idx));
+    }
+}
+
+TEST_F(batch_alignment_test, unknown_pair)
+{
+    {
+        std::ofstream pairs_stream{pairs_path};
+        pairs_stream << "query0\ttarget1000\n";
+    }
+
+    pa::app::batch_alignment_options pair_options = options();
+    pair_options.pairs = pairs_path;
+
+    std::ostringstream output{};
+    std::ostringstream log{};
+    EXPECT_THROW(pa::app::run_batch_alignment(pair_options, output, log), std::runtime_error);
+}
+
+TEST(batch_alignment_arguments, parse)
+{
+    std::vector<char const *> const arguments{"pairwise_align", "--queries", "q.fa", "--targets", "t.fa",
+                                              "--method", "semi-global", "--format", "paf", "--threads", "8",
+                                              "--engine", "simd_1xN", "--verbose"};
+    pa::app::batch_alignment_options const options = pa::app::parse_arguments(arguments);
+
+    EXPECT_EQ(options.queries, "q.fa");
+    EXPECT_EQ(options.targets, "t.fa");
+    EXPECT_EQ(options.format, pa::app::output_format::paf);
+    EXPECT_EQ(options.thread_count, 8u);
+    EXPECT_EQ(options.engine, pa::runtime::alignment_engine::simd_1xN);
+    EXPECT_FALSE(options.precision.has_value());
+    EXPECT_TRUE(options.verbose);
+    EXPECT_EQ(options.parameters.method, pa::runtime::alignment_method::global);
+    EXPECT_EQ(options.parameters.leading_end_gap.first_row, pa::cfg::end_gap::free);
+    EXPECT_EQ(options.parameters.leading_end_gap.first_column, pa::cfg::end_gap::penalised);
+    EXPECT_EQ(options.parameters.trailing_end_gap.last_row, pa::cfg::end_gap::free);
+
+    EXPECT_THROW(pa::app::parse_arguments(std::vector<char const *>{"pairwise_align", "--queries", "q.fa"}),
+                 std::invalid_argument);
+    EXPECT_THROW(pa::app::parse_arguments(std::vector<char const *>{"pairwise_align", "--threads", "many"}),
+                 std::invalid_argument);
+    EXPECT_THROW(pa::app::parse_arguments(std::vector<char const *>{"pairwise_align", "--unknown", "value"}),
+                 std::invalid_argument);
+}
@@ -38,5 +38,6 @@ TEST(configuration_test, prototype)
     std::vector collection1{seq1};
     std::vector collection2{seq2};
 
-    EXPECT_EQ((aligner.compute(collection1, collection2))[0].score(), 80);
+    auto results = aligner.compute(collection1, collection2);
+    EXPECT_EQ(results[0].score(), 80);
 }
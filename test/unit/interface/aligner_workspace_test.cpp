@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
+#include <pairwise_aligner/interface/aligner_workspace.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct aligner_workspace_test : public ::testing::Test
+{
+    std::mt19937 random_engine{42};
+
+    // Generates bulks of decreasing and increasing sizes, such that the workspace is shrunk and grown again.
+    std::vector<std::vector<std::string>> generate_bulks(size_t const bulk_size)
+    {
+        std::vector<std::vector<std::string>> bulks{};
+        for (size_t max_size : {150, 40, 200, 10})
+        {
+            std::uniform_int_distribution<size_t> size_distribution{max_size / 2, max_size};
+            std::uniform_int_distribution<size_t> symbol_distribution{0, pa::blosum62_standard<int32_t>.size() - 1};
+
+            std::vector<std::string> bulk{};
+            for (size_t i = 0; i < bulk_size; ++i)
+            {
+                std::string sequence(size_distribution(random_engine), ' ');
+                std::ranges::generate(sequence, [&] () {
+                    return pa::blosum62_standard<int32_t>[symbol_distribution(random_engine)].first;
+                });
+                bulk.push_back(std::move(sequence));
+            }
+            bulks.push_back(std::move(bulk));
+        }
+        return bulks;
+    }
+
+    static constexpr auto method()
+    {
+        return pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                      pa::cfg::leading_end_gap{},
+                                      pa::cfg::trailing_end_gap{});
+    }
+};
+
+TEST_F(aligner_workspace_test, one_to_one_single)
+{
+    auto aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix(method(), pa::blosum62_standard<int32_t>));
+    auto workspace = aligner.make_workspace();
+
+    auto sequences1 = generate_bulks(1);
+    auto sequences2 = generate_bulks(1);
+    for (size_t i = 0; i < sequences1.size(); ++i)
+    {
+        EXPECT_EQ(aligner.compute(sequences1[i][0], sequences2[i][0], workspace).score(),
+                  aligner.compute(sequences1[i][0], sequences2[i][0]).score());
+    }
+}
+
+TEST_F(aligner_workspace_test, one_to_one_bulk)
+{
+    using score_t = int16_t;
+    auto aligner = pa::cfg::configure_aligner(
+                        pa::cfg::score_model_matrix_simd_NxN(method(), pa::blosum62_standard<score_t>));
+    auto workspace = aligner.make_workspace();
+
+    auto sequences1 = generate_bulks(pa::simd_score<score_t>::size_v);
+    auto sequences2 = generate_bulks(pa::simd_score<score_t>::size_v);
+    for (size_t i = 0; i < sequences1.size(); ++i)
+    {
+        auto expected = aligner.compute(sequences1[i], sequences2[i]);
+        auto result = aligner.compute(sequences1[i], sequences2[i], workspace);
+        for (size_t k = 0; k < expected.size(); ++k)
+            EXPECT_EQ(result[k].score(), expected[k].score()) << "bulk " << i << " lane " << k;
+    }
+}
+
+TEST_F(aligner_workspace_test, one_to_one_bulk_saturated)
+{
+    auto aligner = pa::cfg::configure_aligner(
+                        pa::cfg::score_model_matrix_simd_saturated_NxN(method(), pa::blosum62_standard<int32_t>));
+    auto workspace = aligner.make_workspace();
+
+    auto sequences1 = generate_bulks(pa::simd_score<int8_t>::size_v);
+    auto sequences2 = generate_bulks(pa::simd_score<int8_t>::size_v);
+    for (size_t i = 0; i < sequences1.size(); ++i)
+    {
+        auto expected = aligner.compute(sequences1[i], sequences2[i]);
+        auto result = aligner.compute(sequences1[i], sequences2[i], workspace);
+        for (size_t k = 0; k < expected.size(); ++k)
+            EXPECT_EQ(result[k].score(), expected[k].score()) << "bulk " << i << " lane " << k;
+    }
+}
+
+TEST_F(aligner_workspace_test, one_to_many_bulk)
+{
+    using score_t = int8_t;
+    auto aligner = pa::cfg::configure_aligner(
+                        pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<score_t>));
+    auto workspace = aligner.make_workspace();
+
+    auto sequences1 = generate_bulks(1);
+    auto sequences2 = generate_bulks(pa::simd_score<int8_t>::size_v);
+    for (size_t i = 0; i < sequences1.size(); ++i)
+    {
+        auto expected = aligner.compute(sequences1[i][0], sequences2[i]);
+        auto result = aligner.compute(sequences1[i][0], sequences2[i], workspace);
+        for (size_t k = 0; k < expected.size(); ++k)
+            EXPECT_EQ(result[k].score(), expected[k].score()) << "bulk " << i << " lane " << k;
+    }
+}
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+template <typename batch_t>
+concept element_accessible = requires (batch_t && batch) { std::forward<batch_t>(batch)[0]; };
+
+template <typename batch_t>
+concept scores_accessible = requires (batch_t && batch) { std::forward<batch_t>(batch).scores(); };
+
+struct interface_one_to_one_bulk_test : public ::testing::Test
+{
+    using score_t = int16_t;
+
+    // Less pairs than simd lanes to test partially filled bulks.
+    std::vector<std::string> sequences1{"ARNDCQEGHILKMFPSTWYV", "WWWWHHHH", "KMFPSTWYVARND", "A"};
+    std::vector<std::string> sequences2{"ARNDCQEGHILKMFPSTWYV", "WWHHW", "ARNDKMFPSTWY", "ARNDC"};
+
+    static constexpr auto method()
+    {
+        return pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                      pa::cfg::leading_end_gap{},
+                                      pa::cfg::trailing_end_gap{});
+    }
+
+    std::vector<int32_t> expected_scores() const
+    {
+        auto aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix(method(),
+                                                                               pa::blosum62_standard<int32_t>));
+        std::vector<int32_t> scores{};
+        for (size_t i = 0; i < sequences1.size(); ++i)
+            scores.push_back(aligner.compute(sequences1[i], sequences2[i]).score());
+        return scores;
+    }
+
+    auto simd_aligner() const
+    {
+        return pa::cfg::configure_aligner(pa::cfg::score_model_matrix_simd_NxN(method(),
+                                                                               pa::blosum62_standard<score_t>));
+    }
+};
+
+TEST_F(interface_one_to_one_bulk_test, result_batch)
+{
+    auto aligner = simd_aligner();
+    auto batch = aligner.compute(sequences1, sequences2);
+    std::vector<int32_t> const expected = expected_scores();
+
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(batch)>);
+    ASSERT_EQ(batch.size(), sequences1.size());
+    ASSERT_EQ(batch.scores().size(), sequences1.size());
+
+    size_t index = 0;
+    for (auto result : batch)
+    {
+        EXPECT_EQ(result.index(), index);
+        EXPECT_EQ(result.score(), expected[index]);
+        EXPECT_EQ(batch.scores()[index], expected[index]);
+        EXPECT_TRUE(std::ranges::equal(result.sequence1(), sequences1[index]));
+        EXPECT_TRUE(std::ranges::equal(result.sequence2(), sequences2[index]));
+        ++index;
+    }
+    EXPECT_EQ(index, sequences1.size());
+}
+
+TEST_F(interface_one_to_one_bulk_test, result_batch_lvalue_only)
+{
+    // The elements refer to the batch, such that they are not accessible from a temporary batch.
+    using batch_t = decltype(simd_aligner().compute(sequences1, sequences2));
+    EXPECT_TRUE(element_accessible<batch_t &>);
+    EXPECT_TRUE(element_accessible<batch_t const &>);
+    EXPECT_FALSE(element_accessible<batch_t>);
+    EXPECT_TRUE(scores_accessible<batch_t &>);
+    EXPECT_FALSE(scores_accessible<batch_t>);
+}
+
+TEST_F(interface_one_to_one_bulk_test, score_sink)
+{
+    auto aligner = simd_aligner();
+    std::vector<int32_t> const expected = expected_scores();
+
+    std::vector<int32_t> scores(sequences1.size());
+    auto score_end = aligner.compute(sequences1, sequences2, scores.begin());
+    EXPECT_EQ(score_end, scores.end());
+    EXPECT_EQ(scores, expected);
+
+    std::vector<int32_t> appended_scores{};
+    auto workspace = aligner.make_workspace();
+    aligner.compute(sequences1, sequences2, workspace, std::back_inserter(appended_scores));
+    EXPECT_EQ(appended_scores, expected);
+}
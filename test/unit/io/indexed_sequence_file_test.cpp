@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <pairwise_aligner/io/indexed_sequence_file.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct indexed_sequence_file_test : public ::testing::Test
+{
+    std::filesystem::path file_path{std::filesystem::temp_directory_path() / "indexed_sequence_file_test.fa"};
+    std::filesystem::path index_path{std::filesystem::temp_directory_path() / "indexed_sequence_file_test.fa.fai"};
+
+    // Three sequences: single line, multiple lines of 4 symbols with a shorter last line and empty.
+    static constexpr std::string_view fasta_content{">single description\nACGTACGT\n"
+                                                    ">multi\nACGT\nTTGG\nCA\n"
+                                                    ">empty\n"
+                                                    ">last\nGG\nA"};
+
+    void write_file(std::filesystem::path const & path, std::string_view const content) const
+    {
+        std::ofstream file_stream{path, std::ios::binary | std::ios::trunc};
+        file_stream << content;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(file_path);
+        std::filesystem::remove(index_path);
+    }
+
+    void expect_sequences(pa::indexed_sequence_file & file) const
+    {
+        ASSERT_EQ(file.size(), 4u);
+        EXPECT_EQ(file.find("single"), 0u);
+        EXPECT_EQ(file.find("multi"), 1u);
+        EXPECT_EQ(file.find("single description"), std::nullopt);
+        EXPECT_EQ(file.name(2), "empty");
+        EXPECT_EQ(file.length(1), 10u);
+
+        pa::indexed_sequence const single = file.sequence(0);
+        EXPECT_EQ(single.sequence, "ACGTACGT");
+        EXPECT_EQ(single.owner, nullptr); // Viewed in the mapped file.
+
+        pa::indexed_sequence const multi = file.sequence(1);
+        EXPECT_EQ(multi.sequence, "ACGTTTGGCA");
+        ASSERT_NE(multi.owner, nullptr);
+        EXPECT_EQ(file.sequence(1).sequence.data(), multi.sequence.data()); // Joined only once while it is used.
+
+        EXPECT_EQ(file.sequence(2).sequence, "");
+        EXPECT_EQ(file.sequence(3).sequence, "GGA");
+    }
+};
+
+TEST_F(indexed_sequence_file_test, without_index)
+{
+    write_file(file_path, fasta_content);
+    pa::indexed_sequence_file file{file_path};
+    expect_sequences(file);
+}
+
+TEST_F(indexed_sequence_file_test, with_index)
+{
+    write_file(file_path, fasta_content);
+    write_file(index_path, "single\t8\t20\t8\t9\n"
+                           "multi\t10\t36\t4\t5\n"
+                           "empty\t0\t56\t0\t0\n"
+                           "last\t3\t62\t2\t3\n");
+    pa::indexed_sequence_file file{file_path};
+    expect_sequences(file);
+}
+
+TEST_F(indexed_sequence_file_test, malformed)
+{
+    write_file(file_path, "ACGT\n");
+    EXPECT_THROW((pa::indexed_sequence_file{file_path}), std::runtime_error);
+
+    write_file(file_path, fasta_content);
+    write_file(index_path, "single\t8\t20\t8\n");
+    EXPECT_THROW((pa::indexed_sequence_file{file_path}), std::runtime_error);
+
+    write_file(index_path, "single\t8\t2000\t8\t9\n"); // The offset lies behind the end of the file.
+    EXPECT_THROW((pa::indexed_sequence_file{file_path}), std::runtime_error);
+}
@@ -0,0 +1,256 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <pairwise_aligner/io/sequence_file_reader.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct sequence_file_reader_test : public ::testing::Test
+{
+    std::filesystem::path file_path{std::filesystem::temp_directory_path() / "sequence_file_reader_test.txt"};
+
+    void write_file(std::string_view const content) const
+    {
+        std::ofstream file_stream{file_path, std::ios::binary | std::ios::trunc};
+        file_stream << content;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(file_path);
+    }
+};
+
+TEST_F(sequence_file_reader_test, fasta)
+{
+    write_file(">seq1 first\nACGT\n"
+               ">seq2\r\nAC\r\nGT\r\nT\r\n"
+               "\n"
+               ">seq3\n"
+               ">seq4\nGGGG");
+
+    pa::sequence_file_reader reader{file_path, 3};
+    EXPECT_EQ(reader.format(), pa::sequence_file_format::fasta);
+
+    pa::sequence_record_batch batch{};
+    ASSERT_TRUE(reader.read_batch(batch));
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_EQ(batch.ids()[0], "seq1 first");
+    EXPECT_EQ(batch.sequences()[0], "ACGT");
+    EXPECT_EQ(batch.ids()[1], "seq2");
+    EXPECT_EQ(batch.sequences()[1], "ACGTT");
+    EXPECT_EQ(batch.ids()[2], "seq3");
+    EXPECT_EQ(batch.sequences()[2], "");
+    EXPECT_EQ(batch.qualities()[1], "");
+
+    ASSERT_TRUE(reader.read_batch(batch));
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch.ids()[0], "seq4");
+    EXPECT_EQ(batch.sequences()[0], "GGGG");
+
+    EXPECT_FALSE(reader.read_batch(batch));
+    EXPECT_TRUE(batch.empty());
+}
+
+TEST_F(sequence_file_reader_test, fastq)
+{
+    write_file("@read1\nACGT\n+\nIIII\n"
+               "@read2\nAC\nGT\n+read2\n@@\n+I\n"
+               "@read3\n\n+\n\n");
+
+    pa::sequence_file_reader reader{file_path, 2};
+    EXPECT_EQ(reader.format(), pa::sequence_file_format::fastq);
+
+    pa::sequence_record_batch batch{};
+    ASSERT_TRUE(reader.read_batch(batch));
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.ids()[0], "read1");
+    EXPECT_EQ(batch.sequences()[0], "ACGT");
+    EXPECT_EQ(batch.qualities()[0], "IIII");
+    EXPECT_EQ(batch.ids()[1], "read2");
+    EXPECT_EQ(batch.sequences()[1], "ACGT");
+    EXPECT_EQ(batch.qualities()[1], "@@+I");
+
+    ASSERT_TRUE(reader.read_batch(batch));
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch.ids()[0], "read3");
+    EXPECT_EQ(batch.sequences()[0], "");
+    EXPECT_EQ(batch.qualities()[0], "");
+
+    EXPECT_FALSE(reader.read_batch(batch));
+}
+
+TEST_F(sequence_file_reader_test, empty_file)
+{
+    write_file("");
+
+    pa::sequence_file_reader reader{file_path, 4};
+    pa::sequence_record_batch batch{};
+    EXPECT_FALSE(reader.read_batch(batch));
+}
+
+TEST_F(sequence_file_reader_test, malformed)
+{
+    EXPECT_THROW((pa::sequence_file_reader{file_path, 4}), std::runtime_error);
+
+    write_file("ACGT\n");
+    EXPECT_THROW((pa::sequence_file_reader{file_path, 4}), std::runtime_error);
+
+    write_file(">seq1\nACGT\n");
+    EXPECT_THROW((pa::sequence_file_reader{file_path, 0}), std::invalid_argument);
+
+    write_file("@read1\nACGT\n+\nIII\n");
+    pa::sequence_file_reader reader{file_path, 4};
+    pa::sequence_record_batch batch{};
+    EXPECT_THROW(reader.read_batch(batch), std::runtime_error);
+}
+
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+namespace
+{
+
+std::string deflate_data(std::string_view const data, int const window_bits)
+{
+    z_stream stream{};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
+    std::string compressed(deflateBound(&stream, data.size()) + 32, '\0');
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+    stream.avail_out = compressed.size();
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+void append_little_endian(std::string & data, uint32_t const value, size_t const byte_count)
+{
+    for (size_t byte_idx = 0; byte_idx < byte_count; ++byte_idx)
+        data.push_back(static_cast<char>((value >> (8 * byte_idx)) & 0xff));
+}
+
+// Compresses the data into BGZF blocks of the given size followed by the empty end-of-file block.
+std::string bgzf_compress(std::string_view data, size_t const block_size)
+{
+    std::string compressed{};
+    for (bool is_last = false; !is_last; data.remove_prefix(std::min(block_size, data.size())))
+    {
+        is_last = data.empty();
+        std::string_view const block = data.substr(0, block_size);
+        std::string const payload = deflate_data(block, -MAX_WBITS);
+
+        compressed.append("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+        append_little_endian(compressed, 18 + payload.size() + 8 - 1, 2);
+        compressed.append(payload);
+        append_little_endian(compressed, crc32(0, reinterpret_cast<Bytef const *>(block.data()), block.size()), 4);
+        append_little_endian(compressed, block.size(), 4);
+    }
+    return compressed;
+}
+
+std::string make_fastq(size_t const record_count)
+{
+    std::string content{};
+    for (size_t record_idx = 0; record_idx < record_count; ++record_idx)
+    {
+        std::string const sequence(record_idx % 150, "ACGT"[record_idx % 4]);
+        std::string const quality(sequence.size(), 'I');
+        content += "@read" + std::to_string(record_idx) + "\n" + sequence + "\n+\n" + quality + "\n";
+    }
+    return content;
+}
+
+void expect_fastq_records(pa::sequence_file_reader && reader, size_t const record_count, bool const keep_batches)
+{
+    std::vector<pa::sequence_record_batch> batches{};
+    size_t record_idx = 0;
+    for (pa::sequence_record_batch batch{}; reader.read_batch(batch); batch = pa::sequence_record_batch{})
+    {
+        for (size_t batch_idx = 0; batch_idx < batch.size(); ++batch_idx, ++record_idx)
+        {
+            EXPECT_EQ(batch.ids()[batch_idx], "read" + std::to_string(record_idx));
+            EXPECT_EQ(batch.sequences()[batch_idx], std::string(record_idx % 150, "ACGT"[record_idx % 4]));
+        }
+
+        if (keep_batches)
+            batches.push_back(std::move(batch));
+    }
+    EXPECT_EQ(record_idx, record_count);
+
+    // The kept batches still view the decompressed data.
+    for (size_t batch_idx = 0, first_record_idx = 0; batch_idx < batches.size(); ++batch_idx)
+    {
+        EXPECT_EQ(batches[batch_idx].ids()[0], "read" + std::to_string(first_record_idx));
+        first_record_idx += batches[batch_idx].size();
+    }
+}
+
+} // namespace
+#endif // PAIRWISE_ALIGNER_HAS_ZLIB
+
+TEST_F(sequence_file_reader_test, gzip)
+{
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+    size_t const record_count = 30000;
+    std::string const content = make_fastq(record_count);
+    // Two concatenated gzip members, as written by e.g. `cat a.fq.gz b.fq.gz`.
+    write_file(deflate_data(content.substr(0, content.size() / 3), MAX_WBITS + 16) +
+               deflate_data(content.substr(content.size() / 3), MAX_WBITS + 16));
+
+    pa::sequence_file_reader reader{file_path, 1000};
+    EXPECT_EQ(reader.format(), pa::sequence_file_format::fastq);
+    expect_fastq_records(std::move(reader), record_count, true);
+
+    std::string truncated = deflate_data(content, MAX_WBITS + 16);
+    truncated.resize(truncated.size() / 2);
+    write_file(truncated);
+    EXPECT_THROW((expect_fastq_records(pa::sequence_file_reader{file_path, 1000}, record_count, false)),
+                 std::runtime_error);
+#else
+    GTEST_SKIP() << "Reading compressed files requires zlib.";
+#endif
+}
+
+TEST_F(sequence_file_reader_test, bgzf)
+{
+#if PAIRWISE_ALIGNER_HAS_ZLIB
+    size_t const record_count = 30000;
+    std::string const content = make_fastq(record_count);
+    std::string const compressed = bgzf_compress(content, 4000);
+    write_file(compressed);
+
+    for (size_t thread_count : {1, 4})
+    {
+        expect_fastq_records(pa::sequence_file_reader{file_path, 700, thread_count}, record_count, thread_count == 1);
+    }
+
+    // A corrupted block is detected by its checksum.
+    std::string corrupted = compressed;
+    corrupted[compressed.size() / 2] ^= 0x55;
+    write_file(corrupted);
+    EXPECT_THROW((expect_fastq_records(pa::sequence_file_reader{file_path, 700, 4}, record_count, false)),
+                 std::runtime_error);
+#else
+    GTEST_SKIP() << "Reading compressed files requires zlib.";
+#endif
+}
@@ -0,0 +1,110 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <pairwise_aligner/affine/affine_cell.hpp>
+#include <pairwise_aligner/matrix/dp_vector_saturated.hpp>
+#include <pairwise_aligner/matrix/dp_vector_single_soa.hpp>
+#include <pairwise_aligner/simd/simd_score_type.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+// The lanes of the saturated engines are given by the native 8-bit vector.
+using saturated_score_t = pa::simd_score<int8_t>;
+using regular_score_t = pa::simd_score<int32_t, saturated_score_t::size_v>;
+using regular_cell_t = pa::affine_cell<regular_score_t, pa::dp_vector_order::column>;
+using saturated_cell_t = pa::affine_cell<saturated_score_t, pa::dp_vector_order::column>;
+using soa_vector_t = pa::dp_vector_single_soa<saturated_cell_t>;
+using saturated_vector_t = pa::dp_vector_saturated<soa_vector_t, regular_cell_t>;
+
+// Initialises the cell at index i with the scores <100 - 2i, 90 - 2i>.
+struct init_factory
+{
+    template <typename score_t>
+    auto create() const noexcept
+    {
+        return [] (size_t const index) {
+            return pa::affine_cell<score_t, pa::dp_vector_order::column>{static_cast<score_t>(100 - 2 * index),
+                                                                         static_cast<score_t>(90 - 2 * index)};
+        };
+    }
+};
+
+struct dp_vector_saturated_soa_test : public ::testing::Test
+{
+    saturated_vector_t dp_vector{soa_vector_t{}, int8_t{0}};
+
+    void SetUp() override
+    {
+        dp_vector.initialise(std::string_view{"ACGT"}, init_factory{});
+    }
+};
+
+TEST_F(dp_vector_saturated_soa_test, read)
+{
+    ASSERT_EQ(dp_vector.size(), 5u);
+
+    regular_cell_t cell = dp_vector[2];
+    EXPECT_EQ(cell.first[0], 96);
+    EXPECT_EQ(cell.second[0], 86);
+    EXPECT_EQ(dp_vector[3].score()[0], 94);
+    EXPECT_EQ(dp_vector[4].score_at(0), 92);
+
+    // The base vector stores the scores relative to the first cell.
+    EXPECT_EQ(dp_vector.base()[2].score()[0], -4);
+}
+
+TEST_F(dp_vector_saturated_soa_test, range)
+{
+    int32_t expected_score = 100;
+    for (auto && cell : dp_vector.range()) {
+        EXPECT_EQ(cell.score()[0], expected_score);
+        expected_score -= 2;
+    }
+
+    expected_score = 100;
+    for (auto && cell : std::as_const(dp_vector).range()) {
+        EXPECT_EQ(static_cast<regular_cell_t>(cell).second[0], expected_score - 10);
+        expected_score -= 2;
+    }
+}
+
+TEST_F(dp_vector_saturated_soa_test, assign)
+{
+    // Writes the values through the proxies and leaves the assigned cell unchanged.
+    dp_vector[0] = dp_vector[3];
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[0]).first[0], 94);
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[0]).second[0], 84);
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[3]).first[0], 94);
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[3]).second[0], 84);
+
+    dp_vector[1] = saturated_cell_t{saturated_score_t{5}, saturated_score_t{-7}};
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[1]).first[0], 105);
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[1]).second[0], 93);
+}
+
+TEST_F(dp_vector_saturated_soa_test, tuple_protocol)
+{
+    using proxy_t = soa_vector_t::reference;
+    EXPECT_EQ(std::tuple_size_v<proxy_t>, 2u);
+    EXPECT_TRUE((std::same_as<std::tuple_element_t<0, proxy_t>, saturated_score_t &>));
+    EXPECT_TRUE((std::same_as<std::tuple_element_t<1, soa_vector_t::const_reference>, saturated_score_t const &>));
+
+    auto [best, gap] = dp_vector.base()[2];
+    EXPECT_EQ(best[0], -4);
+    EXPECT_EQ(gap[0], -14);
+
+    gap = saturated_score_t{7};
+    EXPECT_EQ(static_cast<regular_cell_t>(dp_vector[2]).second[0], 107);
+}
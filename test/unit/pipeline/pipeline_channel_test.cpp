@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <pairwise_aligner/pipeline/mpmc_queue.hpp>
+#include <pairwise_aligner/pipeline/pipeline_channel.hpp>
+#include <pairwise_aligner/pipeline/spsc_queue.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+template <typename queue_t>
+struct queue_test : public ::testing::Test
+{};
+
+using queue_types = ::testing::Types<pa::spsc_queue<std::unique_ptr<int>>, pa::mpmc_queue<std::unique_ptr<int>>>;
+TYPED_TEST_SUITE(queue_test, queue_types);
+
+TYPED_TEST(queue_test, fifo)
+{
+    TypeParam queue{3};
+    EXPECT_EQ(queue.capacity(), 4u);
+    EXPECT_FALSE(queue.try_pop().has_value());
+
+    for (int round = 0; round < 3; ++round) // Wraps around the ring buffer.
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            auto value = std::make_unique<int>(i);
+            EXPECT_TRUE(queue.try_push(value));
+            EXPECT_EQ(value, nullptr);
+        }
+
+        auto rejected_value = std::make_unique<int>(4);
+        EXPECT_FALSE(queue.try_push(rejected_value));
+        EXPECT_NE(rejected_value, nullptr); // The value is only moved if it was pushed.
+
+        for (int i = 0; i < 4; ++i)
+        {
+            std::optional<std::unique_ptr<int>> value = queue.try_pop();
+            ASSERT_TRUE(value.has_value());
+            EXPECT_EQ(**value, i);
+        }
+        EXPECT_FALSE(queue.try_pop().has_value());
+    }
+}
+
+template <typename channel_t>
+void check_transfer(size_t const producer_count, size_t const consumer_count)
+{
+    size_t const value_count = 10000;
+    channel_t channel{8};
+    for (size_t i = 0; i < producer_count; ++i)
+        channel.add_producer();
+    for (size_t i = 0; i < consumer_count; ++i)
+        channel.add_consumer();
+
+    std::vector<std::vector<size_t>> received(consumer_count);
+    {
+        std::vector<std::jthread> threads{};
+        for (size_t producer_idx = 0; producer_idx < producer_count; ++producer_idx)
+        {
+            threads.emplace_back([&, producer_idx] () {
+                for (size_t value = producer_idx; value < value_count; value += producer_count)
+                    EXPECT_TRUE(channel.push(value));
+                channel.remove_producer();
+            });
+        }
+
+        for (size_t consumer_idx = 0; consumer_idx < consumer_count; ++consumer_idx)
+        {
+            threads.emplace_back([&, consumer_idx] () {
+                while (std::optional<size_t> value = channel.pop())
+                    received[consumer_idx].push_back(*value);
+            });
+        }
+    }
+
+    std::vector<size_t> count(value_count, 0);
+    for (std::vector<size_t> const & values : received)
+        for (size_t value : values)
+            ++count[value];
+
+    for (size_t value = 0; value < value_count; ++value)
+        EXPECT_EQ(count[value], 1u) << value;
+
+    if (producer_count == 1 && consumer_count == 1)
+    {
+        EXPECT_TRUE(std::ranges::is_sorted(received[0]));
+    }
+}
+
+TEST(pipeline_channel, spsc_transfer)
+{
+    check_transfer<pa::spsc_channel<size_t>>(1, 1);
+}
+
+TEST(pipeline_channel, mpmc_transfer)
+{
+    check_transfer<pa::pipeline_channel<size_t>>(1, 1);
+    check_transfer<pa::pipeline_channel<size_t>>(4, 3);
+}
+
+TEST(pipeline_channel, spsc_rejects_second_thread)
+{
+    pa::spsc_channel<int> channel{4};
+    channel.add_producer();
+    channel.add_consumer();
+    EXPECT_THROW(channel.add_producer(), std::invalid_argument);
+    EXPECT_THROW(channel.add_consumer(), std::invalid_argument);
+}
+
+TEST(pipeline_channel, close_and_cancel)
+{
+    pa::pipeline_channel<int> closed_channel{4};
+    closed_channel.add_producer();
+    EXPECT_TRUE(closed_channel.push(1));
+    closed_channel.remove_producer();
+    EXPECT_FALSE(closed_channel.push(2));
+    EXPECT_EQ(closed_channel.pop(), 1); // The remaining values are received after closing.
+    EXPECT_FALSE(closed_channel.pop().has_value());
+
+    pa::pipeline_channel<int> cancelled_channel{2};
+    cancelled_channel.add_producer();
+    EXPECT_TRUE(cancelled_channel.push(1));
+    EXPECT_TRUE(cancelled_channel.push(2));
+    std::jthread canceller{[&] () { cancelled_channel.cancel(); }};
+    EXPECT_FALSE(cancelled_channel.push(3)); // Waits on the full channel until it is cancelled.
+    EXPECT_FALSE(cancelled_channel.pop().has_value());
+    EXPECT_TRUE(cancelled_channel.is_cancelled());
+}
@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pairwise_aligner/pipeline/pipeline.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+TEST(pipeline, stages)
+{
+    size_t const item_count = 5000;
+    pa::pipeline_channel<size_t> numbers{16};
+    pa::pipeline_channel<size_t> squares{16};
+    pa::spsc_channel<std::string> texts{4};
+
+    std::atomic<size_t> transform_count{0};
+    std::vector<std::string> received{};
+
+    pa::pipeline pipe{};
+    pipe.add_source("count", numbers, [&] (auto emit) {
+        for (size_t number = 0; number < item_count && emit(number); ++number)
+        {}
+    });
+    pipe.add_stage("square", 3, numbers, squares, [&] () {
+        ++transform_count;
+        return [] (size_t const number) { return number * number; };
+    });
+    pipe.add_stage("format", 1, squares, texts, [] () {
+        return [] (size_t const square) { return std::to_string(square); };
+    });
+    pipe.add_sink("collect", texts, [&] (std::string text) { received.push_back(std::move(text)); });
+    pipe.run();
+
+    EXPECT_EQ(transform_count.load(), 3u); // Every thread creates its own transformation.
+
+    std::vector<size_t> squared_numbers{};
+    for (std::string const & text : received)
+        squared_numbers.push_back(std::stoul(text));
+    std::ranges::sort(squared_numbers);
+
+    ASSERT_EQ(squared_numbers.size(), item_count);
+    for (size_t number = 0; number < item_count; ++number)
+        EXPECT_EQ(squared_numbers[number], number * number);
+
+    std::vector<pa::pipeline_stage_statistics> const statistics = pipe.statistics();
+    ASSERT_EQ(statistics.size(), 4u);
+    EXPECT_EQ(statistics[0].name, "count");
+    EXPECT_EQ(statistics[1].name, "square");
+    EXPECT_EQ(statistics[1].thread_count, 3u);
+    for (pa::pipeline_stage_statistics const & stage_statistics : statistics)
+    {
+        EXPECT_EQ(stage_statistics.item_count, item_count);
+        EXPECT_GE(stage_statistics.busy_seconds, 0.0);
+        EXPECT_GE(stage_statistics.input_wait_seconds, 0.0);
+        EXPECT_GE(stage_statistics.output_wait_seconds, 0.0);
+    }
+
+    EXPECT_THROW(pipe.run(), std::logic_error);
+}
+
+TEST(pipeline, error_cancels_stages)
+{
+    pa::pipeline_channel<size_t> numbers{4};
+    pa::pipeline_channel<size_t> checked_numbers{4};
+    std::atomic<size_t> emitted_count{0};
+
+    pa::pipeline pipe{};
+    pipe.add_source("count", numbers, [&] (auto emit) {
+        for (size_t number = 0; emit(number); ++number) // Produces items until the pipeline is cancelled.
+            ++emitted_count;
+    });
+    pipe.add_stage("check", 2, numbers, checked_numbers, [] () {
+        return [] (size_t const number) {
+            if (number == 100)
+                throw std::runtime_error{"invalid number"};
+            return number;
+        };
+    });
+    pipe.add_sink("drop", checked_numbers, [] (size_t) {});
+
+    EXPECT_THROW(pipe.run(), std::runtime_error);
+    EXPECT_TRUE(pipe.is_cancelled());
+    EXPECT_GE(emitted_count.load(), 100u);
+}
+
+TEST(pipeline, invalid_stage)
+{
+    pa::spsc_channel<int> input{4};
+    pa::spsc_channel<int> output{4};
+
+    pa::pipeline pipe{};
+    EXPECT_THROW(pipe.add_stage("none", 0, input, output, [] () { return [] (int i) { return i; }; }),
+                 std::invalid_argument);
+    EXPECT_THROW(pipe.add_stage("many", 2, input, output, [] () { return [] (int i) { return i; }; }),
+                 std::invalid_argument);
+}
@@ -0,0 +1,239 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/method_local.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/runtime/aligner.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct runtime_aligner_test : public ::testing::Test
+{
+    std::vector<std::string> sequences1{};
+    std::vector<std::string> sequences2{};
+
+    void SetUp() override
+    {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<size_t> size_distribution{10, 120};
+        std::uniform_int_distribution<size_t> symbol_distribution{0, pa::blosum62_standard<int32_t>.size() - 1};
+
+        auto generate_sequence = [&] () {
+            std::string sequence(size_distribution(random_engine), ' ');
+            std::ranges::generate(sequence, [&] () {
+                return pa::blosum62_standard<int32_t>[symbol_distribution(random_engine)].first;
+            });
+            return sequence;
+        };
+
+        // Use a number of pairs which is not a multiple of any bulk size.
+        for (size_t i = 0; i < 150; ++i) {
+            sequences1.push_back(generate_sequence());
+            sequences2.push_back(generate_sequence());
+        }
+    }
+
+    std::vector<std::string_view> views(std::vector<std::string> const & sequences) const
+    {
+        return std::vector<std::string_view>(sequences.begin(), sequences.end());
+    }
+
+    // Views of the same first sequence in runs of 40 pairs, which the simd_1xN engine computes together.
+    std::vector<std::string_view> first_sequence_runs() const
+    {
+        std::vector<std::string_view> first{};
+        for (size_t i = 0; i < sequences1.size(); ++i)
+            first.push_back(sequences1[i / 40]);
+        return first;
+    }
+
+    template <typename method_t>
+    void expect_scores(pa::runtime::aligner_parameters const & parameters, method_t const & method) const
+    {
+        expect_scores(parameters, method, views(sequences1));
+    }
+
+    template <typename method_t>
+    void expect_scores(pa::runtime::aligner_parameters const & parameters,
+                       method_t const & method,
+                       std::vector<std::string_view> const & first) const
+    {
+        auto scalar_aligner = pa::cfg::configure_aligner(
+                                pa::cfg::score_model_matrix(method, pa::blosum62_standard<int32_t>));
+
+        pa::runtime::aligner aligner{parameters};
+        std::vector<int32_t> scores = aligner.compute(first, views(sequences2));
+
+        ASSERT_EQ(scores.size(), first.size());
+        for (size_t i = 0; i < scores.size(); ++i)
+            EXPECT_EQ(scores[i], scalar_aligner.compute(first[i], sequences2[i]).score()) << "index: " << i;
+    }
+};
+
+TEST_F(runtime_aligner_test, global_int8_saturated)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.precision = pa::runtime::score_precision::int8_saturated;
+
+    expect_scores(parameters, pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                                     pa::cfg::leading_end_gap{},
+                                                     pa::cfg::trailing_end_gap{}));
+}
+
+TEST_F(runtime_aligner_test, global_int16_free_end_gaps)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.precision = pa::runtime::score_precision::int16;
+    parameters.leading_end_gap = {.first_column = pa::cfg::end_gap::free, .first_row = pa::cfg::end_gap::free};
+    parameters.trailing_end_gap = {.last_column = pa::cfg::end_gap::free, .last_row = pa::cfg::end_gap::free};
+
+    expect_scores(parameters, pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                                     parameters.leading_end_gap,
+                                                     parameters.trailing_end_gap));
+}
+
+TEST_F(runtime_aligner_test, local_int32)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.method = pa::runtime::alignment_method::local;
+    parameters.precision = pa::runtime::score_precision::int32;
+    parameters.gap_open_score = -5;
+    parameters.gap_extension_score = -2;
+
+    expect_scores(parameters, pa::cfg::method_local(pa::cfg::gap_model_affine(-5, -2)));
+}
+
+TEST_F(runtime_aligner_test, global_scalar)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.engine = pa::runtime::alignment_engine::scalar;
+
+    expect_scores(parameters, pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                                     pa::cfg::leading_end_gap{},
+                                                     pa::cfg::trailing_end_gap{}));
+}
+
+TEST_F(runtime_aligner_test, global_simd_1xN)
+{
+    // Use runs of the same first sequence with different lengths.
+    std::vector<std::string_view> const first = first_sequence_runs();
+
+    pa::runtime::aligner_parameters parameters{};
+    parameters.engine = pa::runtime::alignment_engine::simd_1xN;
+
+    expect_scores(parameters,
+                  pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                         pa::cfg::leading_end_gap{},
+                                         pa::cfg::trailing_end_gap{}),
+                  first);
+
+    // The simd_1xN engine only computes saturated 8-bit scores.
+    for (auto precision : {pa::runtime::score_precision::int16, pa::runtime::score_precision::int32})
+    {
+        parameters.precision = precision;
+        EXPECT_THROW(pa::runtime::aligner{parameters}, std::invalid_argument);
+    }
+}
+
+TEST_F(runtime_aligner_test, global_group_by_length)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.group_by_length = true;
+
+    expect_scores(parameters, pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                                     pa::cfg::leading_end_gap{},
+                                                     pa::cfg::trailing_end_gap{}));
+}
+
+TEST_F(runtime_aligner_test, bulk_size)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.precision = pa::runtime::score_precision::int32;
+    EXPECT_GT(pa::runtime::aligner{parameters}.bulk_size(), 0u);
+
+    parameters.engine = pa::runtime::alignment_engine::scalar;
+    EXPECT_EQ(pa::runtime::aligner{parameters}.bulk_size(), 1u);
+}
+
+TEST_F(runtime_aligner_test, unknown_substitution_matrix)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.substitution_matrix = "pam250";
+
+    EXPECT_THROW(pa::runtime::aligner{parameters}, std::invalid_argument);
+}
+
+TEST_F(runtime_aligner_test, size_mismatch)
+{
+    pa::runtime::aligner aligner{pa::runtime::aligner_parameters{}};
+    std::vector<std::string_view> first = views(sequences1);
+    std::vector<std::string_view> second = views(sequences2);
+    std::vector<int32_t> scores(first.size() - 1);
+
+    EXPECT_THROW(aligner.compute(first, second, scores), std::invalid_argument);
+    second.pop_back();
+    EXPECT_THROW(aligner.compute(first, second), std::invalid_argument);
+}
+
+TEST_F(runtime_aligner_test, prepared_pairs)
+{
+    // Use runs of the same first sequence for the simd_1xN engine.
+    std::vector<std::string_view> const first = first_sequence_runs();
+    std::vector<std::string_view> const second = views(sequences2);
+
+    for (auto engine : {pa::runtime::alignment_engine::scalar,
+                        pa::runtime::alignment_engine::simd_NxN,
+                        pa::runtime::alignment_engine::simd_1xN})
+    {
+        for (bool group_by_length : {false, true})
+        {
+            pa::runtime::aligner_parameters parameters{};
+            parameters.engine = engine;
+            parameters.group_by_length = group_by_length;
+
+            // Prepare and compute with different aligners as in separate stages of a pipeline.
+            pa::runtime::aligner const preparing_aligner{parameters};
+            pa::runtime::prepared_pairs const pairs = preparing_aligner.prepare(first, second);
+            ASSERT_EQ(pairs.size(), first.size());
+
+            pa::runtime::aligner computing_aligner{parameters};
+            std::vector<int32_t> scores(pairs.size());
+            computing_aligner.compute(pairs, scores);
+
+            EXPECT_EQ(scores, computing_aligner.compute(first, second));
+        }
+    }
+}
+
+TEST_F(runtime_aligner_test, prepared_pairs_of_other_engine)
+{
+    pa::runtime::aligner_parameters parameters{};
+    parameters.engine = pa::runtime::alignment_engine::scalar;
+    pa::runtime::prepared_pairs const pairs = pa::runtime::aligner{parameters}.prepare(views(sequences1),
+                                                                                      views(sequences2));
+
+    parameters.engine = pa::runtime::alignment_engine::simd_NxN;
+    pa::runtime::aligner aligner{parameters};
+    std::vector<int32_t> scores(pairs.size());
+    EXPECT_THROW(aligner.compute(pairs, scores), std::invalid_argument);
+
+    scores.pop_back();
+    EXPECT_THROW(aligner.compute(pairs, scores), std::invalid_argument);
+}
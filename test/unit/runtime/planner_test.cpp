@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/configuration/saturated_block_handler.hpp>
+#include <pairwise_aligner/runtime/planner.hpp>
+
+namespace rt = seqan::pairwise_aligner::runtime;
+using handler_t = seqan::pairwise_aligner::cfg::detail::saturated_block_handler;
+
+TEST(planner_test, collect_batch_statistics)
+{
+    std::string const query{"ACGT"};
+    std::vector<std::string_view> sequences1{query, query, query};
+    std::vector<std::string_view> sequences2{"AC", "ACGTAC", "ACGT"};
+
+    rt::batch_statistics statistics = rt::collect_batch_statistics(sequences1, sequences2);
+    EXPECT_EQ(statistics.pair_count, 3u);
+    EXPECT_EQ(statistics.min_length, 2u);
+    EXPECT_EQ(statistics.max_length, 6u);
+    EXPECT_DOUBLE_EQ(statistics.mean_length, 4.0);
+    EXPECT_TRUE(statistics.one_vs_many);
+
+    sequences1[1] = "ACGA";
+    EXPECT_FALSE(rt::collect_batch_statistics(sequences1, sequences2).one_vs_many);
+
+    // Equal but distinct sequences are not computed together.
+    std::string const query_copy{query};
+    sequences1[1] = query_copy;
+    EXPECT_FALSE(rt::collect_batch_statistics(sequences1, sequences2).one_vs_many);
+
+    sequences2.pop_back();
+    EXPECT_THROW(rt::collect_batch_statistics(sequences1, sequences2), std::invalid_argument);
+}
+
+TEST(planner_test, saturated_for_moderate_scores)
+{
+    rt::batch_statistics statistics{.pair_count = 10000, .min_length = 100, .max_length = 100, .mean_length = 100};
+
+    rt::aligner_parameters parameters = rt::plan_aligner(rt::aligner_parameters{}, statistics);
+    EXPECT_EQ(parameters.engine, rt::alignment_engine::simd_NxN);
+    EXPECT_EQ(parameters.precision, rt::score_precision::int8_saturated);
+    EXPECT_FALSE(parameters.group_by_length);
+}
+
+TEST(planner_test, saturated_follows_engine_block_size)
+{
+    rt::batch_statistics statistics{.pair_count = 10000, .min_length = 100, .max_length = 100, .mean_length = 100};
+    rt::aligner_parameters parameters{};
+    parameters.gap_open_score = -100;
+    parameters.gap_extension_score = -20;
+
+    // The saturated engine sizes its blocks by the mismatch scores of blosum62, which bound the blocks of any gap
+    // scores, such that the planner keeps the saturated precision.
+    auto [zero_offset, block_size] = handler_t::compute_max_block_size(11, -4, 100, 20);
+    EXPECT_GE(block_size, 8u);
+    EXPECT_TRUE(handler_t::is_viable_block_size(11, -4, 100, 20, block_size));
+    EXPECT_FALSE(handler_t::is_viable_block_size(11, -4, 100, 20, block_size + 1));
+    EXPECT_EQ(rt::plan_aligner(parameters, statistics).precision, rt::score_precision::int8_saturated);
+}
+
+TEST(planner_test, saturated_NxN_for_large_alphabets)
+{
+    rt::batch_statistics statistics{.pair_count = 10000, .min_length = 100, .max_length = 100, .mean_length = 100};
+    rt::aligner_parameters parameters{};
+    parameters.substitution_matrix = "blosum62_extended";
+
+    // The triangular score matrix of the extended alphabet exceeds 256 entries.
+    EXPECT_TRUE(handler_t::is_NxN_alphabet_supported(21));
+    EXPECT_EQ(handler_t::is_NxN_alphabet_supported(27),
+              seqan::pairwise_aligner::tuning::profile::saturated_NxN_gather_by_rank);
+
+    parameters = rt::plan_aligner(parameters, statistics);
+    EXPECT_EQ(parameters.engine, rt::alignment_engine::simd_NxN);
+    EXPECT_EQ(parameters.precision, handler_t::is_NxN_alphabet_supported(27) ? rt::score_precision::int8_saturated
+                                                                             : rt::score_precision::int16);
+}
+
+TEST(planner_test, engine)
+{
+    rt::batch_statistics statistics{.pair_count = 1000, .min_length = 100, .max_length = 100, .mean_length = 100};
+
+    statistics.one_vs_many = true;
+    EXPECT_EQ(rt::plan_aligner(rt::aligner_parameters{}, statistics).engine, rt::alignment_engine::simd_1xN);
+
+    statistics.one_vs_many = false;
+    statistics.pair_count = 1;
+    EXPECT_EQ(rt::plan_aligner(rt::aligner_parameters{}, statistics).engine, rt::alignment_engine::scalar);
+}
+
+TEST(planner_test, group_by_length)
+{
+    rt::batch_statistics statistics{.pair_count = 1000,
+                                    .min_length = 10,
+                                    .max_length = 1000,
+                                    .mean_length = 200,
+                                    .length_deviation = 150};
+
+    EXPECT_TRUE(rt::plan_aligner(rt::aligner_parameters{}, statistics).group_by_length);
+}
+
+TEST(planner_test, log)
+{
+    std::ostringstream log{};
+    rt::plan_aligner(rt::aligner_parameters{}, rt::batch_statistics{.pair_count = 100}, &log);
+    EXPECT_NE(log.str().find("engine=simd_NxN"), std::string::npos);
+
+    rt::aligner_parameters parameters{};
+    parameters.substitution_matrix = "pam250";
+    EXPECT_THROW(rt::plan_aligner(parameters, rt::batch_statistics{}), std::invalid_argument);
+}
@@ -142,3 +142,35 @@ TYPED_TEST(score_model_matrix_simd_test, access_rotate)
         }
     }
 }
+
+TYPED_TEST(score_model_matrix_simd_test, access_positions)
+{
+    using simd_index_t = typename TestFixture::simd_index_t;
+    using scalar_score_t = typename TestFixture::scalar_score_t;
+
+    // Every position and lane holds a different symbol.
+    size_t const sequence_size = TestFixture::stride * 3;
+    std::vector<simd_index_t> symbols(sequence_size);
+    for (size_t i = 0; i < sequence_size; ++i)
+        for (int8_t k = 0; k < TestFixture::simd_size; ++k)
+            symbols[i][k] = static_cast<int8_t>((i + k) % TestFixture::dimension);
+
+    auto profile = this->matrix.initialise_profile(symbols);
+    auto slice = profile.slice(TestFixture::stride, TestFixture::stride);
+    ASSERT_EQ(profile.size(), sequence_size);
+    ASSERT_EQ(slice.size(), TestFixture::stride);
+
+    for (size_t i = 0; i < sequence_size; ++i) {
+        for (size_t r = 0; r < TestFixture::dimension; ++r) {
+            for (int8_t k = 0; k < TestFixture::simd_size; ++k) {
+                EXPECT_EQ(profile[i][r][k], pa::blosum62_standard<scalar_score_t>[r].second[symbols[i][k]])
+                          << "i = " << i << " rank_r = " << r << " k = " << (int32_t) k << "\n";
+            }
+        }
+    }
+
+    for (size_t i = 0; i < slice.size(); ++i)
+        for (size_t r = 0; r < TestFixture::dimension; ++r)
+            for (int8_t k = 0; k < TestFixture::simd_size; ++k)
+                EXPECT_EQ(slice[i][r][k], profile[TestFixture::stride + i][r][k]);
+}
@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+
+#include <pairwise_aligner/score_model/score_model_matrix_simd_gather_NxN.hpp>
+#include <pairwise_aligner/simd/simd_score_type.hpp>
+
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+template <typename scalar_score_t>
+struct score_model_matrix_simd_gather_test : public testing::Test
+{
+    using matrix_t = std::remove_cvref_t<decltype(pa::blosum62_standard<scalar_score_t>)>;
+
+    static constexpr size_t dimension = std::tuple_size_v<matrix_t>;
+
+    using simd_score_t = pa::simd_score<scalar_score_t>;
+    using simd_index_t = pa::detail::make_unsigned_t<simd_score_t>;
+    using score_model_t = pa::score_model_matrix_simd_gather_NxN<simd_score_t, simd_index_t, dimension>;
+
+    score_model_t matrix;
+
+    void SetUp() override
+    {
+        std::array<std::array<scalar_score_t, dimension>, dimension> tmp{};
+
+        for (size_t i = 0; i < dimension; ++i)
+            std::ranges::copy(pa::blosum62_standard<scalar_score_t>[i].second, tmp[i].data());
+
+        matrix = score_model_t{tmp}; // construct the scoring matrix scheme.
+    }
+};
+
+using scalar_score_types = ::testing::Types<int8_t>;
+
+TYPED_TEST_SUITE(score_model_matrix_simd_gather_test, scalar_score_types);
+
+// ----------------------------------------------------------------------------
+// Test Cases
+// ----------------------------------------------------------------------------
+
+TYPED_TEST(score_model_matrix_simd_gather_test, access_same)
+{
+    using simd_score_t = typename TestFixture::simd_score_t;
+    using scalar_score_t = typename simd_score_t::value_type;
+
+    using simd_index_t = typename TestFixture::simd_index_t;
+    using scalar_rank_t = typename simd_index_t::value_type;
+
+    for (scalar_rank_t c = 0; c < static_cast<scalar_rank_t>(TestFixture::dimension); ++c)
+    {
+        simd_index_t column_rank{c};
+
+        for (scalar_rank_t r = 0; r < static_cast<scalar_rank_t>(TestFixture::dimension); ++r)
+        {
+            simd_index_t row_rank{r};
+            simd_score_t scores = this->matrix.score(simd_score_t{}, column_rank, row_rank);
+
+            for (size_t k = 0; k < simd_score_t::size_v; ++k) {
+                EXPECT_EQ((int32_t) scores[k], (int32_t) pa::blosum62_standard<scalar_score_t>[r].second[c])
+                            << "k = " << (int32_t) k << " "
+                            << "rank_c = " << (int32_t) c << " "
+                            << "rank_r = " << (int32_t) r << "\n";
+            }
+        }
+    }
+}
+
+TYPED_TEST(score_model_matrix_simd_gather_test, access_rotate)
+{
+    using simd_score_t = typename TestFixture::simd_score_t;
+    using scalar_score_t = typename simd_score_t::value_type;
+
+    using simd_index_t = typename TestFixture::simd_index_t;
+    using scalar_rank_t = typename simd_index_t::value_type;
+
+    std::vector<scalar_rank_t> symbols{};
+    symbols.resize(TestFixture::dimension);
+    std::iota(symbols.begin(), symbols.end(), 0);
+
+    for (size_t cycle = 0; cycle < symbols.size(); ++cycle)
+    {
+        simd_index_t column_rank{};
+        simd_index_t row_rank{};
+        for (size_t k = 0; k < simd_score_t::size_v; ++k) {
+            column_rank[k] = symbols[(k + cycle) % symbols.size()];
+            row_rank[k] = symbols[(k * 5 + cycle) % symbols.size()];
+        }
+
+        auto scores = this->matrix.score(simd_score_t{1}, column_rank, row_rank);
+
+        for (size_t k = 0; k < simd_score_t::size_v; ++k) {
+            EXPECT_EQ((int32_t) scores[k],
+                      (int32_t) pa::blosum62_standard<scalar_score_t>[row_rank[k]].second[column_rank[k]] + 1)
+                    << "k = " << (int32_t) k << " "
+                    << "rank_c = " << (int32_t) column_rank[k] << " "
+                    << "rank_r = " << (int32_t) row_rank[k] << " "
+                    << "cycle = " << (int32_t) cycle << "\n";
+        }
+    }
+}
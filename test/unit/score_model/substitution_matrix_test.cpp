@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <utility>
+
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+#include <pairwise_aligner/utility/static_value.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+TEST(substitution_matrix_test, is_builtin)
+{
+    static_assert(pa::detail::is_builtin_substitution_matrix(pa::blosum62_standard<int8_t>));
+    static_assert(pa::detail::is_builtin_substitution_matrix(pa::blosum62_standard<int32_t>));
+    static_assert(pa::detail::is_builtin_substitution_matrix(pa::blosum62_extended<int8_t>));
+    static_assert(pa::detail::is_builtin_substitution_matrix(pa::blosum62_extended<int32_t>));
+
+    auto matrix = pa::blosum62_standard<int8_t>;
+    EXPECT_TRUE(pa::detail::is_builtin_substitution_matrix(matrix));
+
+    matrix[3].second[4] = 7;
+    EXPECT_FALSE(pa::detail::is_builtin_substitution_matrix(matrix));
+
+    std::array<std::pair<char, std::array<int8_t, 2>>, 2> custom{{{'A', {1, -1}}, {'B', {-1, 1}}}};
+    EXPECT_FALSE(pa::detail::is_builtin_substitution_matrix(custom));
+}
+
+TEST(substitution_matrix_test, uses_builtin_tables)
+{
+    static_assert(pa::detail::uses_builtin_tables(pa::blosum62_standard<int8_t>, int8_t{1}, int8_t{-1}));
+    static_assert(pa::detail::uses_builtin_tables(pa::blosum62_extended<int32_t>, 1, -1));
+    static_assert(pa::detail::uses_builtin_tables(pa::blosum62_standard<float>, 1.0f, -1.0f));
+
+    EXPECT_FALSE(pa::detail::uses_builtin_tables(pa::blosum62_standard<int8_t>, int8_t{2}, int8_t{-1}));
+    EXPECT_FALSE(pa::detail::uses_builtin_tables(pa::blosum62_standard<int8_t>, int8_t{1}, int8_t{-2}));
+
+    std::array<std::pair<char, std::array<int8_t, 2>>, 2> custom{{{'A', {1, -1}}, {'B', {-1, 1}}}};
+    EXPECT_FALSE(pa::detail::uses_builtin_tables(custom, int8_t{1}, int8_t{-1}));
+}
+
+TEST(substitution_matrix_test, static_value)
+{
+    int invocation_count{};
+    auto factory = [&] () { return ++invocation_count; };
+
+    int const & first = pa::detail::static_value(factory);
+    int const & second = pa::detail::static_value(factory);
+
+    EXPECT_EQ(invocation_count, 1);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(&first, &second);
+}
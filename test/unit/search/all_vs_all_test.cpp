@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+#include <pairwise_aligner/search/all_vs_all.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct all_vs_all_test : public ::testing::Test
+{
+    std::vector<std::string> sequences{};
+
+    static constexpr auto method()
+    {
+        return pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                      pa::cfg::leading_end_gap{},
+                                      pa::cfg::trailing_end_gap{});
+    }
+
+    static auto simd_aligner()
+    {
+        return pa::cfg::configure_aligner(
+            pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<int32_t>));
+    }
+
+    void SetUp() override
+    {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<size_t> size_distribution{5, 150};
+        std::string_view const symbols{"ARNDCQEGHILKMFPSTWYV"};
+        std::uniform_int_distribution<size_t> symbol_distribution{0, symbols.size() - 1};
+
+        // More sequences than fit into three bulks, such that the last bulk is not full.
+        for (size_t i = 0; i < 3 * simd_aligner().bulk_size() + 5; ++i)
+        {
+            std::string & sequence = sequences.emplace_back(size_distribution(random_engine), ' ');
+            for (char & symbol : sequence)
+                symbol = symbols[symbol_distribution(random_engine)];
+        }
+    }
+
+    void expect_scores(pa::triangular_score_matrix const & scores) const
+    {
+        auto scalar_aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix(method(),
+                                                                                      pa::blosum62_standard<int32_t>));
+        for (size_t row = 0; row < sequences.size(); ++row)
+            for (size_t column = row; column < sequences.size(); ++column)
+                EXPECT_EQ(scores(row, column), scalar_aligner.compute(sequences[row], sequences[column]).score())
+                    << "pair: (" << row << ", " << column << ")";
+    }
+};
+
+TEST_F(all_vs_all_test, in_memory)
+{
+    for (size_t thread_count : {1, 3})
+    {
+        for (size_t tile_bulk_count : {1, 2})
+        {
+            pa::triangular_score_matrix scores{sequences.size()};
+            pa::compute_all_vs_all(simd_aligner(), sequences, scores,
+                                   {.thread_count = thread_count, .tile_bulk_count = tile_bulk_count});
+            expect_scores(scores);
+        }
+    }
+}
+
+TEST_F(all_vs_all_test, mapped_file)
+{
+    std::filesystem::path const file_path{std::filesystem::temp_directory_path() / "all_vs_all_test.bin"};
+    {
+        pa::triangular_score_matrix scores{sequences.size(), file_path};
+        pa::compute_all_vs_all(simd_aligner(), sequences, scores, {.thread_count = 2});
+        scores.flush();
+        expect_scores(scores);
+    }
+    std::filesystem::remove(file_path);
+}
+
+TEST_F(all_vs_all_test, invalid_arguments)
+{
+    pa::triangular_score_matrix scores{sequences.size() - 1};
+    EXPECT_THROW(pa::compute_all_vs_all(simd_aligner(), sequences, scores), std::invalid_argument);
+
+    pa::triangular_score_matrix matching_scores{sequences.size()};
+    EXPECT_THROW(pa::compute_all_vs_all(simd_aligner(), sequences, matching_scores, {.thread_count = 0}),
+                 std::invalid_argument);
+}
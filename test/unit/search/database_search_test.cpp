@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+#include <pairwise_aligner/search/database_search.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct database_search_test : public ::testing::Test
+{
+    std::string query{"MKTAYIAKQRQISFVKSHFSRQLEERLGLIEVQAPILSRVGDGTQDNLSGAEKAVQVKVKALPDAQ"};
+    std::vector<std::string> database{};
+    std::filesystem::path database_path{std::filesystem::temp_directory_path() / "database_search_test.padb"};
+
+    static constexpr auto method()
+    {
+        // The local saturated matrix engines are not functional yet, such that the search uses semi-global alignments.
+        return pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                      pa::cfg::leading_end_gap{.first_column = pa::cfg::end_gap::free},
+                                      pa::cfg::trailing_end_gap{.last_column = pa::cfg::end_gap::free});
+    }
+
+    static auto simd_aligner()
+    {
+        return pa::cfg::configure_aligner(
+            pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<int32_t>));
+    }
+
+    void SetUp() override
+    {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<size_t> size_distribution{10, 200};
+        std::string_view const symbols{"ARNDCQEGHILKMFPSTWYV"};
+        std::uniform_int_distribution<size_t> symbol_distribution{0, symbols.size() - 1};
+
+        // Random sequences, some of them containing parts of the query, which score higher.
+        for (size_t i = 0; i < 5 * simd_aligner().bulk_size() + 7; ++i)
+        {
+            std::string & sequence = database.emplace_back(size_distribution(random_engine), ' ');
+            for (char & symbol : sequence)
+                symbol = symbols[symbol_distribution(random_engine)];
+
+            if (i % 13 == 0)
+                sequence += query.substr(i % 20, 10 + i % 40);
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(database_path);
+    }
+
+    std::vector<pa::search_hit> expected_hits(size_t const hit_count) const
+    {
+        return expected_hits(query, hit_count);
+    }
+
+    std::vector<pa::search_hit> expected_hits(std::string const & first_sequence, size_t const hit_count) const
+    {
+        auto scalar_aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix(method(),
+                                                                                      pa::blosum62_standard<int32_t>));
+        std::vector<pa::search_hit> hits{};
+        for (size_t i = 0; i < database.size(); ++i)
+            hits.push_back({scalar_aligner.compute(first_sequence, database[i]).score(), i});
+
+        std::ranges::sort(hits, [] (pa::search_hit const & lhs, pa::search_hit const & rhs) {
+            return lhs.ranks_before(rhs);
+        });
+        hits.resize(std::min(hit_count, hits.size()));
+        return hits;
+    }
+};
+
+TEST_F(database_search_test, top_hits)
+{
+    auto aligner = simd_aligner();
+    pa::write_sequence_database(database_path, aligner, database);
+    auto sequence_database = pa::open_sequence_database(database_path, aligner);
+
+    for (size_t thread_count : {1, 2, 4})
+    {
+        std::vector<pa::search_hit> hits =
+            pa::search_database(aligner, sequence_database, query, {.hit_count = 15, .thread_count = thread_count});
+        EXPECT_EQ(hits, expected_hits(15)) << "thread_count: " << thread_count;
+    }
+
+    // More hits than sequences returns all sequences.
+    std::vector<pa::search_hit> all_hits =
+        pa::search_database(aligner, sequence_database, query, {.hit_count = 1000, .thread_count = 3});
+    EXPECT_EQ(all_hits, expected_hits(database.size()));
+}
+
+TEST_F(database_search_test, many_queries)
+{
+    auto aligner = simd_aligner();
+    pa::write_sequence_database(database_path, aligner, database);
+    auto sequence_database = pa::open_sequence_database(database_path, aligner);
+
+    // Short peptides share the profiles of the database batches.
+    std::vector<std::string> queries{};
+    for (size_t i = 0; i + 12 <= query.size(); i += 9)
+        queries.push_back(query.substr(i, 12));
+
+    for (size_t thread_count : {1, 3})
+    {
+        std::vector<std::vector<pa::search_hit>> hits =
+            pa::search_database(aligner, sequence_database, queries, {.hit_count = 5, .thread_count = thread_count});
+        ASSERT_EQ(hits.size(), queries.size());
+        for (size_t i = 0; i < queries.size(); ++i)
+            EXPECT_EQ(hits[i], expected_hits(queries[i], 5)) << "query: " << i << " thread_count: " << thread_count;
+    }
+}
+
+TEST_F(database_search_test, invalid_thread_count)
+{
+    auto aligner = simd_aligner();
+    pa::write_sequence_database(database_path, aligner, database);
+    auto sequence_database = pa::open_sequence_database(database_path, aligner);
+
+    EXPECT_THROW(pa::search_database(aligner, sequence_database, query, {.hit_count = 1, .thread_count = 0}),
+                 std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <pairwise_aligner/search/top_k_hits.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+TEST(top_k_hits_test, insert)
+{
+    pa::top_k_hits hits{3};
+    EXPECT_EQ(hits.k(), 3u);
+    EXPECT_EQ(hits.threshold(), std::numeric_limits<int32_t>::lowest());
+
+    EXPECT_TRUE(hits.insert({5, 0}));
+    EXPECT_TRUE(hits.insert({-2, 1}));
+    EXPECT_TRUE(hits.insert({7, 2}));
+    EXPECT_TRUE(hits.full());
+    EXPECT_EQ(hits.threshold(), -2);
+
+    EXPECT_FALSE(hits.insert({-3, 3}));
+    EXPECT_TRUE(hits.insert({5, 4}));
+    EXPECT_EQ(hits.threshold(), 5);
+    EXPECT_FALSE(hits.insert({5, 6})); // Same score, but the higher index ranks last.
+    EXPECT_TRUE(hits.insert({5, 1}));
+
+    std::vector<pa::search_hit> const expected{{7, 2}, {5, 0}, {5, 1}};
+    EXPECT_EQ(hits.sorted_hits(), expected);
+}
+
+TEST(top_k_hits_test, zero_k)
+{
+    pa::top_k_hits hits{0};
+    EXPECT_FALSE(hits.insert({100, 0}));
+    EXPECT_EQ(hits.size(), 0u);
+    EXPECT_TRUE(hits.sorted_hits().empty());
+}
+
+TEST(top_k_hits_test, merge)
+{
+    std::mt19937 random_engine{42};
+    std::uniform_int_distribution<int32_t> score_distribution{-20, 20};
+    std::vector<pa::search_hit> all_hits{};
+    for (size_t i = 0; i < 500; ++i)
+        all_hits.push_back({score_distribution(random_engine), i});
+
+    pa::top_k_hits single{10};
+    std::vector<pa::top_k_hits> partial(4, pa::top_k_hits{10});
+    for (pa::search_hit const & hit : all_hits)
+    {
+        single.insert(hit);
+        partial[hit.sequence_index % partial.size()].insert(hit);
+    }
+
+    for (size_t i = 1; i < partial.size(); ++i)
+        partial[0].merge(partial[i]);
+
+    std::ranges::sort(all_hits, [] (pa::search_hit const & lhs, pa::search_hit const & rhs) {
+        return lhs.ranks_before(rhs);
+    });
+    all_hits.resize(10);
+
+    EXPECT_EQ(single.sorted_hits(), all_hits);
+    EXPECT_EQ(partial[0].sorted_hits(), all_hits);
+}
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#include <pairwise_aligner/io/mapped_file.hpp>
+#include <pairwise_aligner/search/triangular_score_matrix.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+TEST(triangular_score_matrix_test, entry_index)
+{
+    pa::triangular_score_matrix matrix{5};
+    EXPECT_EQ(matrix.sequence_count(), 5u);
+    EXPECT_EQ(matrix.scores().size(), 15u);
+
+    // Every pair maps to its own entry, row by row.
+    size_t expected_index = 0;
+    for (size_t row = 0; row < 5; ++row)
+    {
+        for (size_t column = row; column < 5; ++column, ++expected_index)
+        {
+            EXPECT_EQ(matrix.entry_index(row, column), expected_index);
+            EXPECT_EQ(matrix.entry_index(column, row), expected_index);
+        }
+    }
+
+    matrix(3, 1) = -7;
+    EXPECT_EQ(matrix(1, 3), -7);
+    EXPECT_EQ(std::as_const(matrix).scores()[matrix.entry_index(1, 3)], -7);
+}
+
+TEST(triangular_score_matrix_test, mapped_file)
+{
+    std::filesystem::path const file_path{std::filesystem::temp_directory_path() / "triangular_score_matrix.bin"};
+    {
+        pa::triangular_score_matrix matrix{4, file_path};
+        for (size_t row = 0; row < 4; ++row)
+            for (size_t column = row; column < 4; ++column)
+                matrix(row, column) = static_cast<int32_t>(10 * row + column);
+
+        pa::triangular_score_matrix moved{std::move(matrix)};
+        moved.flush();
+        EXPECT_EQ(moved(2, 3), 23);
+    }
+
+    pa::mapped_file file{file_path};
+    ASSERT_EQ(file.size(), 10 * sizeof(int32_t));
+    int32_t score{};
+    std::memcpy(&score, file.data() + 8 * sizeof(int32_t), sizeof(int32_t)); // The pair (2, 3).
+    EXPECT_EQ(score, 23);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(triangular_score_matrix_test, empty)
+{
+    std::filesystem::path const file_path{std::filesystem::temp_directory_path() / "triangular_score_matrix.bin"};
+    pa::triangular_score_matrix matrix{0, file_path};
+    EXPECT_TRUE(matrix.scores().empty());
+    EXPECT_NO_THROW(matrix.flush());
+    std::filesystem::remove(file_path);
+}
@@ -0,0 +1,87 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/sequence/packed_dna_sequence.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+TEST(packed_dna_sequence_test, decode)
+{
+    std::string const sequence{"ACGTacgtuNRACGTACGTACGTACGTACGTACGTTTTTGGGGG"};
+    pa::packed_dna_sequence const packed{sequence};
+
+    EXPECT_TRUE(std::ranges::random_access_range<pa::packed_dna_sequence const>);
+    ASSERT_EQ(packed.size(), sequence.size());
+    EXPECT_EQ(packed.words().size(), 2u);
+    EXPECT_EQ(packed.unknown_mask().size(), 1u);
+    EXPECT_EQ(packed.unknown_mask()[0], 0b110'0000'0000u);
+
+    std::string const expected{"ACGTACGTTNNACGTACGTACGTACGTACGTACGTTTTTGGGGG"};
+    EXPECT_TRUE(std::ranges::equal(packed, expected));
+    EXPECT_EQ(packed[10], 'N');
+}
+
+TEST(packed_dna_sequence_test, without_unknown_symbols)
+{
+    pa::packed_dna_sequence const packed{std::string{"GATTACA"}};
+
+    EXPECT_TRUE(packed.unknown_mask().empty());
+    EXPECT_TRUE(std::ranges::equal(packed, std::string{"GATTACA"}));
+    EXPECT_TRUE(std::ranges::empty(pa::packed_dna_sequence{std::string{}}));
+}
+
+TEST(packed_dna_sequence_test, simd_NxN)
+{
+    static constexpr std::array<std::pair<char, std::array<int16_t, 5>>, 5> dna_matrix
+    {{
+        {'A', { 2, -3, -3, -1, -3}},
+        {'C', {-3,  2, -3, -1, -3}},
+        {'G', {-3, -3,  2, -1, -3}},
+        {'N', {-1, -1, -1, -1, -1}},
+        {'T', {-3, -3, -3, -1,  2}},
+    }};
+
+    // Sequences spanning multiple words of the packed representation and N symbols.
+    std::vector<std::string> sequences1{"ACGTTGCANNACGTACGTAGCTAGCTAGCATCGATCGACTAGCTACG",
+                                        "GATTACA",
+                                        "C",
+                                        std::string(33, 'T') + "A"};
+    std::vector<std::string> sequences2{"ACGTTGCAACGTACGTAGCTAGCTAGCATCGATCGACTNGCTACG",
+                                        "GATACA",
+                                        "ACGT",
+                                        std::string(43, 'T') + "A"};
+
+    std::vector<pa::packed_dna_sequence> packed_sequences1(sequences1.begin(), sequences1.end());
+    std::vector<pa::packed_dna_sequence> packed_sequences2(sequences2.begin(), sequences2.end());
+
+    auto aligner = pa::cfg::configure_aligner(
+        pa::cfg::score_model_matrix_simd_NxN(pa::cfg::method_global(pa::cfg::gap_model_affine(-5, -2),
+                                                                    pa::cfg::leading_end_gap{},
+                                                                    pa::cfg::trailing_end_gap{}),
+                                             dna_matrix));
+
+    std::vector<int32_t> expected(sequences1.size());
+    std::vector<int32_t> scores(sequences1.size());
+    aligner.compute(sequences1, sequences2, expected.begin());
+    aligner.compute(packed_sequences1, packed_sequences2, scores.begin());
+
+    EXPECT_EQ(scores, expected);
+}
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_NxN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_NxN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+#include <pairwise_aligner/sequence/sequence_batch.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct sequence_batch_test : public ::testing::Test
+{
+    // Less pairs than simd lanes to test partially filled batches.
+    std::vector<std::string> sequences1{"ARNDCQEGHILKMFPSTWYV", "WWWWHHHH", "KMFPSTWYVARND", "A"};
+    std::vector<std::string> sequences2{"ARNDCQEGHILKMFPSTWYV", "WWHHW", "ARNDKMFPSTWY", "ARNDC"};
+
+    static constexpr auto method()
+    {
+        return pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                      pa::cfg::leading_end_gap{},
+                                      pa::cfg::trailing_end_gap{});
+    }
+
+    std::vector<int32_t> expected_scores(std::vector<std::string> const & first_sequences) const
+    {
+        auto aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix(method(),
+                                                                               pa::blosum62_standard<int32_t>));
+        std::vector<int32_t> scores{};
+        for (size_t i = 0; i < first_sequences.size(); ++i)
+            scores.push_back(aligner.compute(first_sequences[i], sequences2[i]).score());
+        return scores;
+    }
+
+    template <typename result_batch_t>
+    static std::vector<int32_t> scores_of(result_batch_t const & result_batch)
+    {
+        std::vector<int32_t> scores{};
+        for (auto result : result_batch)
+            scores.push_back(result.score());
+        return scores;
+    }
+};
+
+TEST_F(sequence_batch_test, sequence_sizes)
+{
+    auto aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix_simd_NxN(method(),
+                                                                                   pa::blosum62_standard<int16_t>));
+    auto batch = aligner.make_sequence_batch1(sequences1);
+
+    EXPECT_TRUE(std::ranges::random_access_range<decltype(batch)>);
+    ASSERT_EQ(batch.size(), sequences1.size());
+    for (size_t i = 0; i < sequences1.size(); ++i)
+        EXPECT_EQ(static_cast<size_t>(std::ranges::distance(batch[i])), sequences1[i].size());
+}
+
+TEST_F(sequence_batch_test, simd_NxN)
+{
+    auto aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix_simd_NxN(method(),
+                                                                                   pa::blosum62_standard<int16_t>));
+    auto batch1 = aligner.make_sequence_batch1(sequences1);
+    auto batch2 = aligner.make_sequence_batch2(sequences2);
+    std::vector<int32_t> const expected = expected_scores(sequences1);
+
+    EXPECT_EQ(scores_of(aligner.compute(batch1, batch2)), expected);
+    EXPECT_EQ(scores_of(aligner.compute(sequences1, batch2)), expected);
+
+    // The batches are not modified by compute and can be reused with the same workspace.
+    auto workspace = aligner.make_workspace();
+    for (size_t run = 0; run < 2; ++run)
+        EXPECT_EQ(scores_of(aligner.compute(batch1, batch2, workspace)), expected);
+}
+
+TEST_F(sequence_batch_test, simd_saturated_NxN)
+{
+    auto aligner = pa::cfg::configure_aligner(
+        pa::cfg::score_model_matrix_simd_saturated_NxN(method(), pa::blosum62_standard<int8_t>));
+    auto batch1 = aligner.make_sequence_batch1(sequences1);
+    auto batch2 = aligner.make_sequence_batch2(sequences2);
+
+    EXPECT_EQ(scores_of(aligner.compute(batch1, batch2)), expected_scores(sequences1));
+}
+
+TEST_F(sequence_batch_test, simd_1xN)
+{
+    std::vector<std::string> const queries(sequences2.size(), sequences1[0]);
+    auto aligner = pa::cfg::configure_aligner(
+        pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<int8_t>));
+    auto batch2 = aligner.make_sequence_batch2(sequences2);
+
+    EXPECT_EQ(scores_of(aligner.compute(sequences1[0], batch2)), expected_scores(queries));
+}
+
+TEST_F(sequence_batch_test, simd_1xN_profiled)
+{
+    auto aligner = pa::cfg::configure_aligner(
+        pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<int8_t>));
+    auto batch2 = aligner.make_sequence_batch2(sequences2);
+    auto profiled_batch2 = aligner.make_profiled_sequence_batch2(sequences2);
+    auto profiled_prepared_batch2 = aligner.make_profiled_sequence_batch2(batch2);
+
+    // The profile is built once and reused for every first sequence.
+    auto workspace = aligner.make_workspace();
+    for (std::string const & sequence1 : sequences1)
+    {
+        std::vector<std::string> const queries(sequences2.size(), sequence1);
+        std::vector<int32_t> const expected = expected_scores(queries);
+
+        EXPECT_EQ(scores_of(aligner.compute(sequence1, profiled_batch2, workspace)), expected);
+        EXPECT_EQ(scores_of(aligner.compute(sequence1, profiled_prepared_batch2, workspace)), expected);
+    }
+}
+
+TEST_F(sequence_batch_test, simd_saturated_1xN_profiled)
+{
+    auto aligner = pa::cfg::configure_aligner(
+        pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<int32_t>));
+    auto profiled_batch2 = aligner.make_profiled_sequence_batch2(sequences2);
+
+    auto workspace = aligner.make_workspace();
+    for (std::string const & sequence1 : sequences1)
+    {
+        std::vector<std::string> const queries(sequences2.size(), sequence1);
+        EXPECT_EQ(scores_of(aligner.compute(sequence1, profiled_batch2, workspace)), expected_scores(queries));
+    }
+}
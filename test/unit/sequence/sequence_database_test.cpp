@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pairwise_aligner/configuration/configure_aligner.hpp>
+#include <pairwise_aligner/configuration/gap_model_affine.hpp>
+#include <pairwise_aligner/configuration/method_global.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix.hpp>
+#include <pairwise_aligner/configuration/score_model_matrix_simd_saturated_1xN.hpp>
+#include <pairwise_aligner/score_model/substitution_matrix.hpp>
+#include <pairwise_aligner/sequence/sequence_database.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+struct sequence_database_test : public ::testing::Test
+{
+    std::string query{"ARNDCQEGHILKMFPSTWYV"};
+    std::vector<std::string> database{};
+    std::filesystem::path database_path{std::filesystem::temp_directory_path() / "sequence_database_test.padb"};
+
+    static constexpr auto method()
+    {
+        return pa::cfg::method_global(pa::cfg::gap_model_affine(-10, -1),
+                                      pa::cfg::leading_end_gap{},
+                                      pa::cfg::trailing_end_gap{});
+    }
+
+    static auto simd_aligner()
+    {
+        return pa::cfg::configure_aligner(
+            pa::cfg::score_model_matrix_simd_saturated_1xN(method(), pa::blosum62_standard<int8_t>));
+    }
+
+    void SetUp() override
+    {
+        // More sequences than fit into a single batch with decreasing and repeated sizes.
+        std::string const symbols{"WYVARNDCQEGHILKMFPST"};
+        for (size_t i = 0; i < 2 * simd_aligner().bulk_size() + 3; ++i)
+            database.push_back(symbols.substr(i % symbols.size()) + symbols.substr(0, i % 7));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(database_path);
+    }
+};
+
+TEST_F(sequence_database_test, compute)
+{
+    auto aligner = simd_aligner();
+    pa::write_sequence_database(database_path, aligner, database);
+    auto sequence_database = pa::open_sequence_database(database_path, aligner);
+
+    ASSERT_EQ(sequence_database.sequence_count(), database.size());
+    ASSERT_EQ(sequence_database.size(), 3u);
+    EXPECT_EQ(sequence_database.bulk_size(), aligner.bulk_size());
+
+    auto scalar_aligner = pa::cfg::configure_aligner(pa::cfg::score_model_matrix(method(),
+                                                                                  pa::blosum62_standard<int32_t>));
+    std::vector<bool> found(database.size(), false);
+    size_t previous_size = 0;
+    for (size_t batch_idx = 0; batch_idx < sequence_database.size(); ++batch_idx)
+    {
+        auto batch = sequence_database[batch_idx];
+        auto sequence_indices = sequence_database.sequence_indices(batch_idx);
+        ASSERT_EQ(sequence_indices.size(), batch.size());
+
+        auto result_batch = aligner.compute(query, batch);
+        for (auto result : result_batch)
+        {
+            size_t const sequence_idx = sequence_indices[result.index()];
+            std::string const & sequence = database[sequence_idx];
+
+            // The sequences are sorted by their size.
+            EXPECT_EQ(static_cast<size_t>(std::ranges::distance(result.sequence2())), sequence.size());
+            EXPECT_GE(sequence.size(), previous_size);
+            previous_size = sequence.size();
+
+            EXPECT_EQ(result.score(), scalar_aligner.compute(query, sequence).score());
+            found[sequence_idx] = true;
+        }
+    }
+    EXPECT_TRUE(std::ranges::all_of(found, std::identity{}));
+}
+
+TEST_F(sequence_database_test, invalid_file)
+{
+    auto aligner = simd_aligner();
+    EXPECT_THROW(pa::open_sequence_database(database_path, aligner), std::runtime_error);
+
+    {
+        std::ofstream database_stream{database_path};
+        database_stream << std::string(256, 'A');
+    }
+    EXPECT_THROW(pa::open_sequence_database(database_path, aligner), std::runtime_error);
+    EXPECT_THROW(pa::sequence_database<int32_t>{database_path}, std::runtime_error);
+}
@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/rrahn/pairwise_aligner/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+#include <pairwise_aligner/simd/simd_score_type.hpp>
+#include <pairwise_aligner/simd/simd_gather_map.hpp>
+
+namespace pa = seqan::pairwise_aligner;
+
+template <typename test_param_t>
+struct simd_gather_map_test : public testing::Test
+{
+    using scalar_value_t = std::tuple_element_t<0, test_param_t>;
+    using scalar_key_t = std::tuple_element_t<1, test_param_t>;
+
+    template <size_t dimension>
+    static auto make_data()
+    {
+        // Use a non-symmetric matrix to detect transposed accesses.
+        std::array<std::array<scalar_value_t, dimension>, dimension> data{};
+        for (size_t row = 0; row < dimension; ++row)
+            for (size_t column = 0; column < dimension; ++column)
+                data[row][column] = static_cast<scalar_value_t>(row * 3 + column);
+
+        return data;
+    }
+
+    template <typename map_t, typename data_t>
+    static void check_all(map_t const & map, data_t const & data)
+    {
+        using key_t = typename map_t::key_type;
+        constexpr size_t dimension = std::tuple_size_v<data_t>;
+
+        key_t row_key{};
+        key_t column_key{};
+        for (size_t cycle = 0; cycle < dimension; ++cycle) {
+            for (size_t i = 0; i < key_t::size_v; ++i) {
+                row_key[i] = (cycle + i) % dimension;
+                column_key[i] = (cycle * 7 + i * 13) % dimension;
+            }
+
+            auto values = map(row_key, column_key);
+            for (size_t i = 0; i < key_t::size_v; ++i)
+                EXPECT_EQ(values[i], data[row_key[i]][column_key[i]]) << "i = " << i << " cycle = " << cycle;
+        }
+    }
+};
+
+using test_types = ::testing::Types<
+    std::pair<int8_t, uint8_t>,
+    std::pair<int8_t, uint16_t>
+>;
+
+TYPED_TEST_SUITE(simd_gather_map_test, test_types);
+
+// ----------------------------------------------------------------------------
+// Test Cases
+// ----------------------------------------------------------------------------
+
+TYPED_TEST(simd_gather_map_test, dimension_5)
+{
+    auto data = TestFixture::template make_data<5>();
+    pa::simd_gather_map<typename TestFixture::scalar_value_t, typename TestFixture::scalar_key_t, 5> map{data};
+
+    TestFixture::check_all(map, data);
+}
+
+TYPED_TEST(simd_gather_map_test, dimension_64)
+{
+    auto data = TestFixture::template make_data<64>();
+    pa::simd_gather_map<typename TestFixture::scalar_value_t, typename TestFixture::scalar_key_t, 64> map{data};
+
+    TestFixture::check_all(map, data);
+}
+
+TYPED_TEST(simd_gather_map_test, dimension_256)
+{
+    auto data = TestFixture::template make_data<256>();
+    pa::simd_gather_map<typename TestFixture::scalar_value_t, typename TestFixture::scalar_key_t, 256> map{data};
+
+    TestFixture::check_all(map, data);
+}
+
+TYPED_TEST(simd_gather_map_test, shared_copy)
+{
+    auto data = TestFixture::template make_data<64>();
+    using map_t = pa::simd_gather_map<typename TestFixture::scalar_value_t, typename TestFixture::scalar_key_t, 64>;
+
+    map_t copy{};
+    {
+        map_t map{data};
+        copy = map;
+    }
+
+    TestFixture::check_all(copy, data);
+}